@@ -4,10 +4,12 @@
 namespace AstraSim {
 
 std::unordered_set<spdlog::sink_ptr> LoggerFactory::default_sinks;
+std::mutex LoggerFactory::loggers_mutex;
 
 std::shared_ptr<spdlog::logger> LoggerFactory::get_logger(
     const std::string& logger_name) {
     constexpr bool ENABLE_DEFAULT_SINK_FOR_OTHER_LOGGERS = true;
+    std::lock_guard<std::mutex> lock(loggers_mutex);
     auto logger = spdlog::get(logger_name);
     if (logger == nullptr) {
         logger = spdlog::create_async<spdlog::sinks::null_sink_mt>(logger_name);
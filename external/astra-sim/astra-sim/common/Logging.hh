@@ -5,6 +5,7 @@
 #include "spdlog/spdlog.h"
 #include "spdlog_setup/conf.h"
 #include <memory>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
@@ -23,6 +24,8 @@ class LoggerFactory {
   private:
     static void init_default_components(const std::string& log_path);
     static std::unordered_set<spdlog::sink_ptr> default_sinks;
+    // guards logger creation, as simulations may run on several threads
+    static std::mutex loggers_mutex;
 };
 
 }  // namespace AstraSim
@@ -0,0 +1,156 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include "astra-sim/common/SlabAllocator.hh"
+
+#include <mutex>
+#include <new>
+#include <vector>
+
+using namespace AstraSim;
+
+namespace {
+
+// blocks are rounded up to (and aligned to) this granularity
+constexpr std::size_t block_granularity = 16;
+
+// number of size classes: blocks up to 256 bytes are pooled
+constexpr std::size_t size_classes_count = 16;
+
+// size of a slab carved into blocks
+constexpr std::size_t slab_size = 64 * 1024;
+
+// number of blocks moved between a thread and the depot at once
+constexpr std::size_t batch_size = 256;
+
+struct FreeBlock {
+    FreeBlock* next;
+};
+
+struct FreeList {
+    FreeBlock* head = nullptr;
+    std::size_t count = 0;
+};
+
+// blocks shared by all threads: a thread freeing more blocks than it
+// allocates hands batches of them over, and the others refill from them
+// before carving a new slab
+struct Depot {
+    std::mutex mutex;
+    std::vector<FreeBlock*> batches[size_classes_count];
+    std::vector<void*> slabs;  // kept until the process exits
+};
+
+// per-thread free list of each size class
+thread_local FreeList free_lists[size_classes_count];
+
+Depot& depot() {
+    // never destroyed: blocks may be freed during static destruction
+    static auto* const depot = new Depot();
+    return *depot;
+}
+
+std::size_t size_class(const std::size_t size) {
+    return (size == 0) ? 0 : (size - 1) / block_granularity;
+}
+
+void refill(const std::size_t cls) {
+    auto& free_list = free_lists[cls];
+    auto& shared = depot();
+    char* slab = nullptr;
+    {
+        const std::lock_guard<std::mutex> lock(shared.mutex);
+
+        // take a batch from the depot if any
+        auto& batches = shared.batches[cls];
+        if (!batches.empty()) {
+            free_list.head = batches.back();
+            free_list.count = batch_size;
+            batches.pop_back();
+            return;
+        }
+
+        // otherwise, allocate a new slab
+        slab = static_cast<char*>(::operator new(slab_size));
+        shared.slabs.push_back(slab);
+    }
+
+    // carve the slab into blocks of this class
+    const auto block_size = (cls + 1) * block_granularity;
+    const auto blocks_count = slab_size / block_size;
+    for (auto i = blocks_count; i > 0; i--) {
+        auto* const block =
+            reinterpret_cast<FreeBlock*>(slab + (i - 1) * block_size);
+        block->next = free_list.head;
+        free_list.head = block;
+    }
+    free_list.count += blocks_count;
+}
+
+void release_batch(const std::size_t cls) {
+    auto& free_list = free_lists[cls];
+
+    // detach batch_size blocks behind the head, so the block freed last
+    // is reused first (and is still in cache)
+    auto* const head = free_list.head;
+    auto* const batch = head->next;
+    auto* last = batch;
+    for (std::size_t i = 1; i < batch_size; i++) {
+        last = last->next;
+    }
+    head->next = last->next;
+    free_list.count -= batch_size;
+    last->next = nullptr;
+
+    // hand them over to the depot
+    auto& shared = depot();
+    const std::lock_guard<std::mutex> lock(shared.mutex);
+    shared.batches[cls].push_back(batch);
+}
+
+}  // namespace
+
+void* SlabAllocator::allocate(const std::size_t size) {
+    const auto cls = size_class(size);
+    if (cls >= size_classes_count) {
+        return ::operator new(size);
+    }
+
+    auto& free_list = free_lists[cls];
+    if (free_list.head == nullptr) {
+        refill(cls);
+    }
+
+    // pop a free block
+    auto* const block = free_list.head;
+    free_list.head = block->next;
+    free_list.count--;
+    return block;
+}
+
+void SlabAllocator::deallocate(void* const ptr,
+                               const std::size_t size) noexcept {
+    if (ptr == nullptr) {
+        return;
+    }
+
+    const auto cls = size_class(size);
+    if (cls >= size_classes_count) {
+        ::operator delete(ptr);
+        return;
+    }
+
+    // push the block back into this thread's free list
+    auto& free_list = free_lists[cls];
+    auto* const block = static_cast<FreeBlock*>(ptr);
+    block->next = free_list.head;
+    free_list.head = block;
+    free_list.count++;
+
+    // keep the blocks freed by this thread available to the other threads
+    if (free_list.count >= 2 * batch_size) {
+        release_batch(cls);
+    }
+}
@@ -8,9 +8,10 @@ LICENSE file in the root directory of this source tree.
 
 using namespace AstraSimAnalytical;
 
-CallbackTracker::CallbackTracker() noexcept {
+CallbackTracker::CallbackTracker() noexcept : free_head(npos) {
     // initialize tracker
-    tracker = {};
+    nodes = {};
+    fifos = {};
 }
 
 std::optional<CallbackTrackerEntry*> CallbackTracker::search_entry(
@@ -25,17 +26,20 @@ std::optional<CallbackTrackerEntry*> CallbackTracker::search_entry(
     assert(chunk_size > 0);
     assert(chunk_id >= 0);
 
-    // create key and search entry
-    const auto key = std::make_tuple(tag, src, dest, chunk_size, chunk_id);
-    const auto entry = tracker.find(key);
+    // search the FIFO of the (src, dest) pair
+    const auto fifo = fifos.find(pair_key(src, dest));
+    if (fifo == fifos.end()) {
+        return std::nullopt;
+    }
+    const auto index = find_node(fifo->second, tag, chunk_size, chunk_id);
 
     // no entry exists
-    if (entry == tracker.end()) {
+    if (index == npos) {
         return std::nullopt;
     }
 
     // return pointer to entry
-    return &(entry->second);
+    return &(nodes[index].entry);
 }
 
 CallbackTrackerEntry* CallbackTracker::create_new_entry(
@@ -50,14 +54,35 @@ CallbackTrackerEntry* CallbackTracker::create_new_entry(
     assert(chunk_size > 0);
     assert(chunk_id >= 0);
 
-    // create key
-    const auto key = std::make_tuple(tag, src, dest, chunk_size, chunk_id);
+    // take a recycled node, or add one
+    auto index = free_head;
+    if (index != npos) {
+        free_head = nodes[index].next;
+    } else {
+        index = static_cast<Index>(nodes.size());
+        nodes.emplace_back();
+    }
 
-    // create new emtpy entry
-    const auto entry = tracker.emplace(key, CallbackTrackerEntry()).first;
+    // create new empty entry
+    auto& node = nodes[index];
+    node.tag = tag;
+    node.chunk_size = chunk_size;
+    node.chunk_id = chunk_id;
+    node.entry = CallbackTrackerEntry();
+
+    // append it to the FIFO of the (src, dest) pair
+    auto& fifo = fifos[pair_key(src, dest)];
+    node.prev = fifo.tail;
+    node.next = npos;
+    if (fifo.tail != npos) {
+        nodes[fifo.tail].next = index;
+    } else {
+        fifo.head = index;
+    }
+    fifo.tail = index;
 
     // return pointer to entry
-    return &(entry->second);
+    return &(node.entry);
 }
 
 void CallbackTracker::pop_entry(const int tag,
@@ -71,13 +96,47 @@ void CallbackTracker::pop_entry(const int tag,
     assert(chunk_size > 0);
     assert(chunk_id >= 0);
 
-    // create key
-    const auto key = std::make_tuple(tag, src, dest, chunk_size, chunk_id);
-
     // find entry
-    const auto entry = tracker.find(key);
-    assert(entry != tracker.end());  // entry must exist
+    const auto fifo_it = fifos.find(pair_key(src, dest));
+    assert(fifo_it != fifos.end());
+    auto& fifo = fifo_it->second;
+    const auto index = find_node(fifo, tag, chunk_size, chunk_id);
+    assert(index != npos);  // entry must exist
+
+    // unlink the node from the FIFO
+    const auto& node = nodes[index];
+    if (node.prev != npos) {
+        nodes[node.prev].next = node.next;
+    } else {
+        fifo.head = node.next;
+    }
+    if (node.next != npos) {
+        nodes[node.next].prev = node.prev;
+    } else {
+        fifo.tail = node.prev;
+    }
+
+    // recycle the node
+    nodes[index].next = free_head;
+    free_head = index;
+}
+
+CallbackTracker::Index CallbackTracker::find_node(
+    const Fifo& fifo,
+    const int tag,
+    const ChunkSize chunk_size,
+    const int chunk_id) const noexcept {
+    for (auto index = fifo.head; index != npos; index = nodes[index].next) {
+        const auto& node = nodes[index];
+        if (node.tag == tag && node.chunk_size == chunk_size &&
+            node.chunk_id == chunk_id) {
+            return index;
+        }
+    }
+
+    return npos;
+}
 
-    // erase entry from the tracker
-    tracker.erase(entry);
+uint64_t CallbackTracker::pair_key(const int src, const int dest) noexcept {
+    return (static_cast<uint64_t>(src) << 32) | static_cast<uint32_t>(dest);
 }
@@ -5,6 +5,7 @@ LICENSE file in the root directory of this source tree.
 
 #include "common/ChunkIdGenerator.hh"
 #include <cassert>
+#include <functional>
 
 using namespace AstraSimAnalytical;
 
@@ -63,3 +64,20 @@ int ChunkIdGenerator::create_recv_chunk_id(
     entry->second.increment_recv_id();
     return entry->second.get_recv_id();
 }
+
+std::size_t ChunkIdGenerator::KeyHash::operator()(
+    const Key& key) const noexcept {
+    const auto [tag, src, dest, chunk_size] = key;
+
+    // combine the hash of each field
+    auto hash = std::size_t{0};
+    const auto combine = [&hash](const uint64_t value) {
+        hash ^= std::hash<uint64_t>()(value) + 0x9e3779b97f4a7c15ULL +
+                (hash << 6) + (hash >> 2);
+    };
+    combine(static_cast<uint64_t>(tag));
+    combine(static_cast<uint64_t>(src));
+    combine(static_cast<uint64_t>(dest));
+    combine(static_cast<uint64_t>(chunk_size));
+    return hash;
+}
@@ -40,7 +40,24 @@ void CmdLineParser::define_options() noexcept {
         "injection-scale", "Injection scale",
         cxxopts::value<double>()->default_value("1"))(
         "rendezvous-protocol", "Whether to enable rendezvous protocol",
-        cxxopts::value<bool>()->default_value("false"));
+        cxxopts::value<bool>()->default_value("false"))(
+        "event-scheduler",
+        "Event queue scheduler (linear/heap/calendar)",
+        cxxopts::value<std::string>()->default_value("calendar"))(
+        "event-trace", "File to record the event schedule trace into",
+        cxxopts::value<std::string>()->default_value("empty"))(
+        "parallel-threads",
+        "Threads simulating the congestion-aware network in parallel "
+        "(0: sequential, -1: as in network configuration)",
+        cxxopts::value<int>()->default_value("-1"))(
+        "link-stats",
+        "File to dump the per-link telemetry of the congestion-aware network "
+        "into (CSV, or binary if ending with .bin)",
+        cxxopts::value<std::string>()->default_value("empty"))(
+        "link-stats-bucket",
+        "Width of the time buckets of the per-link utilization in ns "
+        "(0: disabled)",
+        cxxopts::value<uint64_t>()->default_value("0"));
 }
 
 void CmdLineParser::parse(int argc, char* argv[]) noexcept {
@@ -10,21 +10,26 @@ using namespace AstraSim;
 using namespace AstraSimAnalytical;
 using namespace NetworkAnalytical;
 
-std::shared_ptr<EventQueue> CommonNetworkApi::event_queue = nullptr;
+thread_local std::shared_ptr<EventQueue> CommonNetworkApi::event_queue =
+    nullptr;
 
-ChunkIdGenerator CommonNetworkApi::chunk_id_generator = {};
+thread_local ChunkIdGenerator CommonNetworkApi::chunk_id_generator = {};
 
-CallbackTracker CommonNetworkApi::callback_tracker = {};
+thread_local CallbackTracker CommonNetworkApi::callback_tracker = {};
 
-int CommonNetworkApi::dims_count = -1;
+thread_local int CommonNetworkApi::dims_count = -1;
 
-std::vector<Bandwidth> CommonNetworkApi::bandwidth_per_dim = {};
+thread_local std::vector<Bandwidth> CommonNetworkApi::bandwidth_per_dim = {};
 
 void CommonNetworkApi::set_event_queue(
     std::shared_ptr<EventQueue> event_queue_ptr) noexcept {
     assert(event_queue_ptr != nullptr);
 
     CommonNetworkApi::event_queue = std::move(event_queue_ptr);
+
+    // start from a clean state if a simulation already ran on this thread
+    CommonNetworkApi::chunk_id_generator = {};
+    CommonNetworkApi::callback_tracker = {};
 }
 
 CallbackTracker& CommonNetworkApi::get_callback_tracker() noexcept {
@@ -35,8 +40,7 @@ void CommonNetworkApi::process_chunk_arrival(void* args) noexcept {
     assert(args != nullptr);
 
     // parse chunk data
-    auto* const data =
-        static_cast<std::tuple<int, int, int, uint64_t, int>*>(args);
+    auto* const data = static_cast<ChunkArrivalArg*>(args);
     const auto [tag, src, dest, count, chunk_id] = *data;
     delete data;
 
@@ -4,15 +4,18 @@ LICENSE file in the root directory of this source tree.
 *******************************************************************************/
 
 #include "congestion_aware/CongestionAwareNetworkApi.hh"
+#include "congestion_aware/MulticastSendState.hh"
 #include <astra-network-analytical/congestion_aware/Chunk.h>
+#include <algorithm>
 #include <cassert>
+#include <iostream>
 
 using namespace AstraSim;
 using namespace AstraSimAnalyticalCongestionAware;
 using namespace NetworkAnalytical;
 using namespace NetworkAnalyticalCongestionAware;
 
-std::shared_ptr<Topology> CongestionAwareNetworkApi::topology;
+thread_local std::shared_ptr<Topology> CongestionAwareNetworkApi::topology;
 
 void CongestionAwareNetworkApi::set_topology(
     std::shared_ptr<Topology> topology_ptr) noexcept {
@@ -63,13 +66,12 @@ int CongestionAwareNetworkApi::sim_send(void* const buffer,
     }
 
     // create chunk
-    auto chunk_arrival_arg = std::tuple(tag, src, dst, count, chunk_id);
-    auto arg = std::make_unique<decltype(chunk_arrival_arg)>(chunk_arrival_arg);
-    const auto arg_ptr = static_cast<void*>(arg.release());
-    const auto route = topology->route(src, dst);
+    auto* const arg = new ChunkArrivalArg{tag, src, dst, count, chunk_id};
+    const auto arg_ptr = static_cast<void*>(arg);
+    auto route = topology->link_route(src, dst, arg->route_sequence());
     auto chunk = std::make_unique<Chunk>(
-        count, route, CongestionAwareNetworkApi::process_chunk_arrival,
-        arg_ptr);
+        count, src, std::move(route),
+        CongestionAwareNetworkApi::process_chunk_arrival, arg_ptr);
 
     // initiate transmission from src -> dst.
     topology->send(std::move(chunk));
@@ -77,3 +79,110 @@ int CongestionAwareNetworkApi::sim_send(void* const buffer,
     // return
     return 0;
 }
+
+int CongestionAwareNetworkApi::sim_send_multicast(
+    void* const buffer,
+    const uint64_t count,
+    const int type,
+    const std::vector<int>& dsts,
+    const int tag,
+    sim_request* const request,
+    void (*msg_handler)(void*),
+    void* const fun_arg) {
+    // destinations must be distinct NPUs other than this one
+    const auto src = sim_comm_get_rank();
+    if (!valid_multicast_dsts(src, dsts)) {
+        std::cerr << "[Error] (AstraSim/analytical/congestion_aware) "
+                  << "sim_send_multicast from NPU " << src
+                  << " requires distinct destination NPUs other than itself"
+                  << std::endl;
+        return -1;
+    }
+
+    // send handler is invoked after every destination received the chunk
+    auto* const send_state = new MulticastSendState{
+        static_cast<int>(dsts.size()), msg_handler, fun_arg};
+
+    // register one tracker entry per destination
+    auto callback_args = std::vector<CallbackArg>();
+    callback_args.reserve(dsts.size());
+    for (const auto dst : dsts) {
+        // query chunk id
+        const auto chunk_id =
+            CongestionAwareNetworkApi::chunk_id_generator.create_send_chunk_id(
+                tag, src, dst, count);
+
+        // search tracker
+        const auto entry =
+            callback_tracker.search_entry(tag, src, dst, count, chunk_id);
+        if (entry.has_value()) {
+            // recv operation already issued.
+            entry.value()->register_send_callback(process_multicast_send,
+                                                  send_state);
+        } else {
+            // recv operation not issued yet
+            auto* const new_entry = callback_tracker.create_new_entry(
+                tag, src, dst, count, chunk_id);
+            new_entry->register_send_callback(process_multicast_send,
+                                              send_state);
+        }
+
+        // chunk arrival argument of this destination
+        auto* const arg = new ChunkArrivalArg{tag, src, dst, count, chunk_id};
+        callback_args.push_back(static_cast<void*>(arg));
+    }
+
+    // create multicast chunk
+    const auto multicast_route = topology->multicast_route(src, dsts);
+    auto chunk = std::make_unique<Chunk>(
+        count, multicast_route, CongestionAwareNetworkApi::process_chunk_arrival,
+        std::move(callback_args));
+
+    // initiate transmission from src -> dsts.
+    topology->send(std::move(chunk));
+
+    // return
+    return 0;
+}
+
+bool CongestionAwareNetworkApi::valid_multicast_dsts(
+    const int src, const std::vector<int>& dsts) noexcept {
+    if (dsts.empty()) {
+        return false;
+    }
+
+    // every destination is a valid NPU other than src
+    const auto npus_count = topology->get_npus_count();
+    for (const auto dst : dsts) {
+        if (dst < 0 || dst >= npus_count || dst == src) {
+            return false;
+        }
+    }
+
+    // no destination appears twice
+    auto sorted_dsts = dsts;
+    std::sort(sorted_dsts.begin(), sorted_dsts.end());
+    return std::adjacent_find(sorted_dsts.begin(), sorted_dsts.end()) ==
+           sorted_dsts.end();
+}
+
+void CongestionAwareNetworkApi::process_multicast_send(
+    void* const args) noexcept {
+    assert(args != nullptr);
+
+    // parse multicast send state
+    auto* const send_state = static_cast<MulticastSendState*>(args);
+    assert(send_state->remaining_dsts > 0);
+
+    // wait for the remaining destinations
+    send_state->remaining_dsts--;
+    if (send_state->remaining_dsts > 0) {
+        return;
+    }
+
+    // every destination received the chunk: invoke send handler
+    const auto handler = send_state->msg_handler;
+    const auto handler_arg = send_state->fun_arg;
+    delete send_state;
+    (*handler)(handler_arg);
+}
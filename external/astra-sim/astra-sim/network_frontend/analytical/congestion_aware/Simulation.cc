@@ -0,0 +1,143 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include "congestion_aware/Simulation.hh"
+#include "congestion_aware/CongestionAwareNetworkApi.hh"
+#include <algorithm>
+#include <astra-network-analytical/common/EventQueue.h>
+#include <astra-network-analytical/congestion_aware/Helper.h>
+#include <astra-network-analytical/congestion_aware/Link.h>
+#include <astra-network-analytical/congestion_aware/LinkTelemetry.h>
+#include <astra-network-analytical/congestion_aware/ParallelSimulator.h>
+#include <astra-sim/system/Sys.hh>
+#include <chrono>
+#include <memory>
+#include <remote_memory_backend/analytical/AnalyticalRemoteMemory.hh>
+#include <vector>
+
+using namespace AstraSim;
+using namespace Analytical;
+using namespace AstraSimAnalytical;
+using namespace AstraSimAnalyticalCongestionAware;
+using namespace NetworkAnalytical;
+using namespace NetworkAnalyticalCongestionAware;
+
+SimulationResult AstraSimAnalyticalCongestionAware::run_simulation(
+    const SimulationConfig& config, const NetworkParser& network_parser) {
+    const auto start = std::chrono::steady_clock::now();
+
+    // start from a clean per-thread state, also after a simulation of this
+    // thread that did not tear down its systems
+    Sys::reset_simulation_state();
+
+    // Instantiate event queue
+    const auto event_queue = std::make_shared<EventQueue>(
+        EventQueue::parse_scheduler_type(config.event_scheduler));
+    if (config.event_trace != "empty") {
+        event_queue->record_trace(config.event_trace);
+    }
+    Topology::set_event_queue(event_queue);
+    Link::set_stats_bucket_width(config.link_stats_bucket);
+
+    // Generate topology
+    const auto topology = construct_topology(network_parser);
+
+    // Set up parallel simulation if requested
+    // (command line overrides the network configuration)
+    const auto parallel_threads = (config.parallel_threads >= 0)
+                                      ? config.parallel_threads
+                                      : network_parser.get_parallel_threads();
+    auto parallel_simulator = std::unique_ptr<ParallelSimulator>();
+    if (parallel_threads > 0) {
+        parallel_simulator = std::make_unique<ParallelSimulator>(
+            topology, event_queue, parallel_threads);
+    }
+
+    // Get topology information
+    const auto npus_count = topology->get_npus_count();
+    const auto npus_count_per_dim = topology->get_npus_count_per_dim();
+    const auto dims_count = topology->get_dims_count();
+
+    // Set up Network API
+    CongestionAwareNetworkApi::set_event_queue(event_queue);
+    CongestionAwareNetworkApi::set_topology(topology);
+
+    // Create ASTRA-sim related resources
+    auto network_apis =
+        std::vector<std::unique_ptr<CongestionAwareNetworkApi>>();
+    const auto memory_api = std::make_unique<AnalyticalRemoteMemory>(
+        config.remote_memory_configuration);
+    auto systems = std::vector<Sys*>();
+
+    auto queues_per_dim = std::vector<int>();
+    for (auto i = 0; i < dims_count; i++) {
+        queues_per_dim.push_back(config.num_queues_per_dim);
+    }
+
+    for (int i = 0; i < npus_count; i++) {
+        // create network and system
+        auto network_api = std::make_unique<CongestionAwareNetworkApi>(i);
+        auto* const system = new Sys(
+            i, config.workload_configuration, config.comm_group_configuration,
+            config.system_configuration, memory_api.get(), network_api.get(),
+            npus_count_per_dim, queues_per_dim, config.injection_scale,
+            config.comm_scale, config.rendezvous_protocol);
+
+        // push back network and system
+        network_apis.push_back(std::move(network_api));
+        systems.push_back(system);
+    }
+
+    // Initiate ASTRA-sim simulation
+    for (int i = 0; i < npus_count; i++) {
+        systems[i]->workload->fire();
+    }
+
+    // run simulation
+    if (parallel_simulator != nullptr) {
+        parallel_simulator->run();
+    } else {
+        while (!event_queue->finished()) {
+            event_queue->proceed();
+        }
+    }
+
+    // dump per-link telemetry
+    if (config.link_stats != "empty") {
+        const auto link_telemetry =
+            LinkTelemetry(*topology, event_queue->get_current_time());
+        link_telemetry.dump(config.link_stats);
+    }
+
+    // collect results
+    auto result = SimulationResult();
+    result.npus_count = npus_count;
+    result.finished = true;
+    result.finish_time = event_queue->get_current_time();
+    result.events_count = event_queue->get_invoked_events_count();
+    for (const auto* const system : systems) {
+        const auto* const workload = system->workload;
+        if (!workload->is_finished) {
+            // statistics are only post-processed once the workload finishes
+            result.finished = false;
+            continue;
+        }
+        result.max_wall_time =
+            std::max(result.max_wall_time, workload->stats->get_wall_time());
+        result.max_comm_time = std::max(
+            result.max_comm_time,
+            workload->stats->get_type_time(
+                Statistics::OperatorStatistics::OperatorType::COMM));
+    }
+
+    for (auto it : systems) {
+        delete it;
+    }
+    systems.clear();
+
+    const auto end = std::chrono::steady_clock::now();
+    result.host_seconds = std::chrono::duration<double>(end - start).count();
+    return result;
+}
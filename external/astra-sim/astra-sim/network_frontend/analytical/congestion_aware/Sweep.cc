@@ -0,0 +1,253 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include "congestion_aware/Sweep.hh"
+#include "astra-sim/common/Logging.hh"
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <json/json.hpp>
+#include <thread>
+
+using namespace AstraSim;
+using namespace AstraSimAnalyticalCongestionAware;
+using namespace NetworkAnalytical;
+using json = nlohmann::json;
+
+namespace {
+
+[[noreturn]] void manifest_error(const std::string& manifest_path,
+                                 const std::string& message) noexcept {
+    std::cerr << "[Error] (AstraSim/analytical/sweep) " << manifest_path
+              << ": " << message << std::endl;
+    std::exit(-1);
+}
+
+// apply the options of a manifest entry (named after the command line options)
+void apply_options(const std::string& manifest_path,
+                   const json& options,
+                   SimulationConfig& config) noexcept {
+    if (!options.is_object()) {
+        manifest_error(manifest_path, "runs and defaults must be objects");
+    }
+
+    try {
+        for (const auto& [key, value] : options.items()) {
+            if (key == "name") {
+                config.name = value.get<std::string>();
+            } else if (key == "workload-configuration") {
+                config.workload_configuration = value.get<std::string>();
+            } else if (key == "comm-group-configuration") {
+                config.comm_group_configuration = value.get<std::string>();
+            } else if (key == "system-configuration") {
+                config.system_configuration = value.get<std::string>();
+            } else if (key == "remote-memory-configuration") {
+                config.remote_memory_configuration = value.get<std::string>();
+            } else if (key == "network-configuration") {
+                config.network_configuration = value.get<std::string>();
+            } else if (key == "num-queues-per-dim") {
+                config.num_queues_per_dim = value.get<int>();
+            } else if (key == "comm-scale") {
+                config.comm_scale = value.get<double>();
+            } else if (key == "injection-scale") {
+                config.injection_scale = value.get<double>();
+            } else if (key == "rendezvous-protocol") {
+                config.rendezvous_protocol = value.get<bool>();
+            } else if (key == "event-scheduler") {
+                config.event_scheduler = value.get<std::string>();
+            } else if (key == "event-trace") {
+                config.event_trace = value.get<std::string>();
+            } else if (key == "parallel-threads") {
+                config.parallel_threads = value.get<int>();
+            } else if (key == "link-stats") {
+                config.link_stats = value.get<std::string>();
+            } else if (key == "link-stats-bucket") {
+                config.link_stats_bucket = value.get<uint64_t>();
+            } else {
+                manifest_error(manifest_path, "unknown option " + key);
+            }
+        }
+    } catch (const json::exception& e) {
+        manifest_error(manifest_path, e.what());
+    }
+}
+
+// quote a CSV field if needed
+std::string csv_field(const std::string& value) noexcept {
+    if (value.find_first_of(",\"\n") == std::string::npos) {
+        return value;
+    }
+
+    auto quoted = std::string("\"");
+    for (const auto c : value) {
+        if (c == '"') {
+            quoted += '"';
+        }
+        quoted += c;
+    }
+    quoted += '"';
+    return quoted;
+}
+
+}  // namespace
+
+Sweep::Sweep(const std::string& manifest_path) noexcept {
+    parse_manifest(manifest_path);
+    results.resize(configs.size());
+
+    // count the runs of each workload, to unmap its traces after the last one
+    for (const auto& config : configs) {
+        workload_pending_runs[config.workload_configuration]++;
+    }
+}
+
+void Sweep::parse_manifest(const std::string& manifest_path) noexcept {
+    auto manifest_file = std::ifstream(manifest_path);
+    if (!manifest_file) {
+        manifest_error(manifest_path, "unable to open the manifest");
+    }
+
+    auto manifest = json();
+    try {
+        manifest_file >> manifest;
+    } catch (const json::exception& e) {
+        manifest_error(manifest_path, e.what());
+    }
+    if (!manifest.is_object() || !manifest.contains("runs") ||
+        !manifest["runs"].is_array()) {
+        manifest_error(manifest_path, "the manifest must list its \"runs\"");
+    }
+
+    auto defaults = SimulationConfig();
+    if (manifest.contains("defaults")) {
+        apply_options(manifest_path, manifest["defaults"], defaults);
+    }
+
+    for (const auto& run : manifest["runs"]) {
+        auto config = defaults;
+        config.name = "run" + std::to_string(configs.size());
+        apply_options(manifest_path, run, config);
+
+        if (config.workload_configuration.empty() ||
+            config.system_configuration.empty() ||
+            config.remote_memory_configuration.empty() ||
+            config.network_configuration.empty()) {
+            manifest_error(manifest_path,
+                           "run " + config.name +
+                               " lacks a workload, system, remote memory, or "
+                               "network configuration");
+        }
+        configs.push_back(std::move(config));
+    }
+}
+
+void Sweep::run(int threads_count) noexcept {
+    if (threads_count <= 0) {
+        threads_count =
+            std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    }
+    threads_count = std::min(threads_count, static_cast<int>(configs.size()));
+
+    // every thread runs the next simulation not taken yet
+    auto next_index = std::atomic<size_t>(0);
+    const auto run_simulations = [this, &next_index]() {
+        for (auto index = next_index++; index < configs.size();
+             index = next_index++) {
+            run_simulation_at(index);
+        }
+    };
+
+    auto threads = std::vector<std::thread>();
+    for (auto i = 1; i < threads_count; i++) {
+        threads.emplace_back(run_simulations);
+    }
+    run_simulations();
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+}
+
+void Sweep::run_simulation_at(const size_t index) noexcept {
+    const auto& config = configs[index];
+    const auto network_parser = acquire_network(config.network_configuration);
+
+    auto npus_count = 1;
+    for (const auto npus_count_of_dim :
+         network_parser->get_npus_counts_per_dim()) {
+        npus_count *= npus_count_of_dim;
+    }
+    acquire_workload(config.workload_configuration, npus_count);
+
+    results[index] = run_simulation(config, *network_parser);
+
+    release_workload(config.workload_configuration);
+
+    const auto& result = results[index];
+    LoggerFactory::get_logger("sweep")->info(
+        "{} {} in {:.3f} s: finish time {}, max comm time {}", config.name,
+        result.finished ? "finished" : "did not finish", result.host_seconds,
+        result.finish_time, result.max_comm_time);
+}
+
+std::shared_ptr<const NetworkParser> Sweep::acquire_network(
+    const std::string& path) noexcept {
+    const auto lock = std::lock_guard<std::mutex>(shared_inputs_mutex);
+
+    auto& network_parser = network_parsers[path];
+    if (network_parser == nullptr) {
+        network_parser = std::make_shared<const NetworkParser>(path);
+    }
+    return network_parser;
+}
+
+void Sweep::acquire_workload(const std::string& prefix, const int npus_count) {
+    const auto lock = std::lock_guard<std::mutex>(shared_inputs_mutex);
+
+    auto& traces = workload_traces[prefix];
+    if (!traces.empty()) {
+        return;
+    }
+
+    // the systems of every run of this workload reopen the same mappings
+    for (auto i = 0; i < npus_count; i++) {
+        const auto trace_path = prefix + "." + std::to_string(i) + ".et";
+        traces.push_back(Chakra::FeederV3::MappedTrace::open(trace_path));
+    }
+}
+
+void Sweep::release_workload(const std::string& prefix) noexcept {
+    const auto lock = std::lock_guard<std::mutex>(shared_inputs_mutex);
+
+    if (--workload_pending_runs[prefix] == 0) {
+        workload_traces.erase(prefix);
+    }
+}
+
+void Sweep::dump(const std::string& path) const noexcept {
+    auto file = std::ofstream(path);
+    if (!file) {
+        std::cerr << "[Error] (AstraSim/analytical/sweep) "
+                  << "unable to open " << path << std::endl;
+        std::exit(-1);
+    }
+
+    file << "name,npus_count,finished,finish_time,max_wall_time,max_comm_time,"
+            "events_count,host_seconds,workload_configuration,"
+            "system_configuration,network_configuration\n";
+    for (auto i = size_t{0}; i < configs.size(); i++) {
+        const auto& config = configs[i];
+        const auto& result = results[i];
+        file << csv_field(config.name) << "," << result.npus_count << ","
+             << (result.finished ? 1 : 0) << "," << result.finish_time << ","
+             << result.max_wall_time << "," << result.max_comm_time << ","
+             << result.events_count << "," << result.host_seconds << ","
+             << csv_field(config.workload_configuration) << ","
+             << csv_field(config.system_configuration) << ","
+             << csv_field(config.network_configuration) << "\n";
+    }
+}
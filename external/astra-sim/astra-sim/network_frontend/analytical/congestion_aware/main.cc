@@ -5,105 +5,76 @@ LICENSE file in the root directory of this source tree.
 
 #include "astra-sim/common/Logging.hh"
 #include "common/CmdLineParser.hh"
-#include "congestion_aware/CongestionAwareNetworkApi.hh"
-#include <astra-network-analytical/common/EventQueue.h>
+#include "congestion_aware/Simulation.hh"
+#include "congestion_aware/Sweep.hh"
 #include <astra-network-analytical/common/NetworkParser.h>
-#include <astra-network-analytical/congestion_aware/Helper.h>
-#include <remote_memory_backend/analytical/AnalyticalRemoteMemory.hh>
 
 using namespace AstraSim;
-using namespace Analytical;
 using namespace AstraSimAnalytical;
 using namespace AstraSimAnalyticalCongestionAware;
 using namespace NetworkAnalytical;
-using namespace NetworkAnalyticalCongestionAware;
 
 int main(int argc, char* argv[]) {
     // Parse command line arguments
     auto cmd_line_parser = CmdLineParser(argv[0]);
+    cmd_line_parser.get_options().add_options()(
+        "sweep",
+        "Manifest of simulations to run concurrently in this process "
+        "(JSON, see congestion_aware/Sweep.hh)",
+        cxxopts::value<std::string>()->default_value("empty"))(
+        "sweep-output", "CSV file to write the sweep results into",
+        cxxopts::value<std::string>()->default_value("sweep.csv"))(
+        "sweep-threads",
+        "Number of simulations of the sweep running concurrently "
+        "(0: number of hardware threads)",
+        cxxopts::value<int>()->default_value("0"));
     cmd_line_parser.parse(argc, argv);
 
-    // Get command line arguments
-    const auto workload_configuration =
-        cmd_line_parser.get<std::string>("workload-configuration");
-    const auto comm_group_configuration =
-        cmd_line_parser.get<std::string>("comm-group-configuration");
-    const auto system_configuration =
-        cmd_line_parser.get<std::string>("system-configuration");
-    const auto remote_memory_configuration =
-        cmd_line_parser.get<std::string>("remote-memory-configuration");
-    const auto network_configuration =
-        cmd_line_parser.get<std::string>("network-configuration");
     const auto logging_configuration =
         cmd_line_parser.get<std::string>("logging-configuration");
     const auto logging_folder =
         cmd_line_parser.get<std::string>("logging-folder");
-    const auto num_queues_per_dim =
-        cmd_line_parser.get<int>("num-queues-per-dim");
-    const auto comm_scale = cmd_line_parser.get<double>("comm-scale");
-    const auto injection_scale = cmd_line_parser.get<double>("injection-scale");
-    const auto rendezvous_protocol =
-        cmd_line_parser.get<bool>("rendezvous-protocol");
-
     AstraSim::LoggerFactory::init(logging_configuration, logging_folder);
 
-    // Instantiate event queue
-    const auto event_queue = std::make_shared<EventQueue>();
-    Topology::set_event_queue(event_queue);
-
-    // Generate topology
-    const auto network_parser = NetworkParser(network_configuration);
-    const auto topology = construct_topology(network_parser);
-
-    // Get topology information
-    const auto npus_count = topology->get_npus_count();
-    const auto npus_count_per_dim = topology->get_npus_count_per_dim();
-    const auto dims_count = topology->get_dims_count();
-
-    // Set up Network API
-    CongestionAwareNetworkApi::set_event_queue(event_queue);
-    CongestionAwareNetworkApi::set_topology(topology);
+    // Run a sweep if requested
+    const auto sweep_manifest = cmd_line_parser.get<std::string>("sweep");
+    if (sweep_manifest != "empty") {
+        auto sweep = Sweep(sweep_manifest);
+        sweep.run(cmd_line_parser.get<int>("sweep-threads"));
+        sweep.dump(cmd_line_parser.get<std::string>("sweep-output"));
 
-    // Create ASTRA-sim related resources
-    auto network_apis =
-        std::vector<std::unique_ptr<CongestionAwareNetworkApi>>();
-    const auto memory_api =
-        std::make_unique<AnalyticalRemoteMemory>(remote_memory_configuration);
-    auto systems = std::vector<Sys*>();
-
-    auto queues_per_dim = std::vector<int>();
-    for (auto i = 0; i < dims_count; i++) {
-        queues_per_dim.push_back(num_queues_per_dim);
+        AstraSim::LoggerFactory::shutdown();
+        return 0;
     }
 
-    for (int i = 0; i < npus_count; i++) {
-        // create network and system
-        auto network_api = std::make_unique<CongestionAwareNetworkApi>(i);
-        auto* const system =
-            new Sys(i, workload_configuration, comm_group_configuration,
-                    system_configuration, memory_api.get(), network_api.get(),
-                    npus_count_per_dim, queues_per_dim, injection_scale,
-                    comm_scale, rendezvous_protocol);
-
-        // push back network and system
-        network_apis.push_back(std::move(network_api));
-        systems.push_back(system);
-    }
-
-    // Initiate ASTRA-sim simulation
-    for (int i = 0; i < npus_count; i++) {
-        systems[i]->workload->fire();
-    }
-
-    // run simulation
-    while (!event_queue->finished()) {
-        event_queue->proceed();
-    }
-
-    for (auto it : systems) {
-        delete it;
-    }
-    systems.clear();
+    // Get command line arguments
+    auto config = SimulationConfig();
+    config.workload_configuration =
+        cmd_line_parser.get<std::string>("workload-configuration");
+    config.comm_group_configuration =
+        cmd_line_parser.get<std::string>("comm-group-configuration");
+    config.system_configuration =
+        cmd_line_parser.get<std::string>("system-configuration");
+    config.remote_memory_configuration =
+        cmd_line_parser.get<std::string>("remote-memory-configuration");
+    config.network_configuration =
+        cmd_line_parser.get<std::string>("network-configuration");
+    config.num_queues_per_dim = cmd_line_parser.get<int>("num-queues-per-dim");
+    config.comm_scale = cmd_line_parser.get<double>("comm-scale");
+    config.injection_scale = cmd_line_parser.get<double>("injection-scale");
+    config.rendezvous_protocol =
+        cmd_line_parser.get<bool>("rendezvous-protocol");
+    config.event_scheduler =
+        cmd_line_parser.get<std::string>("event-scheduler");
+    config.event_trace = cmd_line_parser.get<std::string>("event-trace");
+    config.parallel_threads = cmd_line_parser.get<int>("parallel-threads");
+    config.link_stats = cmd_line_parser.get<std::string>("link-stats");
+    config.link_stats_bucket =
+        cmd_line_parser.get<uint64_t>("link-stats-bucket");
+
+    // Run simulation
+    const auto network_parser = NetworkParser(config.network_configuration);
+    run_simulation(config, network_parser);
 
     // terminate simulation
     AstraSim::LoggerFactory::shutdown();
@@ -11,7 +11,7 @@ using namespace AstraSimAnalyticalCongestionUnaware;
 using namespace NetworkAnalytical;
 using namespace NetworkAnalyticalCongestionUnaware;
 
-std::shared_ptr<Topology> CongestionUnawareNetworkApi::topology;
+thread_local std::shared_ptr<Topology> CongestionUnawareNetworkApi::topology;
 
 void CongestionUnawareNetworkApi::set_topology(
     std::shared_ptr<Topology> topology_ptr) noexcept {
@@ -63,9 +63,8 @@ int CongestionUnawareNetworkApi::sim_send(void* const buffer,
     }
 
     // create chunk
-    auto chunk_arrival_arg = std::tuple(tag, src, dst, count, chunk_id);
-    auto arg = std::make_unique<decltype(chunk_arrival_arg)>(chunk_arrival_arg);
-    const auto arg_ptr = static_cast<void*>(arg.release());
+    auto* const arg = new ChunkArrivalArg{tag, src, dst, count, chunk_id};
+    const auto arg_ptr = static_cast<void*>(arg);
 
     // compute send communication delay (in AstraSim format)
     const auto send_delay_ns = topology->send(src, dst, count);
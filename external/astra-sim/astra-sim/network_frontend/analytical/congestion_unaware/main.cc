@@ -44,11 +44,18 @@ int main(int argc, char* argv[]) {
     const auto injection_scale = cmd_line_parser.get<double>("injection-scale");
     const auto rendezvous_protocol =
         cmd_line_parser.get<bool>("rendezvous-protocol");
+    const auto event_scheduler =
+        cmd_line_parser.get<std::string>("event-scheduler");
+    const auto event_trace = cmd_line_parser.get<std::string>("event-trace");
 
     AstraSim::LoggerFactory::init(logging_configuration, logging_folder);
 
     // Instantiate event queue
-    const auto event_queue = std::make_shared<EventQueue>();
+    const auto event_queue = std::make_shared<EventQueue>(
+        EventQueue::parse_scheduler_type(event_scheduler));
+    if (event_trace != "empty") {
+        event_queue->record_trace(event_trace);
+    }
 
     // Generate topology
     const auto network_parser = NetworkParser(network_configuration);
@@ -0,0 +1,73 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include "flow/FlowNetworkApi.hh"
+#include <cassert>
+
+using namespace AstraSim;
+using namespace AstraSimAnalyticalFlow;
+using namespace NetworkAnalytical;
+using namespace NetworkAnalyticalFlow;
+
+thread_local std::shared_ptr<FlowNetwork> FlowNetworkApi::flow_network;
+
+void FlowNetworkApi::set_flow_network(
+    std::shared_ptr<FlowNetwork> flow_network_ptr) noexcept {
+    assert(flow_network_ptr != nullptr);
+
+    // move flow network
+    FlowNetworkApi::flow_network = std::move(flow_network_ptr);
+
+    // set topology-related values
+    const auto& topology = FlowNetworkApi::flow_network->get_topology();
+    FlowNetworkApi::dims_count = topology->get_dims_count();
+    FlowNetworkApi::bandwidth_per_dim = topology->get_bandwidth_per_dim();
+}
+
+FlowNetworkApi::FlowNetworkApi(const int rank) noexcept
+    : CommonNetworkApi(rank) {
+    assert(rank >= 0);
+}
+
+int FlowNetworkApi::sim_send(void* const buffer,
+                             const uint64_t count,
+                             const int type,
+                             const int dst,
+                             const int tag,
+                             sim_request* const request,
+                             void (*msg_handler)(void*),
+                             void* const fun_arg) {
+    // query chunk id
+    const auto src = sim_comm_get_rank();
+    const auto chunk_id =
+        FlowNetworkApi::chunk_id_generator.create_send_chunk_id(tag, src, dst,
+                                                                count);
+
+    // search tracker
+    const auto entry =
+        callback_tracker.search_entry(tag, src, dst, count, chunk_id);
+    if (entry.has_value()) {
+        // recv operation already issued.
+        // register send callback
+        entry.value()->register_send_callback(msg_handler, fun_arg);
+    } else {
+        // recv operation not issued yet
+        // create new entry and insert callback
+        auto* const new_entry =
+            callback_tracker.create_new_entry(tag, src, dst, count, chunk_id);
+        new_entry->register_send_callback(msg_handler, fun_arg);
+    }
+
+    // arrival of the flow completes the message
+    auto* const arg = new ChunkArrivalArg{tag, src, dst, count, chunk_id};
+    const auto arg_ptr = static_cast<void*>(arg);
+
+    // initiate transmission from src -> dst.
+    flow_network->send(src, dst, count, FlowNetworkApi::process_chunk_arrival,
+                       arg_ptr, arg->route_sequence());
+
+    // return
+    return 0;
+}
@@ -7,18 +7,27 @@ LICENSE file in the root directory of this source tree.
 
 #include "common/CallbackTrackerEntry.hh"
 #include "common/ChunkIdGenerator.hh"
-#include <map>
+#include <cstdint>
+#include <deque>
+#include <unordered_map>
 
 namespace AstraSimAnalytical {
 
 /**
  * CallbackTracker keeps track of sim_send() and sim_recv() callbacks of each
  * chunk identified by (tag, src, dest, chunk_size, chunk_id) tuple.
+ *
+ * Entries are kept in a FIFO per (src, dest) pair, found through a hash map.
+ * Sends and receives of a pair are mostly matched in order,
+ * so the matching entry is usually found at the head of its FIFO.
+ * Entries are recycled, and keep their address while they are tracked
+ * (callbacks invoked on an entry may create new entries).
  */
 class CallbackTracker {
   public:
-    /// Key = (tag, src, dest, chunk_size, chunk_id)
-    using Key = std::tuple<int, int, int, ChunkSize, int>;
+    /**
+     * Constructor.
+     */
     CallbackTracker() noexcept;
 
     /**
@@ -72,9 +81,74 @@ class CallbackTracker {
                    int chunk_id) noexcept;
 
   private:
-    /// map from (tag, src, dest, chunk_size, chunk_id) tuple to
-    /// CallbackTrackerEntry
-    std::map<Key, CallbackTrackerEntry> tracker;
+    /// index of a node in the node pool
+    using Index = uint32_t;
+
+    /// sentinel index representing "no node"
+    static constexpr Index npos = UINT32_MAX;
+
+    /// tracked entry, chained into the FIFO of its (src, dest) pair
+    struct Node {
+        /// tag of the chunk
+        int tag;
+
+        /// size of the chunk
+        ChunkSize chunk_size;
+
+        /// id of the chunk
+        int chunk_id;
+
+        /// callbacks of the chunk
+        CallbackTrackerEntry entry;
+
+        /// previous node in the FIFO
+        Index prev;
+
+        /// next node in the FIFO (or next free node)
+        Index next;
+    };
+
+    /// FIFO of the entries of a (src, dest) pair
+    struct Fifo {
+        /// oldest node
+        Index head = npos;
+
+        /// newest node
+        Index tail = npos;
+    };
+
+    /// node pool (a deque never moves its elements when growing)
+    std::deque<Node> nodes;
+
+    /// head of the recycled node list
+    Index free_head;
+
+    /// FIFO of each (src, dest) pair
+    std::unordered_map<uint64_t, Fifo> fifos;
+
+    /**
+     * Find the node of the entry identified by
+     * (tag, src, dest, chunk_size, chunk_id) tuple.
+     *
+     * @param fifo FIFO of the (src, dest) pair
+     * @param tag tag of the chunk
+     * @param chunk_size size of the chunk
+     * @param chunk_id id of the chunk
+     * @return index of the node, npos if not found
+     */
+    [[nodiscard]] Index find_node(const Fifo& fifo,
+                                  int tag,
+                                  ChunkSize chunk_size,
+                                  int chunk_id) const noexcept;
+
+    /**
+     * Compute the key of a (src, dest) pair.
+     *
+     * @param src src NPU ID
+     * @param dest dest NPU ID
+     * @return key of the pair
+     */
+    [[nodiscard]] static uint64_t pair_key(int src, int dest) noexcept;
 };
 
 }  // namespace AstraSimAnalytical
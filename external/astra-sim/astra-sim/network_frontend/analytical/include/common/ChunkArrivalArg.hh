@@ -0,0 +1,57 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#pragma once
+
+#include <astra-network-analytical/common/Type.h>
+#include <astra-sim/common/SlabAllocator.hh>
+#include <cstddef>
+#include <cstdint>
+
+using namespace NetworkAnalytical;
+
+namespace AstraSimAnalytical {
+
+/**
+ * ChunkArrivalArg identifies the chunk whose arrival is processed
+ * by CommonNetworkApi::process_chunk_arrival().
+ * One is created per chunk, so they are recycled by the slab allocator.
+ */
+struct ChunkArrivalArg {
+    /// tag of the sim_send() call
+    int tag;
+
+    /// src NPU ID of the chunk
+    int src;
+
+    /// dest NPU ID of the chunk
+    int dest;
+
+    /// size of the chunk
+    ChunkSize chunk_size;
+
+    /// id of the chunk
+    int chunk_id;
+
+    /**
+     * Identify the chunk among the chunks from src to dest,
+     * so routing policies choosing among several routes pick the same one in every run.
+     *
+     * @return route sequence of the chunk
+     */
+    [[nodiscard]] uint64_t route_sequence() const noexcept {
+        return (static_cast<uint64_t>(static_cast<uint32_t>(tag)) << 32) | static_cast<uint32_t>(chunk_id);
+    }
+
+    static void* operator new(std::size_t size) {
+        return AstraSim::SlabAllocator::allocate(size);
+    }
+
+    static void operator delete(void* ptr, std::size_t size) noexcept {
+        AstraSim::SlabAllocator::deallocate(ptr, size);
+    }
+};
+
+}  // namespace AstraSimAnalytical
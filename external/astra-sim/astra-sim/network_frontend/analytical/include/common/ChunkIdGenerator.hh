@@ -7,8 +7,9 @@ LICENSE file in the root directory of this source tree.
 
 #include "common/ChunkIdGeneratorEntry.hh"
 #include <astra-network-analytical/common/Type.h>
-#include <map>
+#include <cstddef>
 #include <tuple>
+#include <unordered_map>
 
 using namespace NetworkAnalytical;
 
@@ -57,8 +58,13 @@ class ChunkIdGenerator {
                                            ChunkSize chunk_size) noexcept;
 
   private:
+    /// hash of (tag, src, dest, chunk_size) tuple
+    struct KeyHash {
+        [[nodiscard]] std::size_t operator()(const Key& key) const noexcept;
+    };
+
     /// map from (tag, src, dest, chunk_size) tuple to ChunkIdGeneratorEntry
-    std::map<Key, ChunkIdGeneratorEntry> chunk_id_map;
+    std::unordered_map<Key, ChunkIdGeneratorEntry, KeyHash> chunk_id_map;
 };
 
 }  // namespace AstraSimAnalytical
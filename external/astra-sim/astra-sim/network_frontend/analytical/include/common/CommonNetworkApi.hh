@@ -6,6 +6,7 @@ LICENSE file in the root directory of this source tree.
 #pragma once
 
 #include "common/CallbackTracker.hh"
+#include "common/ChunkArrivalArg.hh"
 #include "common/ChunkIdGenerator.hh"
 #include <astra-network-analytical/common/EventQueue.h>
 #include <astra-sim/common/AstraNetworkAPI.hh>
@@ -21,12 +22,18 @@ namespace AstraSimAnalytical {
 
 /**
  * CommonNetworkApi implements common AstraNetworkAPI interface
- * that both congestion_unaware and congestion_aware network API inherit.
+ * that the congestion_unaware, congestion_aware, and flow network APIs inherit.
+ *
+ * The state shared by the network APIs of a simulation (event queue, callback
+ * tracker, topology, ...) is kept per thread, so that independent simulations
+ * can run concurrently on different threads.
  */
 class CommonNetworkApi : public AstraNetworkAPI {
   public:
     /**
-     * Set the event queue to be used.
+     * Set the event queue to be used by the simulation on the calling thread.
+     * This starts a new simulation: the chunk ids and pending callbacks of the
+     * previous simulation on the thread are discarded.
      *
      * @param event_queue_ptr pointer to the event queue
      */
@@ -85,19 +92,19 @@ class CommonNetworkApi : public AstraNetworkAPI {
 
   protected:
     /// event queue
-    static std::shared_ptr<EventQueue> event_queue;
+    static thread_local std::shared_ptr<EventQueue> event_queue;
 
     /// chunk id generator
-    static ChunkIdGenerator chunk_id_generator;
+    static thread_local ChunkIdGenerator chunk_id_generator;
 
     /// callback tracker
-    static CallbackTracker callback_tracker;
+    static thread_local CallbackTracker callback_tracker;
 
     /// bandwidth per each network dimension of the topology
-    static std::vector<Bandwidth> bandwidth_per_dim;
+    static thread_local std::vector<Bandwidth> bandwidth_per_dim;
 
     /// number of network dimensions of the topology
-    static int dims_count;
+    static thread_local int dims_count;
 };
 
 }  // namespace AstraSimAnalytical
@@ -43,9 +43,53 @@ class CongestionAwareNetworkApi final : public CommonNetworkApi {
                  void (*msg_handler)(void* fun_arg),
                  void* fun_arg) override;
 
+    /**
+     * Send a message to multiple destinations at once.
+     * The chunk is replicated inside the network along the multicast route,
+     * so links shared by several destinations carry it only once.
+     *
+     * Each destination completes its own sim_recv,
+     * and msg_handler is invoked once after every destination received it.
+     *
+     * This is not part of AstraNetworkAPI: the system layer (collectives) does not call it,
+     * and sends to several peers are issued as separate sim_send calls.
+     * It serves network frontends and tools driving this API directly.
+     *
+     * @param dsts distinct destination ranks, excluding this rank
+     * (other parameters follow sim_send)
+     * @return 0 on success, -1 if dsts is empty, repeats a rank, or contains
+     * this rank or an invalid one (nothing is sent)
+     */
+    int sim_send_multicast(void* buffer,
+                           uint64_t count,
+                           int type,
+                           const std::vector<int>& dsts,
+                           int tag,
+                           sim_request* request,
+                           void (*msg_handler)(void* fun_arg),
+                           void* fun_arg);
+
   private:
     /// topology
-    static std::shared_ptr<Topology> topology;
+    static thread_local std::shared_ptr<Topology> topology;
+
+    /**
+     * Check the destinations of a multicast.
+     *
+     * @param src rank of the sender
+     * @param dsts destination ranks
+     * @return true if dsts is a non-empty set of valid ranks other than src
+     */
+    [[nodiscard]] static bool valid_multicast_dsts(
+        int src, const std::vector<int>& dsts) noexcept;
+
+    /**
+     * Send callback registered per destination of a multicast,
+     * invoking the multicast send handler after the last destination.
+     *
+     * @param args MulticastSendState of the multicast
+     */
+    static void process_multicast_send(void* args) noexcept;
 };
 
 }  // namespace AstraSimAnalyticalCongestionAware
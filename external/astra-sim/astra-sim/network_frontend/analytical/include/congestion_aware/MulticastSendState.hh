@@ -0,0 +1,37 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#pragma once
+
+#include <astra-sim/common/SlabAllocator.hh>
+#include <cstddef>
+
+namespace AstraSimAnalyticalCongestionAware {
+
+/**
+ * MulticastSendState tracks the destinations of a sim_send_multicast() call
+ * that have not received the message yet.
+ * One is created per multicast, so they are recycled by the slab allocator.
+ */
+struct MulticastSendState {
+    /// number of destinations yet to receive the message
+    int remaining_dsts;
+
+    /// send handler of the sim_send_multicast() call
+    void (*msg_handler)(void*);
+
+    /// argument of the send handler
+    void* fun_arg;
+
+    static void* operator new(std::size_t size) {
+        return AstraSim::SlabAllocator::allocate(size);
+    }
+
+    static void operator delete(void* ptr, std::size_t size) noexcept {
+        AstraSim::SlabAllocator::deallocate(ptr, size);
+    }
+};
+
+}  // namespace AstraSimAnalyticalCongestionAware
@@ -0,0 +1,111 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#pragma once
+
+#include <astra-network-analytical/common/NetworkParser.h>
+#include <astra-network-analytical/common/Type.h>
+#include <astra-sim/common/Common.hh>
+#include <cstdint>
+#include <string>
+
+using namespace AstraSim;
+using namespace NetworkAnalytical;
+
+namespace AstraSimAnalyticalCongestionAware {
+
+/**
+ * Inputs of one congestion-aware ASTRA-sim simulation,
+ * named after the command line options.
+ */
+struct SimulationConfig {
+    /// name of the simulation in the sweep results
+    std::string name;
+
+    /// workload configuration (execution trace prefix)
+    std::string workload_configuration;
+
+    /// communicator group configuration file
+    std::string comm_group_configuration = "empty";
+
+    /// system configuration file
+    std::string system_configuration;
+
+    /// remote memory configuration file
+    std::string remote_memory_configuration;
+
+    /// network configuration file
+    std::string network_configuration;
+
+    /// number of queues per network dimension
+    int num_queues_per_dim = 1;
+
+    /// communication scale
+    double comm_scale = 1;
+
+    /// injection scale
+    double injection_scale = 1;
+
+    /// whether to enable rendezvous protocol
+    bool rendezvous_protocol = false;
+
+    /// event queue scheduler
+    std::string event_scheduler = "calendar";
+
+    /// file to record the event schedule trace into
+    std::string event_trace = "empty";
+
+    /// parallel simulation threads (-1: as in the network configuration)
+    int parallel_threads = -1;
+
+    /// file to dump the per-link telemetry into
+    std::string link_stats = "empty";
+
+    /// width of the per-link utilization time buckets (0: disabled)
+    uint64_t link_stats_bucket = 0;
+};
+
+/**
+ * Outcome of one simulation.
+ */
+struct SimulationResult {
+    /// number of NPUs
+    int npus_count = 0;
+
+    /// whether the workload of every NPU finished
+    bool finished = false;
+
+    /// simulated time when the event queue drained
+    EventTime finish_time = 0;
+
+    /// maximum wall time over NPUs
+    Tick max_wall_time = 0;
+
+    /// maximum communication time over NPUs
+    Tick max_comm_time = 0;
+
+    /// number of invoked events
+    uint64_t events_count = 0;
+
+    /// host time spent simulating, in seconds
+    double host_seconds = 0;
+};
+
+/**
+ * Run a congestion-aware simulation to completion on the calling thread.
+ *
+ * The simulation state of ASTRA-sim and of the network (the event queue of the
+ * links and network APIs, the systems, ...) is kept per thread,
+ * so independent simulations can run concurrently on different threads,
+ * and one after another on the same thread.
+ *
+ * @param config inputs of the simulation
+ * @param network_parser parsed network configuration of the simulation
+ * @return outcome of the simulation
+ */
+SimulationResult run_simulation(
+    const SimulationConfig& config, const NetworkParser& network_parser);
+
+}  // namespace AstraSimAnalyticalCongestionAware
@@ -0,0 +1,126 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#pragma once
+
+#include "congestion_aware/Simulation.hh"
+#include <astra-network-analytical/common/NetworkParser.h>
+#include <extern/graph_frontend/chakra/src/feeder_v3/mapped_trace.h>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+using namespace NetworkAnalytical;
+
+namespace AstraSimAnalyticalCongestionAware {
+
+/**
+ * Sweep runs the independent simulations listed in a manifest
+ * concurrently on a pool of threads, within a single process.
+ *
+ * The manifest is a JSON file:
+ * {
+ *   "defaults": { "system-configuration": "sys.json", ... },
+ *   "runs": [
+ *     { "name": "WaferSpMM", "workload-configuration": "SpGEMM_WaferSpMM",
+ *       "network-configuration": "Mesh2D_64npus.yml" },
+ *     ...
+ *   ]
+ * }
+ * Each run takes the command line options (by name) of
+ * AstraSim_Analytical_Congestion_Aware, and falls back to "defaults".
+ *
+ * Runs sharing a network configuration share its parsed form,
+ * and runs sharing a workload share its mapped execution traces
+ * (kept mapped until the last run using them finishes).
+ * The results are written into a CSV table, one row per run in manifest order.
+ */
+class Sweep {
+  public:
+    /**
+     * Constructor.
+     *
+     * @param manifest_path path of the manifest
+     */
+    explicit Sweep(const std::string& manifest_path) noexcept;
+
+    /**
+     * Run every simulation of the manifest.
+     *
+     * @param threads_count number of simulations running concurrently
+     * (0: number of hardware threads)
+     */
+    void run(int threads_count) noexcept;
+
+    /**
+     * Write the results into a CSV file.
+     *
+     * @param path path of the CSV file
+     */
+    void dump(const std::string& path) const noexcept;
+
+  private:
+    /// simulations to run
+    std::vector<SimulationConfig> configs;
+
+    /// results of each simulation
+    std::vector<SimulationResult> results;
+
+    /// guards the shared inputs below
+    std::mutex shared_inputs_mutex;
+
+    /// parsed network configurations, by path
+    std::map<std::string, std::shared_ptr<const NetworkParser>> network_parsers;
+
+    /// mapped execution traces of the workloads in use, by prefix
+    std::map<std::string,
+             std::vector<std::shared_ptr<const Chakra::FeederV3::MappedTrace>>>
+        workload_traces;
+
+    /// number of runs yet to finish, by workload prefix
+    std::map<std::string, int> workload_pending_runs;
+
+    /**
+     * Parse the manifest.
+     *
+     * @param manifest_path path of the manifest
+     */
+    void parse_manifest(const std::string& manifest_path) noexcept;
+
+    /**
+     * Run the simulation at the given index of the manifest.
+     *
+     * @param index index of the simulation
+     */
+    void run_simulation_at(size_t index) noexcept;
+
+    /**
+     * Get the parsed network configuration, parsing it on first use.
+     *
+     * @param path path of the network configuration
+     * @return parsed network configuration
+     */
+    std::shared_ptr<const NetworkParser> acquire_network(
+        const std::string& path) noexcept;
+
+    /**
+     * Map the execution traces of a workload, unless already mapped.
+     *
+     * @param prefix workload configuration (execution trace prefix)
+     * @param npus_count number of NPUs
+     */
+    void acquire_workload(const std::string& prefix, int npus_count);
+
+    /**
+     * Unmap the execution traces of a workload after its last run.
+     *
+     * @param prefix workload configuration (execution trace prefix)
+     */
+    void release_workload(const std::string& prefix) noexcept;
+};
+
+}  // namespace AstraSimAnalyticalCongestionAware
@@ -51,7 +51,7 @@ class CongestionUnawareNetworkApi final : public CommonNetworkApi {
 
   private:
     /// topology
-    static std::shared_ptr<Topology> topology;
+    static thread_local std::shared_ptr<Topology> topology;
 };
 
 }  // namespace AstraSimAnalyticalCongestionUnaware
@@ -0,0 +1,56 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#pragma once
+
+#include "common/CommonNetworkApi.hh"
+#include <astra-network-analytical/flow/FlowNetwork.h>
+
+using namespace AstraSim;
+using namespace AstraSimAnalytical;
+using namespace NetworkAnalytical;
+using namespace NetworkAnalyticalFlow;
+
+namespace AstraSimAnalyticalFlow {
+
+/**
+ * FlowNetworkApi sends each message as a single flow,
+ * sharing the link bandwidths with the other messages in flight.
+ */
+class FlowNetworkApi final : public CommonNetworkApi {
+  public:
+    /**
+     * Set the flow network to be used.
+     *
+     * @param flow_network_ptr pointer to the flow network
+     */
+    static void set_flow_network(
+        std::shared_ptr<FlowNetwork> flow_network_ptr) noexcept;
+
+    /**
+     * Constructor.
+     *
+     * @param rank id of the API
+     */
+    explicit FlowNetworkApi(int rank) noexcept;
+
+    /**
+     * Implement sim_send of AstraNetworkAPI.
+     */
+    int sim_send(void* buffer,
+                 uint64_t count,
+                 int type,
+                 int dst,
+                 int tag,
+                 sim_request* request,
+                 void (*msg_handler)(void* fun_arg),
+                 void* fun_arg) override;
+
+  private:
+    /// flow network
+    static thread_local std::shared_ptr<FlowNetwork> flow_network;
+};
+
+}  // namespace AstraSimAnalyticalFlow
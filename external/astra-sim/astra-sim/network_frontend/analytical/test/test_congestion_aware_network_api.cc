@@ -0,0 +1,161 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include "congestion_aware/CongestionAwareNetworkApi.hh"
+#include "congestion_aware/MulticastSendState.hh"
+#include <astra-network-analytical/common/EventQueue.h>
+#include <astra-network-analytical/congestion_aware/Mesh2D.h>
+#include <gtest/gtest.h>
+#include <memory>
+#include <vector>
+
+using namespace AstraSimAnalytical;
+using namespace AstraSimAnalyticalCongestionAware;
+using namespace NetworkAnalytical;
+using namespace NetworkAnalyticalCongestionAware;
+
+class TestCongestionAwareNetworkApi : public ::testing::Test {
+  protected:
+    void SetUp() override {
+        // set event queue
+        event_queue = std::make_shared<EventQueue>();
+        Topology::set_event_queue(event_queue);
+        CongestionAwareNetworkApi::set_event_queue(event_queue);
+
+        // 3x3 mesh, one network API per NPU
+        topology = std::make_shared<Mesh2D>(9, 50, 500, 3, 3);
+        CongestionAwareNetworkApi::set_topology(topology);
+        for (auto rank = 0; rank < topology->get_npus_count(); rank++) {
+            network_apis.push_back(std::make_unique<CongestionAwareNetworkApi>(rank));
+        }
+
+        // set chunk size
+        chunk_size = 1'048'576;  // 1 MB
+    }
+
+    void run_simulation() const {
+        while (!event_queue->finished()) {
+            event_queue->proceed();
+        }
+    }
+
+    /// completion of a sim_send or sim_recv call
+    struct Completion {
+        EventQueue* event_queue;
+        int count;
+        EventTime time;
+    };
+
+    static void record_completion(void* const arg) {
+        auto* const completion = static_cast<Completion*>(arg);
+        completion->count++;
+        completion->time = completion->event_queue->get_current_time();
+    }
+
+    std::shared_ptr<EventQueue> event_queue;
+    std::shared_ptr<Topology> topology;
+    std::vector<std::unique_ptr<CongestionAwareNetworkApi>> network_apis;
+    ChunkSize chunk_size;
+    sim_request request;
+};
+
+TEST_F(TestCongestionAwareNetworkApi, MulticastCompletesEveryRecv) {
+    /// multicast from NPU 0 to NPUs 1 (1 hop), 4 (2 hops), and 8 (4 hops)
+    const auto tag = 3;
+    const auto dsts = std::vector<int>{1, 4, 8};
+    auto send_completion = Completion{event_queue.get(), 0, 0};
+    auto recv_completions = std::vector<Completion>(dsts.size(), Completion{event_queue.get(), 0, 0});
+
+    /// recv posted before the multicast
+    network_apis[1]->sim_recv(nullptr, chunk_size, 0, 0, tag, &request, record_completion, &recv_completions[0]);
+
+    /// the send state is recycled by the slab allocator:
+    /// the multicast reuses the block freed last, and frees it once every destination received the chunk
+    auto* const probe = new MulticastSendState{0, nullptr, nullptr};
+    delete probe;
+    struct SendHandler {
+        Completion* completion;
+        const std::vector<Completion>* recv_completions;
+        const void* send_state;
+        bool send_state_recycled;
+        int recvs_completed;
+    };
+    auto send_handler = SendHandler{&send_completion, &recv_completions, probe, false, 0};
+    const auto record_send = [](void* const arg) {
+        auto* const handler = static_cast<SendHandler*>(arg);
+        record_completion(handler->completion);
+
+        // the send state is already released
+        auto* const next_state = new MulticastSendState{0, nullptr, nullptr};
+        handler->send_state_recycled = (next_state == handler->send_state);
+        delete next_state;
+
+        for (const auto& recv_completion : *handler->recv_completions) {
+            handler->recvs_completed += recv_completion.count;
+        }
+    };
+    EXPECT_EQ(network_apis[0]->sim_send_multicast(nullptr, chunk_size, 0, dsts, tag, &request, record_send,
+                                                  &send_handler),
+              0);
+
+    /// test: one tracker entry per destination, identified by the first chunk id of each (src, dst) pair
+    auto& callback_tracker = CommonNetworkApi::get_callback_tracker();
+    for (const auto dst : dsts) {
+        EXPECT_TRUE(callback_tracker.search_entry(tag, 0, dst, chunk_size, 0).has_value());
+    }
+
+    /// recv posted after the multicast, before it arrives
+    network_apis[4]->sim_recv(nullptr, chunk_size, 0, 0, tag, &request, record_completion, &recv_completions[1]);
+    run_simulation();
+
+    /// test: the send handler runs once, after the last destination, when both posted recvs completed
+    EXPECT_EQ(send_completion.count, 1);
+    EXPECT_TRUE(send_handler.send_state_recycled);
+    EXPECT_EQ(send_handler.recvs_completed, 2);
+    EXPECT_EQ(recv_completions[0].count, 1);
+    EXPECT_EQ(recv_completions[1].count, 1);
+    EXPECT_LT(recv_completions[0].time, recv_completions[1].time);
+    EXPECT_LT(recv_completions[1].time, send_completion.time);
+
+    /// recv posted after the multicast arrived: completes immediately
+    EXPECT_EQ(recv_completions[2].count, 0);
+    network_apis[8]->sim_recv(nullptr, chunk_size, 0, 0, tag, &request, record_completion, &recv_completions[2]);
+    run_simulation();
+
+    /// test: every recv completes once, and no tracker entry is left
+    for (const auto& recv_completion : recv_completions) {
+        EXPECT_EQ(recv_completion.count, 1);
+    }
+    EXPECT_EQ(recv_completions[2].time, send_completion.time);
+    EXPECT_EQ(send_completion.count, 1);
+    for (const auto dst : dsts) {
+        EXPECT_FALSE(callback_tracker.search_entry(tag, 0, dst, chunk_size, 0).has_value());
+    }
+}
+
+TEST_F(TestCongestionAwareNetworkApi, MulticastRejectsInvalidDsts) {
+    auto send_completion = Completion{event_queue.get(), 0, 0};
+
+    /// test: empty, repeated, own, or out-of-range destinations send nothing
+    const auto invalid_dsts = std::vector<std::vector<int>>{{}, {1, 4, 1}, {1, 0, 4}, {1, 9}, {-1, 4}};
+    for (const auto& dsts : invalid_dsts) {
+        EXPECT_EQ(network_apis[0]->sim_send_multicast(nullptr, chunk_size, 0, dsts, 0, &request, record_completion,
+                                                      &send_completion),
+                  -1);
+    }
+    EXPECT_TRUE(event_queue->finished());
+    EXPECT_FALSE(CommonNetworkApi::get_callback_tracker().search_entry(0, 0, 1, chunk_size, 0).has_value());
+    EXPECT_FALSE(CommonNetworkApi::get_callback_tracker().search_entry(0, 0, 4, chunk_size, 0).has_value());
+
+    /// test: a valid multicast afterwards uses the first chunk ids
+    auto recv_completion = Completion{event_queue.get(), 0, 0};
+    network_apis[1]->sim_recv(nullptr, chunk_size, 0, 0, 0, &request, record_completion, &recv_completion);
+    EXPECT_EQ(network_apis[0]->sim_send_multicast(nullptr, chunk_size, 0, std::vector<int>{1}, 0, &request,
+                                                  record_completion, &send_completion),
+              0);
+    run_simulation();
+    EXPECT_EQ(recv_completion.count, 1);
+    EXPECT_EQ(send_completion.count, 1);
+}
@@ -9,9 +9,10 @@ LICENSE file in the root directory of this source tree.
 
 using namespace AstraSim;
 
-std::map<int, int> BaseStream::synchronizer;
-std::map<int, int> BaseStream::ready_counter;
-std::map<int, std::list<BaseStream*>> BaseStream::suspended_streams;
+thread_local std::map<int, int> BaseStream::synchronizer;
+thread_local std::map<int, int> BaseStream::ready_counter;
+thread_local std::map<int, std::list<BaseStream*>>
+    BaseStream::suspended_streams;
 
 void BaseStream::changeState(StreamState state) {
     this->state = state;
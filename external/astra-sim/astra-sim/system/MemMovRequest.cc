@@ -10,7 +10,7 @@ LICENSE file in the root directory of this source tree.
 
 using namespace AstraSim;
 
-int MemMovRequest::id = 0;
+thread_local int MemMovRequest::id = 0;
 MemMovRequest::MemMovRequest(int request_num,
                              Sys* sys,
                              LogGP* loggp,
@@ -30,7 +30,7 @@ class MemMovRequest : public Callable, public SharedBusStat {
     }
     void call(EventType event, CallData* data);
 
-    static int id;
+    static thread_local int id;
     int my_id;
     int size;
     int latency;
@@ -6,6 +6,7 @@ LICENSE file in the root directory of this source tree.
 #ifndef __RECV_PACKET_EVENT_HANDLER_DATA_HH__
 #define __RECV_PACKET_EVENT_HANDLER_DATA_HH__
 
+#include "astra-sim/common/SlabAllocator.hh"
 #include "astra-sim/system/BaseStream.hh"
 #include "astra-sim/system/BasicEventHandlerData.hh"
 #include "astra-sim/system/astraccl/custom_collectives/CustomAlgorithm.hh"
@@ -23,6 +24,14 @@ class RecvPacketEventHandlerData : public BasicEventHandlerData {
                                int vnet,
                                int stream_id);
 
+    // one is created per packet: recycle them in the slab allocator
+    static void* operator new(std::size_t size) {
+        return SlabAllocator::allocate(size);
+    }
+    static void operator delete(void* ptr, std::size_t size) noexcept {
+        SlabAllocator::deallocate(ptr, size);
+    }
+
     Workload* workload;
     WorkloadLayerHandlerData* wlhd;
     BaseStream* owner;
@@ -6,6 +6,7 @@ LICENSE file in the root directory of this source tree.
 #ifndef __SEND_PACKET_EVENT_HANDLER_DATA_HH__
 #define __SEND_PACKET_EVENT_HANDLER_DATA_HH__
 
+#include "astra-sim/common/SlabAllocator.hh"
 #include "astra-sim/system/BasicEventHandlerData.hh"
 #include "astra-sim/system/Callable.hh"
 #include "astra-sim/system/Common.hh"
@@ -20,6 +21,14 @@ class SendPacketEventHandlerData : public BasicEventHandlerData {
     WorkloadLayerHandlerData* wlhd;
     SendPacketEventHandlerData();
     SendPacketEventHandlerData(Callable* callable, int tag);
+
+    // one is created per packet: recycle them in the slab allocator
+    static void* operator new(std::size_t size) {
+        return SlabAllocator::allocate(size);
+    }
+    static void operator delete(void* ptr, std::size_t size) noexcept {
+        SlabAllocator::deallocate(ptr, size);
+    }
 };
 
 }  // namespace AstraSim
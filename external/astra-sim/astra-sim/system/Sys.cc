@@ -14,6 +14,7 @@ LICENSE file in the root directory of this source tree.
 #include "astra-sim/system/DataSet.hh"
 #include "astra-sim/system/MemBus.hh"
 #include "astra-sim/system/MemEventHandlerData.hh"
+#include "astra-sim/system/MemMovRequest.hh"
 #include "astra-sim/system/QueueLevels.hh"
 #include "astra-sim/system/RendezvousRecvData.hh"
 #include "astra-sim/system/RendezvousSendData.hh"
@@ -39,7 +40,7 @@ using json = nlohmann::json;
 
 namespace AstraSim {
 uint8_t* Sys::dummy_data = new uint8_t[2];
-vector<Sys*> Sys::all_sys;
+thread_local vector<Sys*> Sys::all_sys;
 
 // SchedulerUnit --------------------------------------------------------------
 Sys::SchedulerUnit::SchedulerUnit(Sys* sys,
@@ -189,6 +190,8 @@ Sys::Sys(int id,
     this->active_chunks_per_dimension = 1;
     this->priority_counter = 0;
     this->pending_events = 0;
+    this->active_event_buckets = 0;
+    this->call_events_data = BasicEventHandlerData(id, EventType::CallEvents);
     this->preferred_dataset_splits = 0;
 
     this->last_scheduled_collective = 0;
@@ -305,6 +308,8 @@ Sys::~Sys() {
     }
 
     if (shouldExit) {
+        // last system of the simulation
+        reset_simulation_state();
         exit_sim_loop("Exiting");
     }
 }
@@ -456,23 +461,54 @@ void Sys::exit_sim_loop(string msg) {
     logger->warn(msg);
 }
 
+void Sys::reset_simulation_state() {
+    all_sys.clear();
+    BaseStream::synchronizer.clear();
+    BaseStream::ready_counter.clear();
+    BaseStream::suspended_streams.clear();
+    OfflineGreedy::chunk_schedule.clear();
+    OfflineGreedy::schedule_consumer.clear();
+    OfflineGreedy::global_chunk_size.clear();
+    DataSet::id_auto_increment = 0;
+    MemMovRequest::id = 0;
+}
+
 void Sys::call(EventType type, CallData* data) {}
 
 void Sys::call_events() {
-    for (auto& callable : event_queue[Sys::boostedTick()]) {
+    const auto bucket = find_event_bucket(Sys::boostedTick());
+    if (bucket == active_event_buckets) {
+        return;
+    }
+
+    // events registered for this tick while calling are appended to the
+    // bucket (which may reallocate), and called by the same loop
+    for (size_t i = 0; i < event_buckets[bucket].events.size(); i++) {
+        const auto [callable, event, callData] =
+            event_buckets[bucket].events[i];
         try {
             pending_events--;
-            (get<0>(callable))->call(get<1>(callable), get<2>(callable));
+            callable->call(event, callData);
         } catch (const std::exception& e) {
             auto logger = LoggerFactory::get_logger("system");
             logger->critical("warning! a callable is removed before call {}",
                              e.what());
         }
     }
-    if (event_queue[Sys::boostedTick()].size() > 0) {
-        event_queue[Sys::boostedTick()].clear();
+
+    // release the bucket, keeping its storage for later ticks
+    event_buckets[bucket].events.clear();
+    std::swap(event_buckets[bucket], event_buckets[active_event_buckets - 1]);
+    active_event_buckets--;
+}
+
+size_t Sys::find_event_bucket(Tick tick) const {
+    for (size_t i = 0; i < active_event_buckets; i++) {
+        if (event_buckets[i].tick == tick) {
+            return i;
+        }
     }
-    event_queue.erase(Sys::boostedTick());
+    return active_event_buckets;
 }
 
 void Sys::register_event(Callable* callable,
@@ -488,20 +524,22 @@ void Sys::try_register_event(Callable* callable,
                              Tick& delta_cycles) {
     bool should_schedule = false;
     auto event_time = Sys::boostedTick() + delta_cycles;
-    if (event_queue.find(event_time) == event_queue.end()) {
-        list<tuple<Callable*, EventType, CallData*>> tmp;
-        event_queue[event_time] = tmp;
+    auto bucket = find_event_bucket(event_time);
+    if (bucket == active_event_buckets) {
+        // take a spare bucket, or add one
+        if (active_event_buckets == event_buckets.size()) {
+            event_buckets.emplace_back();
+        }
+        event_buckets[bucket].tick = event_time;
+        active_event_buckets++;
         should_schedule = true;
     }
-    event_queue[event_time].push_back(make_tuple(callable, event, callData));
+    event_buckets[bucket].events.emplace_back(callable, event, callData);
     if (should_schedule) {
         timespec_t tmp;
         tmp.time_res = NS;
         tmp.time_val = delta_cycles;
-        BasicEventHandlerData* data =
-            new BasicEventHandlerData(id, EventType::CallEvents);
-        data->sys_id = id;
-        comm_NI->sim_schedule(tmp, &Sys::handleEvent, data);
+        comm_NI->sim_schedule(tmp, &Sys::handleEvent, &call_events_data);
     }
     delta_cycles = 0;
     pending_events++;
@@ -517,8 +555,8 @@ void Sys::handleEvent(void* arg) {
     EventType event = ehd->event;
 
     if (event == EventType::CallEvents) {
+        // ehd is the call_events_data of the system: nothing to release
         all_sys[id]->call_events();
-        delete ehd;
     } else if ((event == EventType::NPU_to_MA) ||
                (event == EventType::MA_to_NPU)) {
         all_sys[id]->call_events();
@@ -10,6 +10,7 @@ LICENSE file in the root directory of this source tree.
 
 #include "astra-sim/common/AstraNetworkAPI.hh"
 #include "astra-sim/common/AstraRemoteMemoryAPI.hh"
+#include "astra-sim/system/BasicEventHandlerData.hh"
 #include "astra-sim/system/Callable.hh"
 #include "astra-sim/system/CollectivePhase.hh"
 #include "astra-sim/system/CommunicatorGroup.hh"
@@ -91,6 +92,9 @@ class Sys : public Callable {
     // Simulation Loop
     // ----------------------------------------------------------
     void exit_sim_loop(std::string msg);
+    // reset the per-thread state shared by the Sys objects of a simulation,
+    // so that another simulation can run on this thread
+    static void reset_simulation_state();
     //---------------------------------------------------------------------------
 
     // General Event Handling
@@ -106,6 +110,7 @@ class Sys : public Callable {
                             CallData* callData,
                             Tick& delta_cycles);
     static void handleEvent(void* arg);
+    size_t find_event_bucket(Tick tick) const;
     //---------------------------------------------------------------------------
 
     // Communicator Group Support
@@ -250,7 +255,10 @@ class Sys : public Callable {
                  void* fun_arg);
     //---------------------------------------------------------------------------
 
-    static std::vector<Sys*> all_sys;  // vector of all Sys objects
+    // Sys objects of the simulation running on this thread
+    // (per-simulation state is kept per thread, so that independent
+    // simulations can run concurrently on different threads)
+    static thread_local std::vector<Sys*> all_sys;
 
     int id;
     bool initialized;
@@ -308,8 +316,16 @@ class Sys : public Callable {
     std::map<int, std::list<BaseStream*>> active_Streams;
     std::map<int, std::list<int>> stream_priorities;
 
-    std::map<Tick, std::list<std::tuple<Callable*, EventType, CallData*>>>
-        event_queue;
+    // events pending at each tick, in flat buckets reused across ticks
+    // (buckets [0, active_event_buckets) are in use, the rest are spare)
+    struct EventBucket {
+        Tick tick;
+        std::vector<std::tuple<Callable*, EventType, CallData*>> events;
+    };
+    std::vector<EventBucket> event_buckets;
+    size_t active_event_buckets;
+    // handler data of every CallEvents event scheduled by this system
+    BasicEventHandlerData call_events_data;
     int total_nodes;
     int dim_to_break;
     std::vector<int> logical_broken_dims;
@@ -7,6 +7,7 @@ LICENSE file in the root directory of this source tree.
 #define __WORKLOAD_LAYER_HANDLER_DATA_HH__
 
 #include "astra-sim/common/AstraNetworkAPI.hh"
+#include "astra-sim/common/SlabAllocator.hh"
 #include "astra-sim/system/BasicEventHandlerData.hh"
 
 namespace AstraSim {
@@ -19,6 +20,14 @@ class WorkloadLayerHandlerData : public BasicEventHandlerData, public MetaData {
     Workload* workload;
     uint64_t node_id;
     WorkloadLayerHandlerData();
+
+    // one is created per operator: recycle them in the slab allocator
+    static void* operator new(std::size_t size) {
+        return SlabAllocator::allocate(size);
+    }
+    static void operator delete(void* ptr, std::size_t size) noexcept {
+        SlabAllocator::deallocate(ptr, size);
+    }
 };
 
 }  // namespace AstraSim
@@ -40,9 +40,10 @@ class OfflineGreedy {
     uint64_t get_chunk_size_from_elapsed_time(double elapsed_time,
                                               DimElapsedTime dim,
                                               ComType comm_type);
-    static std::map<long long, std::vector<int>> chunk_schedule;
-    static std::map<long long, int> schedule_consumer;
-    static std::map<long long, uint64_t> global_chunk_size;
+    // per simulation (i.e., per thread), reset by Sys
+    static thread_local std::map<long long, std::vector<int>> chunk_schedule;
+    static thread_local std::map<long long, int> schedule_consumer;
+    static thread_local std::map<long long, uint64_t> global_chunk_size;
 };
 
 }  // namespace AstraSim
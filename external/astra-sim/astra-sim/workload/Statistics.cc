@@ -215,6 +215,15 @@ void Statistics::report(std::shared_ptr<spdlog::logger> logger) const {
     }
 }
 
+Tick Statistics::get_wall_time() const {
+    return this->wall_time;
+}
+
+Tick Statistics::get_type_time(OperatorStatistics::OperatorType type) const {
+    const auto it = this->type_time.find(type);
+    return (it == this->type_time.end()) ? 0 : it->second;
+}
+
 void Statistics::report() const {
     report(LoggerFactory::get_logger("statistics"));
 }
@@ -90,6 +90,11 @@ class Statistics {
 
     void report() const;
 
+    // results, available after post_processing()
+    Tick get_wall_time() const;
+
+    Tick get_type_time(OperatorStatistics::OperatorType type) const;
+
   private:
     void extract_type_time();
     Tick _calculateTotalRuntimeFromIntervals(
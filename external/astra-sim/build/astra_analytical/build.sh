@@ -122,7 +122,8 @@ done
 # check the validity of build target
 if [[ ${build_target:?} != "all" &&
   ${build_target:?} != "congestion_unaware" &&
-  ${build_target:?} != "congestion_aware" ]]; then
+  ${build_target:?} != "congestion_aware" &&
+  ${build_target:?} != "flow" ]]; then
   echo "Invalid build target: ${build_target:?}" >&2
   exit 1
 fi
@@ -0,0 +1,44 @@
+#!/bin/bash
+set -e
+
+## ******************************************************************************
+## This source code is licensed under the MIT license found in the
+## LICENSE file in the root directory of this source tree.
+##
+## Copyright (c) 2024 Georgia Institute of Technology
+## ******************************************************************************
+
+# find the absolute path to this script
+SCRIPT_DIR=$(dirname "$(realpath "$0")")
+PROJECT_DIR="${SCRIPT_DIR:?}/../../../.."
+EXAMPLE_DIR="${PROJECT_DIR:?}/examples"
+
+# paths
+ASTRA_SIM="${PROJECT_DIR:?}/build/astra_analytical/build/bin/AstraSim_Analytical_Flow"
+WORKLOAD="${EXAMPLE_DIR:?}/workload/microbenchmarks/all_reduce/8npus_1MB/all_reduce"
+SYSTEM="${EXAMPLE_DIR:?}/system/native_collectives/HGX-H100-validated.json"
+NETWORK="${EXAMPLE_DIR:?}/network/analytical/HGX-H100-validated.yml"
+REMOTE_MEMORY="${EXAMPLE_DIR:?}/remote_memory/analytical/no_memory_expansion.json"
+
+# start
+echo "[ASTRA-sim] Compiling ASTRA-sim with the Analytical Network Backend (flow-level)..."
+echo ""
+
+# Compile
+"${PROJECT_DIR:?}"/build/astra_analytical/build.sh -t flow
+
+echo ""
+echo "[ASTRA-sim] Compilation finished."
+echo "[ASTRA-sim] Running ASTRA-sim Example with Analytical Network Backend (flow-level)..."
+echo ""
+
+# run ASTRA-sim
+"${ASTRA_SIM:?}" \
+    --workload-configuration="${WORKLOAD}" \
+    --system-configuration="${SYSTEM:?}" \
+    --remote-memory-configuration="${REMOTE_MEMORY:?}" \
+    --network-configuration="${NETWORK:?}"
+
+# finalize
+echo ""
+echo "[ASTRA-sim] Finished the execution."
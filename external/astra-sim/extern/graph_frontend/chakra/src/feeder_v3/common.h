@@ -6,6 +6,8 @@
 namespace Chakra {
 namespace FeederV3 {
 using NodeId = uint64_t;
+// position of a node within its trace, in ascending order of node ids
+using NodePos = uint32_t;
 using ETFeederId = uint64_t;
 using ChakraNode = ChakraProtoMsg::Node;
 using ChakraGlobalMetadata = ChakraProtoMsg::GlobalMetadata;
@@ -24,6 +26,10 @@ constexpr static bool RESOLVE_CTRL_DEPS = true;
 
 constexpr static size_t DEFAULT_PROTOBUF_BUFFER_SIZE = 16384;
 
+// node index sidecar (<trace>.idx) of memory-mapped traces
+constexpr static uint64_t ETFEEDER_INDEX_VERSION = 1;
+constexpr static bool DEFAULT_ETFEEDER_WRITE_INDEX = true;
+
 } // namespace FeederV3
 } // namespace Chakra
 
@@ -7,30 +7,14 @@
 
 using namespace Chakra::FeederV3;
 
-void _DependancyLayer::add_node(
-    const NodeId& node,
-    const std::unordered_set<NodeId>& parents) {
+void _DependancyLayer::attach(
+    std::shared_ptr<const MappedTrace> trace,
+    const DependancyGraph& graph) {
   std::unique_lock<std::shared_mutex> lock(this->mutex);
   this->dirty = true;
-  this->_helper_allocate_bucket(node);
-  for (auto& parent : parents) {
-    this->_helper_allocate_bucket(parent);
-    this->child_map_parent[node].insert(parent);
-    this->parent_map_child[parent].insert(node);
-  }
-}
-
-void _DependancyLayer::add_node_children(
-    const NodeId& node,
-    const std::unordered_set<NodeId>& children) {
-  std::unique_lock<std::shared_mutex> lock(this->mutex);
-  this->dirty = true;
-  this->_helper_allocate_bucket(node);
-  for (auto& child : children) {
-    this->_helper_allocate_bucket(child);
-    this->child_map_parent[child].insert(node);
-    this->parent_map_child[node].insert(child);
-  }
+  this->trace = std::move(trace);
+  this->graph = &graph;
+  this->pending_parents.clear();
 }
 
 void _DependancyLayer::take_node(const NodeId& node) {
@@ -41,7 +25,6 @@ void _DependancyLayer::take_node(const NodeId& node) {
   }
   if (this->dependancy_free_nodes.find(node) ==
       this->dependancy_free_nodes.end()) {
-    const auto& parents = this->child_map_parent[node];
     throw std::runtime_error(
         "Node " + std::to_string(node) +
         " is not dependancy free or already taken/released");
@@ -63,20 +46,24 @@ void _DependancyLayer::finish_node(const NodeId& node) {
     throw std::runtime_error("Node is not taken");
   }
   this->ongoing_nodes.erase(node);
-  for (auto& child : this->parent_map_child[node]) {
-    if (this->child_map_parent[child].find(node) ==
-        this->child_map_parent[child].end()) {
+  const auto pos = this->_helper_node_pos(node);
+  const auto& graph = *this->graph;
+  for (auto i = graph.child_index[pos]; i < graph.child_index[pos + 1]; i++) {
+    const auto child = graph.children[i];
+    auto it = this->pending_parents.find(child);
+    if (it == this->pending_parents.end())
+      it = this->pending_parents.emplace(child, graph.in_degree(child)).first;
+    if (it->second == 0) {
       // This should not happen, but sanity check
       throw std::runtime_error(
-          "Parent map child is not consistent with child map parent");
+          "Node " + std::to_string(this->trace->node_id(child)) +
+          " has more finished parents than parents");
     }
-    this->child_map_parent[child].erase(node);
-    if (this->child_map_parent[child].empty()) {
-      this->dependancy_free_nodes.insert(child);
+    if (--it->second == 0) {
+      this->pending_parents.erase(it);
+      this->dependancy_free_nodes.insert(this->trace->node_id(child));
     }
   }
-  this->child_map_parent.erase(node);
-  this->parent_map_child.erase(node);
 }
 
 void _DependancyLayer::push_back_node(const NodeId& node) {
@@ -97,11 +84,13 @@ void _DependancyLayer::resolve_dependancy_free_nodes() {
   if ((!this->dependancy_free_nodes.empty()) || (!this->ongoing_nodes.empty()))
     throw std::runtime_error(
         "resolve_dependancy_free_nodes after initialization is not supported yet!");
-  for (auto& it : this->child_map_parent) {
-    auto& node = it.first;
-    auto& parents = it.second;
-    if (parents.empty())
-      this->dependancy_free_nodes.insert(node);
+  if (this->graph == nullptr)
+    throw std::runtime_error(
+        "dependancy layer is not attached to a trace");
+  const auto node_count = this->trace->node_count();
+  for (NodePos pos = 0; pos < node_count; pos++) {
+    if (this->graph->in_degree(pos) == 0)
+      this->dependancy_free_nodes.insert(this->trace->node_id(pos));
   }
   if (this->dependancy_free_nodes.empty())
     throw std::runtime_error(
@@ -114,50 +103,44 @@ const std::unordered_set<NodeId>& _DependancyLayer::get_dependancy_free_nodes()
   return this->dependancy_free_nodes;
 }
 
-const std::unordered_set<NodeId>& _DependancyLayer::get_children(
-    NodeId node) const {
-  const auto& results = this->parent_map_child.at(node);
-  return this->parent_map_child.at(node);
+NodeIdRange _DependancyLayer::get_children(NodeId node) const {
+  const auto pos = this->_helper_node_pos(node);
+  const auto& graph = *this->graph;
+  return this->trace->node_ids(
+      graph.children.data() + graph.child_index[pos],
+      graph.children.data() + graph.child_index[pos + 1]);
 }
 
-const std::unordered_set<NodeId>& _DependancyLayer::get_parents(
-    NodeId node) const {
-  return this->child_map_parent.at(node);
+NodeIdRange _DependancyLayer::get_parents(NodeId node) const {
+  const auto pos = this->_helper_node_pos(node);
+  const auto& graph = *this->graph;
+  return this->trace->node_ids(
+      graph.parents.data() + graph.parent_index[pos],
+      graph.parents.data() + graph.parent_index[pos + 1]);
 }
 
 const std::unordered_set<NodeId>& _DependancyLayer::get_ongoing_nodes() const {
   return this->ongoing_nodes;
 }
 
-void _DependancyLayer::_helper_allocate_bucket(NodeId node_id) {
-  if (this->child_map_parent.find(node_id) == this->child_map_parent.end()) {
-    this->child_map_parent[node_id] = std::unordered_set<NodeId>();
-  }
-  if (this->parent_map_child.find(node_id) == this->parent_map_child.end()) {
-    this->parent_map_child[node_id] = std::unordered_set<NodeId>();
-  }
+NodePos _DependancyLayer::_helper_node_pos(NodeId node_id) const {
+  NodePos pos;
+  if (this->graph == nullptr || !this->trace->find_node(node_id, pos))
+    throw std::out_of_range(
+        "Node " + std::to_string(node_id) + " not found in dependancy graph");
+  return pos;
 }
 
-void DependancyResolver::add_node(const ChakraNode& node) {
-  NodeId node_id = node.id();
-  std::unordered_set<NodeId> parents, enabled_parents;
-  for (auto& parent : node.data_deps()) {
-    if (this->enable_data_deps)
-      enabled_parents.insert(parent);
-    parents.insert(parent);
-  }
-  this->data_dependancy.add_node(node_id, parents);
-  parents.clear();
-
-  for (auto& parent : node.ctrl_deps()) {
-    if (this->enable_ctrl_deps)
-      enabled_parents.insert(parent);
-    parents.insert(parent);
-  }
-  this->ctrl_dependancy.add_node(node_id, parents);
-  parents.clear();
-
-  this->enabled_dependancy.add_node(node_id, enabled_parents);
+void DependancyResolver::attach(const std::shared_ptr<const MappedTrace>& trace) {
+  const auto& topology = trace->get_topology();
+  this->data_dependancy.attach(trace, topology.data_deps);
+  this->ctrl_dependancy.attach(trace, topology.ctrl_deps);
+  if (this->enable_data_deps && this->enable_ctrl_deps)
+    this->enabled_dependancy.attach(trace, topology.all_deps);
+  else if (this->enable_data_deps)
+    this->enabled_dependancy.attach(trace, topology.data_deps);
+  else
+    this->enabled_dependancy.attach(trace, topology.ctrl_deps);
 }
 
 void DependancyResolver::take_node(const NodeId& node) {
@@ -205,15 +188,3 @@ const _DependancyLayer& DependancyResolver::get_ctrl_dependancy() const {
 const _DependancyLayer& DependancyResolver::get_enabled_dependancy() const {
   return this->enabled_dependancy;
 }
-
-_DependancyLayer& DependancyResolver::get_data_dependancy_mut() {
-  return this->data_dependancy;
-}
-
-_DependancyLayer& DependancyResolver::get_ctrl_dependancy_mut() {
-  return this->ctrl_dependancy;
-}
-
-_DependancyLayer& DependancyResolver::get_enabled_dependancy_mut() {
-  return this->enabled_dependancy;
-}
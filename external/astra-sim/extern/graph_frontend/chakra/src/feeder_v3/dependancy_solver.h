@@ -2,11 +2,13 @@
 #define CHAKRA_FEEDER_V3_DEPENDANCY_SOLVER_H
 
 #include <cstdint>
+#include <memory>
 #include <shared_mutex>
 #include <unordered_map>
 #include <unordered_set>
 #include "common.h"
 #include "et_def.pb.h"
+#include "mapped_trace.h"
 
 namespace Chakra {
 namespace FeederV3 {
@@ -15,8 +17,7 @@ class _DependancyLayer {
  public:
   _DependancyLayer() = default;
   ~_DependancyLayer() {
-    this->child_map_parent.clear();
-    this->parent_map_child.clear();
+    this->pending_parents.clear();
     this->dependancy_free_nodes.clear();
     this->ongoing_nodes.clear();
   }
@@ -31,11 +32,14 @@ class _DependancyLayer {
    *     The child of it may be released if all its parents is finished.
    *  Finished --add--> Pending --take--> Taken --finish--> Finished
    *  Taken --push_back--> Pending
+   *
+   * The edges are the read-only graph shared by all feeders of the same
+   * trace structure; a layer only tracks the parents still unfinished of the
+   * nodes that have lost at least one of them.
    */
-  void add_node(const NodeId& node, const std::unordered_set<NodeId>& parents);
-  void add_node_children(
-      const NodeId& node,
-      const std::unordered_set<NodeId>& children);
+  void attach(
+      std::shared_ptr<const MappedTrace> trace,
+      const DependancyGraph& graph);
   void take_node(const NodeId& node);
   void finish_node(const NodeId& node);
   void push_back_node(const NodeId& node);
@@ -43,16 +47,17 @@ class _DependancyLayer {
 
   const std::unordered_set<NodeId>& get_dependancy_free_nodes() const;
   const std::unordered_set<NodeId>& get_ongoing_nodes() const;
-  const std::unordered_set<NodeId>& get_children(NodeId node) const;
-  const std::unordered_set<NodeId>& get_parents(NodeId node) const;
+  NodeIdRange get_children(NodeId node) const;
+  NodeIdRange get_parents(NodeId node) const;
 
  private:
-  std::unordered_map<NodeId, std::unordered_set<NodeId>> child_map_parent;
-  std::unordered_map<NodeId, std::unordered_set<NodeId>> parent_map_child;
+  std::shared_ptr<const MappedTrace> trace;
+  const DependancyGraph* graph = nullptr;
+  std::unordered_map<NodePos, uint32_t> pending_parents;
   std::unordered_set<NodeId> dependancy_free_nodes;
   std::unordered_set<NodeId> ongoing_nodes;
   bool dirty = true;
-  void _helper_allocate_bucket(NodeId node_id);
+  NodePos _helper_node_pos(NodeId node_id) const;
   std::shared_mutex mutex;
 };
 
@@ -65,7 +70,7 @@ class DependancyResolver {
         throw std::runtime_error(
             "Should not create a dependancy resolver that resolves neither data nor control dependancy");
   }
-  void add_node(const ChakraNode& node);
+  void attach(const std::shared_ptr<const MappedTrace>& trace);
   void take_node(const NodeId& node);
   void push_back_node(const NodeId& node);
   void finish_node(const NodeId& node);
@@ -77,12 +82,6 @@ class DependancyResolver {
   const _DependancyLayer& get_ctrl_dependancy() const;
   const _DependancyLayer& get_enabled_dependancy() const;
 
-  // Warning: It is user's responsibility to make sure different layer's
-  // dependancy are consistent.
-  _DependancyLayer& get_data_dependancy_mut();
-  _DependancyLayer& get_ctrl_dependancy_mut();
-  _DependancyLayer& get_enabled_dependancy_mut();
-
  private:
   bool enable_data_deps;
   bool enable_ctrl_deps;
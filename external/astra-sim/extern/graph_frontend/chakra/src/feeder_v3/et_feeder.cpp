@@ -1,6 +1,5 @@
 #include "et_feeder.h"
 #include "common.h"
-#include "protobuf_util.h"
 
 using namespace Chakra::FeederV3;
 
@@ -10,9 +9,8 @@ void ETFeeder::addNode(std::shared_ptr<ETFeederNode> node) {
 }
 
 void ETFeeder::removeNode(const NodeId& node_id) {
-  static bool firstTime = true;
-  if (firstTime) {
-    firstTime = false;
+  static std::atomic<bool> firstTime = true;
+  if (firstTime.exchange(false)) {
     std::cerr
         << "For offloaded ETFeeder, the graph is static and readonly, and removeNode is ignored"
         << std::endl;
@@ -42,81 +40,38 @@ void ETFeeder::freeChildrenNodes(const NodeId& node_id) {
   this->dependancy_resolver.finish_node(node_id);
 }
 
-uint64_t ETFeeder::_feeder_id_cnt = 0;
+std::atomic<uint64_t> ETFeeder::_feeder_id_cnt = 0;
 Cache<std::tuple<ETFeederId, NodeId>, ChakraNode> ETFeeder::_node_cache(
     DEFAULT_ETFEEDER_CACHE_SIZE);
 
 void ETFeeder::build_index_dependancy_cache() {
-  this->chakra_file.clear();
-  this->chakra_file.seekg(0, std::ios::beg);
-  ChakraNode node;
-  bool ret = ProtobufUtils::readMessage<ChakraGlobalMetadata>(
-      this->chakra_file, this->global_metadata);
-  if (!ret)
-    throw std::runtime_error("Failed to read global metadata");
-  std::streampos last_pos = this->chakra_file.tellg();
-  while (true) {
-    ret = ProtobufUtils::readMessage<ChakraNode>(this->chakra_file, node);
-    if (!ret)
-      break;
-    // build index
-    const auto& node_id = node.id();
-    this->index_map[node_id] = last_pos;
-    last_pos = this->chakra_file.tellg();
-    // build dependancy
-    this->dependancy_resolver.add_node(node);
-  }
-  this->chakra_file.clear();
-  this->chakra_file.seekg(0, std::ios::beg);
+  // the index and dependancy graph come from the trace (and its sidecar);
+  // only the resolving state is per feeder
+  this->trace->parse_global_metadata(this->global_metadata);
+  this->dependancy_resolver.attach(this->trace);
   this->dependancy_resolver.resolve_dependancy_free_nodes();
 }
 
 std::shared_ptr<const ChakraNode> ETFeeder::get_raw_chakra_node(
     NodeId node_id) {
-  auto key = std::make_tuple(this->_feeder_id, node_id);
+  auto key = std::make_tuple(this->trace->trace_id(), node_id);
   auto node = ETFeeder::_node_cache.get_or_null_locked(key);
   if (node) {
     // hit
     return node;
   }
 
-  // miss
-  if (this->index_map.find(node_id) == this->index_map.end())
+  // miss, decode straight from the mapped trace
+  NodePos pos;
+  if (!this->trace->find_node(node_id, pos))
     throw std::runtime_error(
         "Node " + std::to_string(node_id) + " not found in index");
-  auto& pos = this->index_map[node_id];
-  this->chakra_file.seekg(pos);
   ChakraNode node_msg;
-  ProtobufUtils::readMessage<ChakraNode>(this->chakra_file, node_msg);
+  this->trace->parse_node(pos, node_msg);
   ETFeeder::_node_cache.put(key, node_msg);
   return ETFeeder::_node_cache.get_locked(key);
 }
 
-void ETFeeder::graph_sanity_check() {
-  // check if all nodes in dependancy graph exists.
-  const auto& data_dep = this->dependancy_resolver.get_data_dependancy();
-  const auto& ctrl_dep = this->dependancy_resolver.get_ctrl_dependancy();
-  const auto& enabled_dep = this->dependancy_resolver.get_enabled_dependancy();
-  for (const auto& node : data_dep.get_dependancy_free_nodes()) {
-    if (this->index_map.find(node) == this->index_map.end())
-      throw std::runtime_error(
-          "Node " + std::to_string(node) +
-          " in data_dep graph, but not found in index, file might be corrupted");
-  }
-  for (const auto& node : ctrl_dep.get_dependancy_free_nodes()) {
-    if (this->index_map.find(node) == this->index_map.end())
-      throw std::runtime_error(
-          "Node " + std::to_string(node) +
-          " in ctrl_dep graph, but not found in index, file might be corrupted");
-  }
-  for (const auto& node : enabled_dep.get_dependancy_free_nodes()) {
-    if (this->index_map.find(node) == this->index_map.end())
-      throw std::runtime_error(
-          "Node " + std::to_string(node) +
-          " in all_dep graph, but not found in index, file might be corrupted");
-  }
-}
-
 const uint64_t& ETFeeder::feeder_id() const {
   return this->_feeder_id;
 }
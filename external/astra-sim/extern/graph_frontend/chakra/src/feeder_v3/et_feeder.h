@@ -1,7 +1,7 @@
 #ifndef CHAKRA_FEEDER_V3_ET_FEEDER_H
 #define CHAKRA_FEEDER_V3_ET_FEEDER_H
 
-#include <fstream>
+#include <atomic>
 #include <functional>
 #include <memory>
 #include <string>
@@ -11,6 +11,7 @@
 #include "dependancy_solver.h"
 #include "et_def.pb.h"
 #include "et_feeder_node.h"
+#include "mapped_trace.h"
 
 namespace std {
 template <>
@@ -32,19 +33,14 @@ class ETFeeder {
  public:
   ChakraGlobalMetadata global_metadata;
   ETFeeder(const std::string& file_path)
-      : chakra_file(file_path, std::ios::binary | std::ios::in | std::ios::app),
+      : trace(MappedTrace::open(file_path)),
         _feeder_id(_feeder_id_cnt++),
         dependancy_resolver(RESOLVE_DATA_DEPS, RESOLVE_CTRL_DEPS) {
-    if (!chakra_file.is_open())
-      throw std::runtime_error("Failed to open file " + file_path);
     this->build_index_dependancy_cache();
-    this->graph_sanity_check(); // make sure graph is sane
   }
 
   ~ETFeeder() {
     // no explict cache release. Will be kicked-out natually.
-    index_map.clear();
-    chakra_file.close();
   }
 
   DependancyResolver& getDependancyResolver() {
@@ -64,22 +60,22 @@ class ETFeeder {
   const uint64_t& feeder_id() const;
 
  private:
-  std::ifstream chakra_file;
+  // mapped trace and its index, shared by every feeder of the same file
+  std::shared_ptr<const MappedTrace> trace;
 
-  static uint64_t _feeder_id_cnt;
+  // feeders may be created by simulations running on several threads
+  static std::atomic<uint64_t> _feeder_id_cnt;
   uint64_t _feeder_id;
 
-  // shared global cache for storing chakra msgs.
+  // shared global cache for storing chakra msgs, keyed by the trace id so
+  // that feeders of the same file share decoded nodes.
   static Cache<std::tuple<ETFeederId, NodeId>, ChakraNode> _node_cache;
 
-  std::unordered_map<NodeId, std::streampos> index_map;
   DependancyResolver dependancy_resolver;
 
   void build_index_dependancy_cache();
   std::shared_ptr<const ChakraNode> get_raw_chakra_node(NodeId node_id);
   friend class ETFeederNode;
-
-  void graph_sanity_check();
 };
 
 } // namespace FeederV3
@@ -47,8 +47,8 @@ ChakraAttr::ValueCase ETFeederNode::get_attr_type(
 }
 
 NodeId ETFeederNode::id() const {
-  auto node = this->get_chakra_node();
-  return node->id();
+  // known from the index, no need to decode the node
+  return this->node_id;
 }
 
 std::string ETFeederNode::name() const {
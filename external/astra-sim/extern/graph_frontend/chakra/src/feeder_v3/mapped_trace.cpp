@@ -0,0 +1,657 @@
+#include "mapped_trace.h"
+#include <fcntl.h>
+#include <google/protobuf/io/coded_stream.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <mutex>
+#include <stdexcept>
+#include <unordered_map>
+
+using namespace Chakra::FeederV3;
+
+namespace {
+
+constexpr char INDEX_MAGIC[8] = {'C', 'H', 'K', 'R', 'I', 'D', 'X', '\0'};
+
+// fixed-size header of the index sidecar, followed by the sections below
+struct IndexHeader {
+  char magic[8];
+  uint64_t version;
+  uint64_t trace_size;
+  int64_t trace_mtime_ns;
+  uint64_t node_count;
+  uint64_t data_edge_count;
+  uint64_t ctrl_edge_count;
+  uint64_t metadata_offset;
+  uint64_t metadata_size;
+  uint64_t id_base;
+  uint64_t topology_hash;
+  uint64_t reserved[5];
+};
+static_assert(sizeof(IndexHeader) == 128, "index header must stay 128 bytes");
+
+// word (uint64_t) offsets of the index sections, each 8-byte aligned
+struct IndexLayout {
+  size_t rel_ids;
+  size_t offsets;
+  size_t sizes;
+  size_t data_parent_index;
+  size_t data_parents;
+  size_t ctrl_parent_index;
+  size_t ctrl_parents;
+  size_t total;
+
+  IndexLayout(uint64_t nodes, uint64_t data_edges, uint64_t ctrl_edges) {
+    const auto u32_words = [](uint64_t count) { return (count + 1) / 2; };
+    this->rel_ids = sizeof(IndexHeader) / sizeof(uint64_t);
+    this->offsets = this->rel_ids + nodes;
+    this->sizes = this->offsets + nodes;
+    this->data_parent_index = this->sizes + u32_words(nodes);
+    this->data_parents = this->data_parent_index + u32_words(nodes + 1);
+    this->ctrl_parent_index = this->data_parents + u32_words(data_edges);
+    this->ctrl_parents = this->ctrl_parent_index + u32_words(nodes + 1);
+    this->total = this->ctrl_parents + u32_words(ctrl_edges);
+  }
+};
+
+// FNV-1a over raw bytes
+uint64_t fnv1a(uint64_t hash, const void* data, size_t size) {
+  const auto* bytes = static_cast<const uint8_t*>(data);
+  for (size_t i = 0; i < size; i++) {
+    hash ^= bytes[i];
+    hash *= 1099511628211ull;
+  }
+  return hash;
+}
+
+// the varint32 length prefix of a message, as ProtobufUtils::readVarint32
+bool read_length(const uint8_t*& cursor, const uint8_t* end, uint32_t& value) {
+  value = 0;
+  int shift = 0;
+  while (cursor < end) {
+    const uint8_t byte = *cursor++;
+    value |= static_cast<uint32_t>(byte & 0x7f) << shift;
+    if (!(byte & 0x80))
+      return true;
+    shift += 7;
+    if (shift > 28)
+      return false;
+  }
+  return false;
+}
+
+// id and dependancies of a node, read off the wire without a full decode
+struct ScannedNode {
+  NodeId id = 0;
+  uint64_t offset = 0;
+  uint32_t size = 0;
+  std::vector<NodeId> data_deps;
+  std::vector<NodeId> ctrl_deps;
+};
+
+bool read_deps(
+    google::protobuf::io::CodedInputStream& input,
+    uint32_t wire_type,
+    std::vector<NodeId>& deps) {
+  uint64_t value;
+  if (wire_type == 0) {
+    if (!input.ReadVarint64(&value))
+      return false;
+    deps.push_back(value);
+    return true;
+  }
+  uint32_t length;
+  if (!input.ReadVarint32(&length))
+    return false;
+  const auto limit = input.PushLimit(static_cast<int>(length));
+  while (input.BytesUntilLimit() > 0) {
+    if (!input.ReadVarint64(&value))
+      return false;
+    deps.push_back(value);
+  }
+  input.PopLimit(limit);
+  return true;
+}
+
+bool scan_node(const uint8_t* data, uint32_t size, ScannedNode& node) {
+  google::protobuf::io::CodedInputStream input(data, static_cast<int>(size));
+  uint32_t tag;
+  while ((tag = input.ReadTag()) != 0) {
+    const uint32_t field = tag >> 3;
+    const uint32_t wire_type = tag & 7;
+    uint64_t value;
+    uint32_t length;
+    if (field == 1 && wire_type == 0) {
+      if (!input.ReadVarint64(&node.id))
+        return false;
+    } else if ((field == 4 || field == 5) && (wire_type == 0 || wire_type == 2)) {
+      auto& deps = (field == 4) ? node.ctrl_deps : node.data_deps;
+      if (!read_deps(input, wire_type, deps))
+        return false;
+    } else if (wire_type == 0) {
+      if (!input.ReadVarint64(&value))
+        return false;
+    } else if (wire_type == 1) {
+      if (!input.Skip(8))
+        return false;
+    } else if (wire_type == 2) {
+      if (!input.ReadVarint32(&length) || !input.Skip(static_cast<int>(length)))
+        return false;
+    } else if (wire_type == 5) {
+      if (!input.Skip(4))
+        return false;
+    } else {
+      return false;
+    }
+  }
+  return input.ConsumedEntireMessage();
+}
+
+// position of every dependancy, sorted and deduplicated, as a CSR
+void build_parents(
+    const std::vector<ScannedNode>& nodes,
+    const std::vector<uint64_t>& rel_ids,
+    uint64_t id_base,
+    bool data,
+    std::vector<uint32_t>& parent_index,
+    std::vector<NodePos>& parents) {
+  parent_index.assign(1, 0);
+  parents.clear();
+  for (const auto& node : nodes) {
+    const auto begin = parents.size();
+    for (const auto& parent : data ? node.data_deps : node.ctrl_deps) {
+      const auto it = std::lower_bound(
+          rel_ids.begin(), rel_ids.end(), parent - id_base);
+      if (parent < id_base || it == rel_ids.end() || *it != parent - id_base)
+        throw std::runtime_error(
+            "Node " + std::to_string(parent) + " in " +
+            (data ? "data_dep" : "ctrl_dep") +
+            " graph, but not found in index, file might be corrupted");
+      parents.push_back(static_cast<NodePos>(it - rel_ids.begin()));
+    }
+    std::sort(parents.begin() + begin, parents.end());
+    parents.erase(
+        std::unique(parents.begin() + begin, parents.end()), parents.end());
+    parent_index.push_back(static_cast<uint32_t>(parents.size()));
+  }
+}
+
+void build_children(DependancyGraph& graph, size_t node_count) {
+  graph.child_index.assign(node_count + 1, 0);
+  for (const auto& parent : graph.parents)
+    graph.child_index[parent + 1]++;
+  for (size_t pos = 0; pos < node_count; pos++)
+    graph.child_index[pos + 1] += graph.child_index[pos];
+  graph.children.resize(graph.parents.size());
+  auto fill = std::vector<uint32_t>(
+      graph.child_index.begin(), graph.child_index.end() - 1);
+  for (NodePos child = 0; child < node_count; child++)
+    for (auto i = graph.parent_index[child]; i < graph.parent_index[child + 1];
+         i++)
+      graph.children[fill[graph.parents[i]]++] = child;
+}
+
+bool valid_csr(
+    const uint32_t* parent_index,
+    const NodePos* parents,
+    size_t node_count,
+    size_t edge_count) {
+  if (parent_index[0] != 0 || parent_index[node_count] != edge_count)
+    return false;
+  for (size_t pos = 0; pos < node_count; pos++)
+    if (parent_index[pos] > parent_index[pos + 1])
+      return false;
+  for (size_t i = 0; i < edge_count; i++)
+    if (parents[i] >= node_count)
+      return false;
+  return true;
+}
+
+int64_t modification_time_ns(const std::string& file_path) {
+  const auto mtime = std::filesystem::last_write_time(file_path);
+  return static_cast<int64_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(
+          mtime.time_since_epoch())
+          .count());
+}
+
+std::mutex registry_mutex;
+std::map<std::pair<dev_t, ino_t>, std::weak_ptr<const MappedTrace>>
+    trace_registry;
+std::unordered_multimap<uint64_t, std::weak_ptr<const TraceTopology>>
+    topology_registry;
+
+} // namespace
+
+MappedRegion::~MappedRegion() {
+  this->unmap();
+}
+
+void MappedRegion::unmap() {
+  if (this->region_data != nullptr)
+    munmap(const_cast<char*>(this->region_data), this->region_size);
+  this->region_data = nullptr;
+  this->region_size = 0;
+}
+
+bool MappedRegion::map(const std::string& file_path) {
+  this->unmap();
+  const int fd = ::open(file_path.c_str(), O_RDONLY);
+  if (fd < 0)
+    return false;
+  struct stat st;
+  if (fstat(fd, &st) != 0) {
+    close(fd);
+    return false;
+  }
+  this->region_size = static_cast<size_t>(st.st_size);
+  if (this->region_size == 0) {
+    close(fd);
+    return true;
+  }
+  void* data =
+      mmap(nullptr, this->region_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (data == MAP_FAILED) {
+    this->region_size = 0;
+    return false;
+  }
+  this->region_data = static_cast<const char*>(data);
+  return true;
+}
+
+std::shared_ptr<const TraceTopology> TraceTopology::intern(
+    uint64_t hash,
+    const uint64_t* rel_ids,
+    size_t node_count,
+    const uint32_t* data_parent_index,
+    const NodePos* data_parents,
+    const uint32_t* ctrl_parent_index,
+    const NodePos* ctrl_parents) {
+  std::unique_lock<std::mutex> lock(registry_mutex);
+  const auto candidates = topology_registry.equal_range(hash);
+  for (auto it = candidates.first; it != candidates.second;) {
+    auto topology = it->second.lock();
+    if (!topology) {
+      it = topology_registry.erase(it);
+      continue;
+    }
+    if (topology->same_as(
+            rel_ids,
+            node_count,
+            data_parent_index,
+            data_parents,
+            ctrl_parent_index,
+            ctrl_parents))
+      return topology;
+    ++it;
+  }
+
+  auto topology = std::make_shared<TraceTopology>();
+  topology->hash = hash;
+  topology->rel_ids.assign(rel_ids, rel_ids + node_count);
+  topology->dense_ids = node_count == 0 || rel_ids[node_count - 1] == node_count - 1;
+  const auto assign = [node_count](
+                          DependancyGraph& graph,
+                          const uint32_t* parent_index,
+                          const NodePos* parents) {
+    graph.parent_index.assign(parent_index, parent_index + node_count + 1);
+    graph.parents.assign(parents, parents + parent_index[node_count]);
+    build_children(graph, node_count);
+  };
+  assign(topology->data_deps, data_parent_index, data_parents);
+  assign(topology->ctrl_deps, ctrl_parent_index, ctrl_parents);
+
+  // both lists of each node are sorted, so their union is a merge
+  auto& all_deps = topology->all_deps;
+  all_deps.parent_index.assign(1, 0);
+  for (size_t pos = 0; pos < node_count; pos++) {
+    std::set_union(
+        data_parents + data_parent_index[pos],
+        data_parents + data_parent_index[pos + 1],
+        ctrl_parents + ctrl_parent_index[pos],
+        ctrl_parents + ctrl_parent_index[pos + 1],
+        std::back_inserter(all_deps.parents));
+    all_deps.parent_index.push_back(
+        static_cast<uint32_t>(all_deps.parents.size()));
+  }
+  build_children(all_deps, node_count);
+
+  topology_registry.emplace(hash, topology);
+  return topology;
+}
+
+bool TraceTopology::same_as(
+    const uint64_t* rel_ids,
+    size_t node_count,
+    const uint32_t* data_parent_index,
+    const NodePos* data_parents,
+    const uint32_t* ctrl_parent_index,
+    const NodePos* ctrl_parents) const {
+  const auto same_graph = [node_count](
+                              const DependancyGraph& graph,
+                              const uint32_t* parent_index,
+                              const NodePos* parents) {
+    return std::equal(
+               graph.parent_index.begin(),
+               graph.parent_index.end(),
+               parent_index) &&
+        std::equal(graph.parents.begin(), graph.parents.end(), parents);
+  };
+  return this->node_count() == node_count &&
+      std::equal(this->rel_ids.begin(), this->rel_ids.end(), rel_ids) &&
+      this->data_deps.parent_index[node_count] ==
+      data_parent_index[node_count] &&
+      this->ctrl_deps.parent_index[node_count] ==
+      ctrl_parent_index[node_count] &&
+      same_graph(this->data_deps, data_parent_index, data_parents) &&
+      same_graph(this->ctrl_deps, ctrl_parent_index, ctrl_parents);
+}
+
+NodeIdRange::const_iterator NodeIdRange::find(NodeId node_id) const {
+  NodePos pos;
+  if (!this->trace->find_node(node_id, pos))
+    return this->end();
+  return const_iterator(std::find(this->first, this->last, pos), this->trace);
+}
+
+uint64_t MappedTrace::_trace_id_cnt = 0;
+
+std::shared_ptr<const MappedTrace> MappedTrace::open(
+    const std::string& file_path) {
+  struct stat st;
+  if (stat(file_path.c_str(), &st) != 0)
+    throw std::runtime_error("Failed to open file " + file_path);
+  const auto key = std::make_pair(st.st_dev, st.st_ino);
+  const auto mtime_ns = modification_time_ns(file_path);
+  {
+    std::unique_lock<std::mutex> lock(registry_mutex);
+    const auto it = trace_registry.find(key);
+    if (it != trace_registry.end()) {
+      auto trace = it->second.lock();
+      if (trace && trace->trace_region.size() == static_cast<size_t>(st.st_size) &&
+          trace->trace_mtime_ns == mtime_ns)
+        return trace;
+    }
+  }
+
+  auto trace = std::shared_ptr<MappedTrace>(new MappedTrace());
+  trace->_file_path = file_path;
+  trace->trace_mtime_ns = mtime_ns;
+  if (!trace->trace_region.map(file_path))
+    throw std::runtime_error("Failed to open file " + file_path);
+  trace->load_index();
+
+  std::unique_lock<std::mutex> lock(registry_mutex);
+  trace->_trace_id = _trace_id_cnt++;
+  trace_registry[key] = trace;
+  return trace;
+}
+
+bool MappedTrace::find_node(NodeId node_id, NodePos& pos) const {
+  const auto& rel_ids = this->topology->rel_ids;
+  if (node_id < this->id_base || rel_ids.empty())
+    return false;
+  const auto rel_id = node_id - this->id_base;
+  if (this->topology->dense_ids) {
+    if (rel_id >= rel_ids.size())
+      return false;
+    pos = static_cast<NodePos>(rel_id);
+    return true;
+  }
+  const auto it = std::lower_bound(rel_ids.begin(), rel_ids.end(), rel_id);
+  if (it == rel_ids.end() || *it != rel_id)
+    return false;
+  pos = static_cast<NodePos>(it - rel_ids.begin());
+  return true;
+}
+
+std::pair<const char*, size_t> MappedTrace::node_bytes(NodePos pos) const {
+  const auto offset = this->node_offsets[pos];
+  const auto size = this->node_sizes[pos];
+  if (offset + size > this->trace_region.size())
+    throw std::runtime_error(
+        "Node " + std::to_string(this->node_id(pos)) +
+        " lies outside of file " + this->_file_path);
+  return std::make_pair(this->trace_region.data() + offset, size);
+}
+
+void MappedTrace::parse_node(NodePos pos, ChakraNode& node) const {
+  const auto bytes = this->node_bytes(pos);
+  if (!node.ParseFromArray(bytes.first, static_cast<int>(bytes.second)))
+    throw std::runtime_error(
+        "Failed to parse node " + std::to_string(this->node_id(pos)));
+}
+
+void MappedTrace::parse_global_metadata(ChakraGlobalMetadata& metadata) const {
+  if (!metadata.ParseFromArray(
+          this->trace_region.data() + this->metadata_offset,
+          static_cast<int>(this->metadata_size)))
+    throw std::runtime_error("Failed to read global metadata");
+}
+
+void MappedTrace::load_index() {
+  const auto index_path = this->_file_path + ".idx";
+  if (this->index_region.map(index_path) &&
+      this->attach_index(this->index_region.data(), this->index_region.size()))
+    return;
+
+  this->index_buffer = this->build_index();
+  const auto index_bytes = this->index_buffer.size() * sizeof(uint64_t);
+  if (DEFAULT_ETFEEDER_WRITE_INDEX) {
+    // write to a private file and rename, so concurrent runs never see a
+    // partial sidecar
+    const auto temp_path = index_path + ".tmp." + std::to_string(getpid()) +
+        "." + std::to_string(reinterpret_cast<uintptr_t>(this));
+    bool written = false;
+    {
+      std::ofstream index_file(temp_path, std::ios::binary | std::ios::trunc);
+      if (index_file.is_open()) {
+        index_file.write(
+            reinterpret_cast<const char*>(this->index_buffer.data()),
+            static_cast<std::streamsize>(index_bytes));
+        written = index_file.good();
+      }
+    }
+    if (written && std::rename(temp_path.c_str(), index_path.c_str()) == 0) {
+      if (this->index_region.map(index_path) &&
+          this->attach_index(
+              this->index_region.data(), this->index_region.size())) {
+        std::vector<uint64_t>().swap(this->index_buffer);
+        return;
+      }
+    } else {
+      std::remove(temp_path.c_str());
+    }
+  }
+
+  // sidecar not writable: keep the index in memory
+  if (!this->attach_index(
+          reinterpret_cast<const char*>(this->index_buffer.data()),
+          index_bytes))
+    throw std::runtime_error("Failed to index file " + this->_file_path);
+}
+
+bool MappedTrace::attach_index(const char* data, size_t size) {
+  if (size < sizeof(IndexHeader))
+    return false;
+  const auto* header = reinterpret_cast<const IndexHeader*>(data);
+  if (std::memcmp(header->magic, INDEX_MAGIC, sizeof(INDEX_MAGIC)) != 0 ||
+      header->version != ETFEEDER_INDEX_VERSION ||
+      header->trace_size != this->trace_region.size() ||
+      header->trace_mtime_ns != this->trace_mtime_ns ||
+      header->node_count > UINT32_MAX ||
+      header->data_edge_count > UINT32_MAX ||
+      header->ctrl_edge_count > UINT32_MAX ||
+      header->metadata_offset + header->metadata_size > header->trace_size)
+    return false;
+  const auto node_count = header->node_count;
+  const auto layout = IndexLayout(
+      node_count, header->data_edge_count, header->ctrl_edge_count);
+  if (size != layout.total * sizeof(uint64_t))
+    return false;
+
+  const auto* words = reinterpret_cast<const uint64_t*>(data);
+  const auto* rel_ids = words + layout.rel_ids;
+  const auto* data_parent_index =
+      reinterpret_cast<const uint32_t*>(words + layout.data_parent_index);
+  const auto* data_parents =
+      reinterpret_cast<const NodePos*>(words + layout.data_parents);
+  const auto* ctrl_parent_index =
+      reinterpret_cast<const uint32_t*>(words + layout.ctrl_parent_index);
+  const auto* ctrl_parents =
+      reinterpret_cast<const NodePos*>(words + layout.ctrl_parents);
+  if (!std::is_sorted(rel_ids, rel_ids + node_count) ||
+      !valid_csr(
+          data_parent_index, data_parents, node_count, header->data_edge_count) ||
+      !valid_csr(
+          ctrl_parent_index, ctrl_parents, node_count, header->ctrl_edge_count))
+    return false;
+
+  this->id_base = header->id_base;
+  this->metadata_offset = header->metadata_offset;
+  this->metadata_size = header->metadata_size;
+  this->node_offsets = words + layout.offsets;
+  this->node_sizes = reinterpret_cast<const uint32_t*>(words + layout.sizes);
+  this->topology = TraceTopology::intern(
+      header->topology_hash,
+      rel_ids,
+      node_count,
+      data_parent_index,
+      data_parents,
+      ctrl_parent_index,
+      ctrl_parents);
+  return true;
+}
+
+std::vector<uint64_t> MappedTrace::build_index() const {
+  const auto* begin = reinterpret_cast<const uint8_t*>(this->trace_region.data());
+  const auto* end = begin + this->trace_region.size();
+  const auto* cursor = begin;
+
+  uint32_t size;
+  if (!read_length(cursor, end, size) || size > end - cursor)
+    throw std::runtime_error("Failed to read global metadata");
+  const uint64_t metadata_offset = cursor - begin;
+  const uint64_t metadata_size = size;
+  cursor += size;
+
+  // scan every node for its id and dependancies only
+  std::vector<ScannedNode> nodes;
+  while (cursor < end) {
+    if (!read_length(cursor, end, size))
+      break;
+    if (size > end - cursor)
+      throw std::runtime_error(
+          "Truncated node at offset " + std::to_string(cursor - begin) +
+          " in file " + this->_file_path);
+    ScannedNode node;
+    node.offset = cursor - begin;
+    node.size = size;
+    if (!scan_node(cursor, size, node))
+      throw std::runtime_error(
+          "Failed to parse node at offset " + std::to_string(node.offset) +
+          " in file " + this->_file_path);
+    nodes.push_back(std::move(node));
+    cursor += size;
+  }
+  if (nodes.size() > UINT32_MAX)
+    throw std::runtime_error("Too many nodes in file " + this->_file_path);
+
+  // order by id; a repeated id keeps its last message and all dependancies
+  std::stable_sort(
+      nodes.begin(), nodes.end(), [](const auto& lhs, const auto& rhs) {
+        return lhs.id < rhs.id;
+      });
+  std::vector<ScannedNode> unique_nodes;
+  for (auto& node : nodes) {
+    if (!unique_nodes.empty() && unique_nodes.back().id == node.id) {
+      auto& last = unique_nodes.back();
+      last.offset = node.offset;
+      last.size = node.size;
+      last.data_deps.insert(
+          last.data_deps.end(), node.data_deps.begin(), node.data_deps.end());
+      last.ctrl_deps.insert(
+          last.ctrl_deps.end(), node.ctrl_deps.begin(), node.ctrl_deps.end());
+    } else {
+      unique_nodes.push_back(std::move(node));
+    }
+  }
+  std::vector<ScannedNode>().swap(nodes);
+
+  const uint64_t node_count = unique_nodes.size();
+  const uint64_t id_base = node_count == 0 ? 0 : unique_nodes.front().id;
+  std::vector<uint64_t> rel_ids(node_count);
+  for (size_t pos = 0; pos < node_count; pos++)
+    rel_ids[pos] = unique_nodes[pos].id - id_base;
+  std::vector<uint32_t> data_parent_index, ctrl_parent_index;
+  std::vector<NodePos> data_parents, ctrl_parents;
+  build_parents(
+      unique_nodes, rel_ids, id_base, true, data_parent_index, data_parents);
+  build_parents(
+      unique_nodes, rel_ids, id_base, false, ctrl_parent_index, ctrl_parents);
+
+  const auto layout =
+      IndexLayout(node_count, data_parents.size(), ctrl_parents.size());
+  std::vector<uint64_t> index(layout.total, 0);
+  auto* header = reinterpret_cast<IndexHeader*>(index.data());
+  std::memcpy(header->magic, INDEX_MAGIC, sizeof(INDEX_MAGIC));
+  header->version = ETFEEDER_INDEX_VERSION;
+  header->trace_size = this->trace_region.size();
+  header->trace_mtime_ns = this->trace_mtime_ns;
+  header->node_count = node_count;
+  header->data_edge_count = data_parents.size();
+  header->ctrl_edge_count = ctrl_parents.size();
+  header->metadata_offset = metadata_offset;
+  header->metadata_size = metadata_size;
+  header->id_base = id_base;
+
+  auto* words = index.data();
+  std::copy(rel_ids.begin(), rel_ids.end(), words + layout.rel_ids);
+  auto* sizes = reinterpret_cast<uint32_t*>(words + layout.sizes);
+  for (size_t pos = 0; pos < node_count; pos++) {
+    words[layout.offsets + pos] = unique_nodes[pos].offset;
+    sizes[pos] = unique_nodes[pos].size;
+  }
+  std::copy(
+      data_parent_index.begin(),
+      data_parent_index.end(),
+      reinterpret_cast<uint32_t*>(words + layout.data_parent_index));
+  std::copy(
+      data_parents.begin(),
+      data_parents.end(),
+      reinterpret_cast<NodePos*>(words + layout.data_parents));
+  std::copy(
+      ctrl_parent_index.begin(),
+      ctrl_parent_index.end(),
+      reinterpret_cast<uint32_t*>(words + layout.ctrl_parent_index));
+  std::copy(
+      ctrl_parents.begin(),
+      ctrl_parents.end(),
+      reinterpret_cast<NodePos*>(words + layout.ctrl_parents));
+
+  // the topology hash covers everything that does not depend on the rank
+  auto hash = fnv1a(
+      14695981039346656037ull, rel_ids.data(), rel_ids.size() * sizeof(uint64_t));
+  hash = fnv1a(
+      hash,
+      data_parent_index.data(),
+      data_parent_index.size() * sizeof(uint32_t));
+  hash = fnv1a(hash, data_parents.data(), data_parents.size() * sizeof(NodePos));
+  hash = fnv1a(
+      hash,
+      ctrl_parent_index.data(),
+      ctrl_parent_index.size() * sizeof(uint32_t));
+  hash = fnv1a(hash, ctrl_parents.data(), ctrl_parents.size() * sizeof(NodePos));
+  header->topology_hash = hash;
+  return index;
+}
@@ -0,0 +1,234 @@
+#ifndef CHAKRA_FEEDER_V3_MAPPED_TRACE_H
+#define CHAKRA_FEEDER_V3_MAPPED_TRACE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+#include "common.h"
+
+namespace Chakra {
+namespace FeederV3 {
+
+class MappedTrace;
+
+/**
+ * @brief Read-only mapping of a whole file into memory.
+ */
+class MappedRegion {
+ public:
+  MappedRegion() = default;
+  ~MappedRegion();
+  MappedRegion(const MappedRegion&) = delete;
+  MappedRegion& operator=(const MappedRegion&) = delete;
+
+  // map the file read-only, false if it cannot be opened or mapped
+  bool map(const std::string& file_path);
+  void unmap();
+
+  const char* data() const {
+    return this->region_data;
+  }
+  size_t size() const {
+    return this->region_size;
+  }
+
+ private:
+  const char* region_data = nullptr;
+  size_t region_size = 0;
+};
+
+/**
+ * @brief Static dependancy edges of one layer in CSR form, indexed by node
+ * position (rank of the node id within its trace).
+ */
+struct DependancyGraph {
+  std::vector<uint32_t> parent_index;
+  std::vector<NodePos> parents;
+  std::vector<uint32_t> child_index;
+  std::vector<NodePos> children;
+
+  uint32_t in_degree(NodePos pos) const {
+    return this->parent_index[pos + 1] - this->parent_index[pos];
+  }
+};
+
+/**
+ * @brief Node ids and dependancy graphs of a trace, relative to its smallest
+ * node id. Traces with the same structure, e.g. the per-rank traces of one
+ * workload whose node ids only differ by a rank offset, share one instance.
+ */
+class TraceTopology {
+ public:
+  // node id minus the smallest node id, in ascending order
+  std::vector<uint64_t> rel_ids;
+  DependancyGraph data_deps;
+  DependancyGraph ctrl_deps;
+  // union of data and ctrl deps
+  DependancyGraph all_deps;
+  // rel_ids[pos] == pos for every node
+  bool dense_ids = false;
+
+  size_t node_count() const {
+    return this->rel_ids.size();
+  }
+
+  /**
+   * @brief Get the shared topology described by the given index sections,
+   * building it only if no live trace has the same structure.
+   */
+  static std::shared_ptr<const TraceTopology> intern(
+      uint64_t hash,
+      const uint64_t* rel_ids,
+      size_t node_count,
+      const uint32_t* data_parent_index,
+      const NodePos* data_parents,
+      const uint32_t* ctrl_parent_index,
+      const NodePos* ctrl_parents);
+
+ private:
+  uint64_t hash = 0;
+  bool same_as(
+      const uint64_t* rel_ids,
+      size_t node_count,
+      const uint32_t* data_parent_index,
+      const NodePos* data_parents,
+      const uint32_t* ctrl_parent_index,
+      const NodePos* ctrl_parents) const;
+};
+
+/**
+ * @brief Node ids of a set of node positions, iterated without
+ * materializing them.
+ */
+class NodeIdRange {
+ public:
+  class const_iterator {
+   public:
+    const_iterator(const NodePos* pos, const MappedTrace* trace)
+        : pos(pos), trace(trace) {}
+    NodeId operator*() const;
+    const_iterator& operator++() {
+      ++this->pos;
+      return *this;
+    }
+    bool operator==(const const_iterator& other) const {
+      return this->pos == other.pos;
+    }
+    bool operator!=(const const_iterator& other) const {
+      return this->pos != other.pos;
+    }
+
+   private:
+    const NodePos* pos;
+    const MappedTrace* trace;
+  };
+
+  NodeIdRange(const NodePos* first, const NodePos* last, const MappedTrace* trace)
+      : first(first), last(last), trace(trace) {}
+
+  const_iterator begin() const {
+    return const_iterator(this->first, this->trace);
+  }
+  const_iterator end() const {
+    return const_iterator(this->last, this->trace);
+  }
+  size_t size() const {
+    return static_cast<size_t>(this->last - this->first);
+  }
+  bool empty() const {
+    return this->first == this->last;
+  }
+  const_iterator find(NodeId node_id) const;
+  size_t count(NodeId node_id) const {
+    return this->find(node_id) != this->end() ? 1 : 0;
+  }
+
+ private:
+  const NodePos* first;
+  const NodePos* last;
+  const MappedTrace* trace;
+};
+
+/**
+ * @brief A Chakra execution trace mapped into memory, together with its node
+ * index.
+ *
+ * The index is kept in a binary sidecar file (<trace>.idx) next to the
+ * trace. It is built by scanning the trace once, without decoding node
+ * attributes, and is reused by later runs as long as the size and
+ * modification time of the trace match. Nodes are decoded lazily, straight
+ * from the mapped bytes.
+ *
+ * Opening the same file again returns the already mapped instance, and
+ * traces with the same structure share their TraceTopology.
+ */
+class MappedTrace {
+ public:
+  static std::shared_ptr<const MappedTrace> open(const std::string& file_path);
+
+  MappedTrace(const MappedTrace&) = delete;
+  MappedTrace& operator=(const MappedTrace&) = delete;
+
+  // unique id of this mapping within the process
+  uint64_t trace_id() const {
+    return this->_trace_id;
+  }
+  const std::string& file_path() const {
+    return this->_file_path;
+  }
+  size_t node_count() const {
+    return this->topology->node_count();
+  }
+  NodeId node_id(NodePos pos) const {
+    return this->id_base + this->topology->rel_ids[pos];
+  }
+  bool find_node(NodeId node_id, NodePos& pos) const;
+
+  const TraceTopology& get_topology() const {
+    return *this->topology;
+  }
+  NodeIdRange node_ids(const NodePos* first, const NodePos* last) const {
+    return NodeIdRange(first, last, this);
+  }
+
+  // serialized bytes of the node, pointing into the mapped trace
+  std::pair<const char*, size_t> node_bytes(NodePos pos) const;
+  void parse_node(NodePos pos, ChakraNode& node) const;
+  void parse_global_metadata(ChakraGlobalMetadata& metadata) const;
+
+ private:
+  MappedTrace() = default;
+
+  void load_index();
+  bool attach_index(const char* data, size_t size);
+  std::vector<uint64_t> build_index() const;
+
+  static uint64_t _trace_id_cnt;
+  uint64_t _trace_id = 0;
+  std::string _file_path;
+  int64_t trace_mtime_ns = 0;
+
+  MappedRegion trace_region;
+  // sidecar mapping, or the in-memory index if the sidecar cannot be written
+  MappedRegion index_region;
+  std::vector<uint64_t> index_buffer;
+
+  uint64_t id_base = 0;
+  uint64_t metadata_offset = 0;
+  uint64_t metadata_size = 0;
+  const uint64_t* node_offsets = nullptr;
+  const uint32_t* node_sizes = nullptr;
+  std::shared_ptr<const TraceTopology> topology;
+};
+
+inline NodeId NodeIdRange::const_iterator::operator*() const {
+  return this->trace->node_id(*this->pos);
+}
+
+} // namespace FeederV3
+} // namespace Chakra
+
+#endif
@@ -117,7 +117,7 @@ TEST_F(ETFeederTest, NodeGetChildrenTest) {
   SetUp(kTestFile);
   auto& dep_resolver = trace->getDependancyResolver();
   ASSERT_TRUE(dep_resolver.get_dependancy_free_nodes().find(216) != dep_resolver.get_dependancy_free_nodes().end());
-  auto& children = dep_resolver.get_enabled_dependancy().get_children(216);
+  const auto& children = dep_resolver.get_enabled_dependancy().get_children(216);
   ASSERT_TRUE(children.find(217) != children.end());
   ASSERT_TRUE(children.find(435) != children.end());
 }
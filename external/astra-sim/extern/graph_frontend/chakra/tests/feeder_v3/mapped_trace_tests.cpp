@@ -0,0 +1,161 @@
+#include <gtest/gtest.h>
+#include <unistd.h>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "et_feeder.h"
+#include "mapped_trace.h"
+#include "protobuf_util.h"
+
+using Chakra::FeederV3::ChakraGlobalMetadata;
+using Chakra::FeederV3::ChakraNode;
+using Chakra::FeederV3::ETFeeder;
+using Chakra::FeederV3::MappedTrace;
+using Chakra::FeederV3::NodeId;
+using Chakra::FeederV3::NodePos;
+using Chakra::FeederV3::ProtobufUtils;
+
+class MappedTraceTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    dir = std::filesystem::temp_directory_path() /
+        ("mapped_trace_tests." + std::to_string(getpid()));
+    std::filesystem::create_directories(dir);
+  }
+
+  void TearDown() override {
+    std::filesystem::remove_all(dir);
+  }
+
+  // diamond 0 -> {1, 2} -> 3 by data deps, plus 1 -> 2 by ctrl deps, with
+  // node ids offset by base and written out of order
+  std::string write_trace(const std::string& name, NodeId base) {
+    const auto path = (dir / name).string();
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    ChakraGlobalMetadata metadata;
+    metadata.set_version("test");
+    ProtobufUtils::writeMessage(file, metadata);
+    const std::vector<std::vector<NodeId>> data_deps = {{}, {0}, {0}, {1, 2}};
+    for (const NodeId rel_id : {3, 1, 0, 2}) {
+      ChakraNode node;
+      node.set_id(base + rel_id);
+      node.set_name("node_" + std::to_string(rel_id));
+      node.set_type(ChakraProtoMsg::COMP_NODE);
+      for (const auto parent : data_deps[rel_id])
+        node.add_data_deps(base + parent);
+      if (rel_id == 2)
+        node.add_ctrl_deps(base + 1);
+      auto* attr = node.add_attr();
+      attr->set_name("num_ops");
+      attr->set_int64_val(100 + rel_id);
+      ProtobufUtils::writeMessage(file, node);
+    }
+    return path;
+  }
+
+  std::filesystem::path dir;
+};
+
+TEST_F(MappedTraceTest, IndexSidecarTest) {
+  const auto path = write_trace("trace.0.et", 10);
+  ETFeeder feeder(path);
+  ASSERT_TRUE(std::filesystem::exists(path + ".idx"));
+  ASSERT_EQ(feeder.global_metadata.version(), "test");
+
+  const auto node = feeder.lookupNode(12);
+  ASSERT_EQ(node->id(), 12);
+  ASSERT_EQ(node->name(), "node_2");
+  ASSERT_EQ(node->num_ops(), 102);
+
+  // the sidecar is reused, not rewritten
+  const auto index_time = std::filesystem::last_write_time(path + ".idx");
+  ETFeeder reopened(path);
+  ASSERT_EQ(std::filesystem::last_write_time(path + ".idx"), index_time);
+  ASSERT_EQ(reopened.lookupNode(13)->name(), "node_3");
+}
+
+TEST_F(MappedTraceTest, StaleSidecarTest) {
+  const auto path = write_trace("trace.0.et", 0);
+  { ETFeeder feeder(path); }
+
+  // a different trace under the same name must not use the old index
+  write_trace("trace.0.et", 1000);
+  ETFeeder feeder(path);
+  const auto& free_nodes =
+      feeder.getDependancyResolver().get_dependancy_free_nodes();
+  ASSERT_EQ(free_nodes.size(), 1);
+  ASSERT_TRUE(free_nodes.find(1000) != free_nodes.end());
+  ASSERT_EQ(feeder.lookupNode(1003)->name(), "node_3");
+}
+
+TEST_F(MappedTraceTest, ResolveDependancyTest) {
+  ETFeeder feeder(write_trace("trace.0.et", 0));
+  auto& dep_resolver = feeder.getDependancyResolver();
+  const auto& free_nodes = dep_resolver.get_dependancy_free_nodes();
+  ASSERT_EQ(free_nodes.size(), 1);
+
+  const auto& children = dep_resolver.get_enabled_dependancy().get_children(0);
+  ASSERT_EQ(children.size(), 2);
+  ASSERT_TRUE(children.find(1) != children.end());
+  ASSERT_TRUE(children.find(2) != children.end());
+  const auto& parents = dep_resolver.get_enabled_dependancy().get_parents(2);
+  ASSERT_EQ(parents.size(), 2);
+  ASSERT_TRUE(parents.find(1) != parents.end());
+
+  auto node = feeder.getNextIssuableNode();
+  ASSERT_EQ(node->id(), 0);
+  feeder.freeChildrenNodes(0);
+  // node 2 also waits for node 1 through its ctrl dep
+  ASSERT_EQ(free_nodes.size(), 1);
+  ASSERT_TRUE(free_nodes.find(1) != free_nodes.end());
+
+  node = feeder.getNextIssuableNode();
+  feeder.pushBackIssuableNode(1);
+  ASSERT_TRUE(free_nodes.find(1) != free_nodes.end());
+  node = feeder.getNextIssuableNode();
+  feeder.freeChildrenNodes(1);
+  ASSERT_TRUE(free_nodes.find(2) != free_nodes.end());
+
+  node = feeder.getNextIssuableNode();
+  feeder.freeChildrenNodes(2);
+  node = feeder.getNextIssuableNode();
+  ASSERT_EQ(node->id(), 3);
+  feeder.freeChildrenNodes(3);
+  ASSERT_FALSE(feeder.hasNodesToIssue());
+  ASSERT_TRUE(dep_resolver.get_ongoing_nodes().empty());
+}
+
+TEST_F(MappedTraceTest, SharedTraceTest) {
+  const auto path = write_trace("trace.0.et", 0);
+  const auto trace = MappedTrace::open(path);
+  ASSERT_EQ(MappedTrace::open(path), trace);
+
+  // another rank of the same workload shares the dependancy graph
+  const auto rank_trace = MappedTrace::open(write_trace("trace.1.et", 4));
+  ASSERT_NE(rank_trace, trace);
+  ASSERT_EQ(&rank_trace->get_topology(), &trace->get_topology());
+
+  NodePos pos;
+  ASSERT_TRUE(rank_trace->find_node(6, pos));
+  ASSERT_EQ(rank_trace->node_id(pos), 6);
+  ASSERT_FALSE(rank_trace->find_node(3, pos));
+  ChakraNode node;
+  rank_trace->parse_node(pos, node);
+  ASSERT_EQ(node.name(), "node_2");
+  ASSERT_EQ(node.id(), 6);
+}
+
+TEST_F(MappedTraceTest, DanglingDependancyTest) {
+  const auto path = (dir / "dangling.0.et").string();
+  {
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    ChakraGlobalMetadata metadata;
+    ProtobufUtils::writeMessage(file, metadata);
+    ChakraNode node;
+    node.set_id(1);
+    node.add_data_deps(7);
+    ProtobufUtils::writeMessage(file, node);
+  }
+  ASSERT_THROW(ETFeeder feeder(path), std::runtime_error);
+}
@@ -0,0 +1,152 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include "common/EventQueue.h"
+#include "common/NetworkParser.h"
+#include "common/Type.h"
+#include "congestion_aware/Chunk.h"
+#include "congestion_aware/Helper.h"
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace NetworkAnalytical;
+using namespace NetworkAnalyticalCongestionAware;
+
+namespace {
+
+/// chunks of a (src, dest) pair, sent one after another
+struct Stream {
+    /// topology to send the chunks over
+    Topology* topology;
+
+    /// source NPU
+    DeviceId src;
+
+    /// destination NPU
+    DeviceId dest;
+
+    /// chunks left to send
+    int remaining_chunks;
+
+    /// size of each chunk
+    ChunkSize chunk_size;
+};
+
+/**
+ * Send the next chunk of the stream, if any.
+ * Invoked when the previous chunk of the stream arrives (as a collective algorithm issues its next step),
+ * so chunks are continuously created and destroyed during the simulation.
+ */
+void send_next_chunk(void* const stream_ptr) {
+    auto* const stream = static_cast<Stream*>(stream_ptr);
+    if (stream->remaining_chunks == 0) {
+        return;
+    }
+    stream->remaining_chunks--;
+
+    auto route = stream->topology->link_route(stream->src, stream->dest, stream->remaining_chunks);
+    auto chunk = std::make_unique<Chunk>(stream->chunk_size, stream->src, std::move(route), send_next_chunk, stream);
+    stream->topology->send(std::move(chunk));
+}
+
+void print_usage(const char* const argv0) {
+    std::cerr << "Usage: " << argv0 << " [options]\n"
+              << "  --network PATH        network configuration (default: ../../input/Mesh2D.yml)\n"
+              << "  --chunks N            chunks sent by each NPU to every other NPU (default: 16)\n"
+              << "  --chunk-size BYTES    size of each chunk (default: 65536)\n"
+              << "  --repeat N            number of simulations to average (default: 3)" << std::endl;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    auto network_path = std::string("../../input/Mesh2D.yml");
+    auto chunks_count = 16;
+    auto chunk_size = ChunkSize{65'536};
+    auto repeat = 3;
+
+    // parse arguments
+    for (auto i = 1; i < argc; i++) {
+        const auto option = std::string(argv[i]);
+        if (i + 1 >= argc) {
+            print_usage(argv[0]);
+            return -1;
+        }
+        const auto value = std::string(argv[++i]);
+
+        if (option == "--network") {
+            network_path = value;
+        } else if (option == "--chunks") {
+            chunks_count = std::stoi(value);
+        } else if (option == "--chunk-size") {
+            chunk_size = std::stoull(value);
+        } else if (option == "--repeat") {
+            repeat = std::stoi(value);
+        } else {
+            print_usage(argv[0]);
+            return -1;
+        }
+    }
+    if (chunks_count <= 0 || repeat <= 0) {
+        print_usage(argv[0]);
+        return -1;
+    }
+
+    const auto network_parser = NetworkParser(network_path);
+    auto events_count = uint64_t{0};
+    auto finish_time = EventTime{0};
+    auto total_seconds = 0.0;
+
+    for (auto run = 0; run < repeat; run++) {
+        const auto event_queue = std::make_shared<EventQueue>();
+        Topology::set_event_queue(event_queue);
+        const auto topology = construct_topology(network_parser);
+        const auto npus_count = topology->get_npus_count();
+
+        const auto start = std::chrono::steady_clock::now();
+
+        // every NPU starts a stream to every other NPU at time 0
+        auto streams = std::vector<Stream>();
+        streams.reserve(static_cast<size_t>(npus_count) * (npus_count - 1));
+        for (auto src = 0; src < npus_count; src++) {
+            for (auto dest = 0; dest < npus_count; dest++) {
+                if (src != dest) {
+                    streams.push_back({topology.get(), src, dest, chunks_count, chunk_size});
+                }
+            }
+        }
+        for (auto& stream : streams) {
+            send_next_chunk(&stream);
+        }
+
+        // run simulation
+        while (!event_queue->finished()) {
+            event_queue->proceed();
+        }
+
+        const auto end = std::chrono::steady_clock::now();
+        total_seconds += std::chrono::duration<double>(end - start).count();
+        events_count = event_queue->get_invoked_events_count();
+        finish_time = event_queue->get_current_time();
+
+        if (run == 0) {
+            std::cout << "Network: " << network_path << ", " << npus_count << " NPUs, all-to-all of " << chunks_count
+                      << " chunks of " << chunk_size << " B per NPU pair" << std::endl;
+        }
+    }
+
+    // every simulation invokes the same events
+    const auto seconds = total_seconds / repeat;
+    std::cout << std::fixed << std::setprecision(3) << events_count << " events in " << seconds << " s ("
+              << std::setprecision(2) << static_cast<double>(events_count) / seconds / 1e6
+              << " M events/s), finish time " << finish_time << " ns" << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,271 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include "common/EventQueue.h"
+#include "common/EventTraceRecorder.h"
+#include "common/Type.h"
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace NetworkAnalytical;
+
+namespace {
+
+/**
+ * Replays a recorded schedule trace:
+ * every event, when invoked, schedules the events it scheduled during the recorded run.
+ */
+struct TraceReplay {
+    /// recorded schedule_event() calls
+    std::vector<EventTraceRecorder::Record> records;
+
+    /// children of event i are children[children_offsets[i], children_offsets[i + 1])
+    std::vector<uint64_t> children_offsets;
+
+    /// event ids, grouped by parent
+    std::vector<uint64_t> children;
+
+    /// events scheduled outside any event, in recorded order
+    std::vector<uint64_t> roots;
+
+    /// event queue being benchmarked
+    EventQueue* event_queue = nullptr;
+
+    /// number of invoked events
+    uint64_t invoked_count = 0;
+
+    /// order-sensitive checksum of invoked events
+    uint64_t checksum = 0;
+};
+
+/// replay state shared with the replay callback
+TraceReplay* replay = nullptr;
+
+void replay_event(void* const event_id_ptr) {
+    const auto event_id = reinterpret_cast<uintptr_t>(event_id_ptr);
+
+    replay->invoked_count++;
+    replay->checksum = replay->checksum * 1'000'003 + event_id;
+
+    // schedule the events this event scheduled in the recorded run
+    const auto begin = replay->children_offsets[event_id];
+    const auto end = replay->children_offsets[event_id + 1];
+    for (auto i = begin; i < end; i++) {
+        const auto child = replay->children[i];
+        const auto event_time = replay->records[child].event_time;
+        replay->event_queue->schedule_event(event_time, replay_event, reinterpret_cast<void*>(child));
+    }
+}
+
+TraceReplay build_replay(std::vector<EventTraceRecorder::Record> records) {
+    auto trace_replay = TraceReplay();
+    const auto records_count = records.size();
+
+    // count children per event
+    trace_replay.children_offsets = std::vector<uint64_t>(records_count + 1, 0);
+    for (auto i = uint64_t{0}; i < records_count; i++) {
+        const auto parent = records[i].parent;
+        if (parent < 0) {
+            trace_replay.roots.push_back(i);
+        } else {
+            trace_replay.children_offsets[parent + 1]++;
+        }
+    }
+    for (auto i = uint64_t{0}; i < records_count; i++) {
+        trace_replay.children_offsets[i + 1] += trace_replay.children_offsets[i];
+    }
+
+    // place children, preserving the recorded order
+    trace_replay.children = std::vector<uint64_t>(trace_replay.children_offsets.back());
+    auto cursor = std::vector<uint64_t>(trace_replay.children_offsets.begin(), trace_replay.children_offsets.end() - 1);
+    for (auto i = uint64_t{0}; i < records_count; i++) {
+        const auto parent = records[i].parent;
+        if (parent >= 0) {
+            trace_replay.children[cursor[parent]] = i;
+            cursor[parent]++;
+        }
+    }
+
+    trace_replay.records = std::move(records);
+    return trace_replay;
+}
+
+/**
+ * Generate a synthetic trace following the classic hold model:
+ * a fixed population of pending events, where each invoked event schedules one successor
+ * after an exponentially distributed delay until the event budget is exhausted.
+ */
+std::vector<EventTraceRecorder::Record> generate_hold_trace(const uint64_t events_count,
+                                                            const uint64_t population,
+                                                            const double mean_delay) {
+    auto records = std::vector<EventTraceRecorder::Record>();
+    records.reserve(events_count);
+
+    auto random_engine = std::mt19937_64(42);
+    auto delay_distribution = std::exponential_distribution<double>(1.0 / mean_delay);
+    const auto next_delay = [&]() { return static_cast<EventTime>(delay_distribution(random_engine)) + 1; };
+
+    // generate the initial population
+    for (auto i = uint64_t{0}; i < population && records.size() < events_count; i++) {
+        records.push_back({next_delay(), -1, 0});
+    }
+
+    // each event schedules exactly one successor, in event-id order
+    for (auto parent = uint64_t{0}; records.size() < events_count; parent++) {
+        const auto event_time = records[parent].event_time + next_delay();
+        records.push_back({event_time, static_cast<int64_t>(parent), 0});
+    }
+
+    return records;
+}
+
+struct BenchmarkResult {
+    uint64_t invoked_count;
+    uint64_t checksum;
+    EventTime finish_time;
+    double seconds;
+};
+
+BenchmarkResult run_replay(TraceReplay& trace_replay, const EventSchedulerType scheduler_type) {
+    auto event_queue = EventQueue(scheduler_type);
+    trace_replay.event_queue = &event_queue;
+    trace_replay.invoked_count = 0;
+    trace_replay.checksum = 0;
+    replay = &trace_replay;
+
+    const auto& roots = trace_replay.roots;
+    auto root_cursor = size_t{0};
+    auto epoch = uint64_t{0};
+    const auto schedule_roots = [&]() {
+        while (root_cursor < roots.size() && trace_replay.records[roots[root_cursor]].epoch <= epoch) {
+            const auto root = roots[root_cursor];
+            event_queue.schedule_event(trace_replay.records[root].event_time, replay_event,
+                                       reinterpret_cast<void*>(root));
+            root_cursor++;
+        }
+    };
+
+    const auto start = std::chrono::steady_clock::now();
+
+    // replay the recorded run step by step
+    schedule_roots();
+    while (!event_queue.finished() || root_cursor < roots.size()) {
+        if (event_queue.finished()) {
+            // nothing pending: jump to the epoch of the next root
+            epoch = trace_replay.records[roots[root_cursor]].epoch;
+            schedule_roots();
+            continue;
+        }
+
+        event_queue.proceed();
+        epoch++;
+        schedule_roots();
+    }
+
+    const auto end = std::chrono::steady_clock::now();
+    const auto seconds = std::chrono::duration<double>(end - start).count();
+
+    return {trace_replay.invoked_count, trace_replay.checksum, event_queue.get_current_time(), seconds};
+}
+
+void print_usage(const char* const argv0) {
+    std::cerr << "Usage: " << argv0 << " [options]\n"
+              << "  --trace PATH          replay a trace recorded by EventQueue::record_trace()\n"
+              << "  --events N            synthetic hold-model events (default: 1000000)\n"
+              << "  --population N        synthetic pending population (default: 10000)\n"
+              << "  --mean-delay NS       synthetic mean event delay (default: 1000)\n"
+              << "  --scheduler NAME      linear, heap, calendar, or all (default: heap,calendar)" << std::endl;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    auto trace_path = std::string();
+    auto events_count = uint64_t{1'000'000};
+    auto population = uint64_t{10'000};
+    auto mean_delay = 1000.0;
+    auto scheduler_name = std::string();
+
+    // parse arguments
+    for (auto i = 1; i < argc; i++) {
+        const auto option = std::string(argv[i]);
+        if (i + 1 >= argc) {
+            print_usage(argv[0]);
+            return -1;
+        }
+        const auto value = std::string(argv[++i]);
+
+        if (option == "--trace") {
+            trace_path = value;
+        } else if (option == "--events") {
+            events_count = std::stoull(value);
+        } else if (option == "--population") {
+            population = std::stoull(value);
+        } else if (option == "--mean-delay") {
+            mean_delay = std::stod(value);
+        } else if (option == "--scheduler") {
+            scheduler_name = value;
+        } else {
+            print_usage(argv[0]);
+            return -1;
+        }
+    }
+
+    // select schedulers
+    auto schedulers = std::vector<std::pair<std::string, EventSchedulerType>>();
+    if (scheduler_name == "linear" || scheduler_name == "all") {
+        schedulers.emplace_back("linear", EventSchedulerType::Linear);
+    }
+    if (scheduler_name.empty() || scheduler_name == "heap" || scheduler_name == "all") {
+        schedulers.emplace_back("heap", EventSchedulerType::Heap);
+    }
+    if (scheduler_name.empty() || scheduler_name == "calendar" || scheduler_name == "all") {
+        schedulers.emplace_back("calendar", EventSchedulerType::Calendar);
+    }
+    if (schedulers.empty()) {
+        print_usage(argv[0]);
+        return -1;
+    }
+
+    // load or generate the trace
+    auto records = trace_path.empty() ? generate_hold_trace(events_count, population, mean_delay)
+                                      : EventTraceRecorder::load(trace_path);
+    auto trace_replay = build_replay(std::move(records));
+    std::cout << "Trace: " << (trace_path.empty() ? "synthetic hold model" : trace_path) << ", "
+              << trace_replay.records.size() << " events" << std::endl;
+
+    // run benchmarks
+    auto reference_checksum = uint64_t{0};
+    auto mismatch = false;
+    for (auto i = size_t{0}; i < schedulers.size(); i++) {
+        const auto& [name, scheduler_type] = schedulers[i];
+        const auto result = run_replay(trace_replay, scheduler_type);
+        const auto events_per_second = static_cast<double>(result.invoked_count) / result.seconds;
+
+        std::cout << std::left << std::setw(10) << name << std::right << std::fixed << std::setprecision(3)
+                  << std::setw(10) << result.seconds << " s  " << std::setprecision(0) << std::setw(12)
+                  << events_per_second << " events/s  finish time " << result.finish_time << " ns" << std::endl;
+
+        // all schedulers must invoke events in the identical order
+        if (i == 0) {
+            reference_checksum = result.checksum;
+        } else if (result.checksum != reference_checksum) {
+            mismatch = true;
+        }
+    }
+
+    if (mismatch) {
+        std::cerr << "[Error] (network/analytical) event order differs across schedulers" << std::endl;
+        return -1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,203 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include "common/EventQueue.h"
+#include "common/NetworkParser.h"
+#include "common/Type.h"
+#include "congestion_aware/Chunk.h"
+#include "congestion_aware/Helper.h"
+#include "flow/FlowNetwork.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace NetworkAnalytical;
+using namespace NetworkAnalyticalCongestionAware;
+using namespace NetworkAnalyticalFlow;
+
+namespace {
+
+/// a message of the synthetic traffic
+struct Message {
+    /// source NPU
+    DeviceId src;
+
+    /// destination NPU
+    DeviceId dest;
+};
+
+/// arrival record of a message, filled by the callback
+struct Arrival {
+    /// event queue to read the arrival time from
+    EventQueue* event_queue;
+
+    /// arrival time of the message
+    EventTime time;
+};
+
+void record_arrival(void* const arrival_ptr) {
+    auto* const arrival = static_cast<Arrival*>(arrival_ptr);
+    arrival->time = arrival->event_queue->get_current_time();
+}
+
+/**
+ * Generate broadcasts: the sources, spread evenly over the NPUs,
+ * each send a message to every other NPU.
+ */
+std::vector<Message> generate_broadcasts(const int npus_count, const int sources_count) {
+    auto messages = std::vector<Message>();
+    const auto stride = std::max(1, npus_count / sources_count);
+    for (auto i = 0; i < sources_count; i++) {
+        const auto src = (i * stride) % npus_count;
+        for (auto dest = 0; dest < npus_count; dest++) {
+            if (dest != src) {
+                messages.push_back({src, dest});
+            }
+        }
+    }
+    return messages;
+}
+
+struct BenchmarkResult {
+    EventTime finish_time;
+    double mean_arrival_time;
+    uint64_t events_count;
+    double seconds;
+};
+
+BenchmarkResult summarize(const EventQueue& event_queue,
+                          const std::vector<Arrival>& arrivals,
+                          const std::chrono::steady_clock::time_point start) {
+    const auto seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    auto arrival_times_sum = 0.0;
+    for (const auto& arrival : arrivals) {
+        arrival_times_sum += static_cast<double>(arrival.time);
+    }
+    const auto mean_arrival_time = arrival_times_sum / static_cast<double>(arrivals.size());
+
+    return {event_queue.get_current_time(), mean_arrival_time, event_queue.get_invoked_events_count(), seconds};
+}
+
+/**
+ * Simulate the messages as store-and-forward chunks.
+ */
+BenchmarkResult run_chunks(const NetworkParser& network_parser,
+                           const std::vector<Message>& messages,
+                           const ChunkSize message_size) {
+    const auto event_queue = std::make_shared<EventQueue>();
+    Topology::set_event_queue(event_queue);
+    const auto topology = construct_topology(network_parser);
+
+    const auto start = std::chrono::steady_clock::now();
+    auto arrivals = std::vector<Arrival>(messages.size(), Arrival{event_queue.get(), 0});
+    for (auto i = size_t{0}; i < messages.size(); i++) {
+        auto route = topology->link_route(messages[i].src, messages[i].dest, i);
+        auto chunk = std::make_unique<Chunk>(message_size, messages[i].src, std::move(route), record_arrival,
+                                             &arrivals[i]);
+        topology->send(std::move(chunk));
+    }
+
+    while (!event_queue->finished()) {
+        event_queue->proceed();
+    }
+
+    return summarize(*event_queue, arrivals, start);
+}
+
+/**
+ * Simulate the messages as flows.
+ */
+BenchmarkResult run_flows(const NetworkParser& network_parser,
+                          const std::vector<Message>& messages,
+                          const ChunkSize message_size) {
+    const auto event_queue = std::make_shared<EventQueue>();
+    Topology::set_event_queue(event_queue);
+    const auto topology = construct_topology(network_parser);
+    auto flow_network = FlowNetwork(topology, event_queue);
+
+    const auto start = std::chrono::steady_clock::now();
+    auto arrivals = std::vector<Arrival>(messages.size(), Arrival{event_queue.get(), 0});
+    for (auto i = size_t{0}; i < messages.size(); i++) {
+        flow_network.send(messages[i].src, messages[i].dest, message_size, record_arrival, &arrivals[i], i);
+    }
+
+    while (!event_queue->finished()) {
+        event_queue->proceed();
+    }
+
+    const auto result = summarize(*event_queue, arrivals, start);
+    std::cout << "(flow rate updates: " << flow_network.get_rate_updates_count() << ")" << std::endl;
+    return result;
+}
+
+void print_result(const std::string& name, const BenchmarkResult& result) {
+    std::cout << std::left << std::setw(7) << name << std::right << std::fixed << std::setprecision(3)
+              << std::setw(9) << result.seconds << " s  " << std::setw(10) << result.events_count
+              << " events  finish time " << result.finish_time << " ns  mean arrival " << std::setprecision(1)
+              << result.mean_arrival_time << " ns" << std::endl;
+}
+
+void print_usage(const char* const argv0) {
+    std::cerr << "Usage: " << argv0 << " [options]\n"
+              << "  --network PATH        network configuration (default: ../../input/Mesh2D_64x64.yml)\n"
+              << "  --sources N           number of NPUs broadcasting (default: 4)\n"
+              << "  --size BYTES          size of each message (default: 8388608)" << std::endl;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    auto network_path = std::string("../../input/Mesh2D_64x64.yml");
+    auto sources_count = 4;
+    auto message_size = ChunkSize{8'388'608};
+
+    // parse arguments
+    for (auto i = 1; i < argc; i++) {
+        const auto option = std::string(argv[i]);
+        if (i + 1 >= argc) {
+            print_usage(argv[0]);
+            return -1;
+        }
+        const auto value = std::string(argv[++i]);
+
+        if (option == "--network") {
+            network_path = value;
+        } else if (option == "--sources") {
+            sources_count = std::stoi(value);
+        } else if (option == "--size") {
+            message_size = std::stoull(value);
+        } else {
+            print_usage(argv[0]);
+            return -1;
+        }
+    }
+
+    if (sources_count <= 0 || message_size == 0) {
+        print_usage(argv[0]);
+        return -1;
+    }
+
+    // generate traffic
+    const auto network_parser = NetworkParser(network_path);
+    auto npus_count = 1;
+    for (const auto npus_count_of_dim : network_parser.get_npus_counts_per_dim()) {
+        npus_count *= npus_count_of_dim;
+    }
+    const auto messages = generate_broadcasts(npus_count, std::min(sources_count, npus_count));
+    std::cout << "Network: " << network_path << ", " << npus_count << " NPUs, " << messages.size()
+              << " messages of " << message_size << " B" << std::endl;
+
+    // same traffic as chunks and as flows
+    print_result("chunk", run_chunks(network_parser, messages, message_size));
+    print_result("flow", run_flows(network_parser, messages, message_size));
+
+    return 0;
+}
@@ -0,0 +1,216 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include "common/EventQueue.h"
+#include "common/NetworkParser.h"
+#include "common/Type.h"
+#include "congestion_aware/Chunk.h"
+#include "congestion_aware/Helper.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace NetworkAnalytical;
+using namespace NetworkAnalyticalCongestionAware;
+
+namespace {
+
+/// a broadcast of the synthetic traffic
+struct Broadcast {
+    /// source NPU
+    DeviceId src;
+
+    /// destination NPUs
+    std::vector<DeviceId> dests;
+};
+
+/// arrival record of a message at one destination, filled by the chunk callback
+struct Arrival {
+    /// event queue to read the arrival time from
+    EventQueue* event_queue;
+
+    /// arrival time of the message
+    EventTime time;
+};
+
+void record_arrival(void* const arrival_ptr) {
+    auto* const arrival = static_cast<Arrival*>(arrival_ptr);
+    arrival->time = arrival->event_queue->get_current_time();
+}
+
+/**
+ * Generate broadcast traffic: every NPU broadcasts the given number of messages
+ * to uniformly chosen sets of other NPUs.
+ */
+std::vector<Broadcast> generate_traffic(const int npus_count, const int broadcasts_per_npu, const int fanout) {
+    auto broadcasts = std::vector<Broadcast>();
+    broadcasts.reserve(static_cast<size_t>(npus_count) * broadcasts_per_npu);
+
+    auto random_engine = std::mt19937_64(42);
+    auto others = std::vector<DeviceId>(npus_count - 1);
+    for (auto i = 0; i < broadcasts_per_npu; i++) {
+        for (auto src = 0; src < npus_count; src++) {
+            // every NPU except the source
+            std::iota(others.begin(), others.begin() + src, 0);
+            std::iota(others.begin() + src, others.end(), src + 1);
+            std::shuffle(others.begin(), others.end(), random_engine);
+
+            auto dests = std::vector<DeviceId>(others.begin(), others.begin() + fanout);
+            std::sort(dests.begin(), dests.end());
+            broadcasts.push_back({src, std::move(dests)});
+        }
+    }
+
+    return broadcasts;
+}
+
+struct BenchmarkResult {
+    uint64_t transmissions_count;
+    EventTime finish_time;
+    double mean_arrival_time;
+    double seconds;
+};
+
+/**
+ * Simulate the traffic, either as multicast trees or as unicast fan-out.
+ */
+BenchmarkResult run_traffic(const NetworkParser& network_parser,
+                            const std::vector<Broadcast>& broadcasts,
+                            const ChunkSize chunk_size,
+                            const bool multicast) {
+    const auto event_queue = std::make_shared<EventQueue>();
+    Topology::set_event_queue(event_queue);
+    const auto topology = construct_topology(network_parser);
+
+    auto messages_count = size_t{0};
+    for (const auto& broadcast : broadcasts) {
+        messages_count += broadcast.dests.size();
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+
+    // inject all broadcasts at time 0
+    auto transmissions_count = uint64_t{0};
+    auto arrivals = std::vector<Arrival>(messages_count, Arrival{event_queue.get(), 0});
+    auto arrival_index = size_t{0};
+    for (const auto& broadcast : broadcasts) {
+        if (multicast) {
+            // a single chunk replicated along the tree
+            const auto route = topology->multicast_route(broadcast.src, broadcast.dests);
+            auto callback_args = std::vector<CallbackArg>();
+            for (auto i = size_t{0}; i < broadcast.dests.size(); i++) {
+                callback_args.push_back(&arrivals[arrival_index++]);
+            }
+            transmissions_count += route->get_hops_count();
+
+            auto chunk = std::make_unique<Chunk>(chunk_size, route, record_arrival, std::move(callback_args));
+            topology->send(std::move(chunk));
+        } else {
+            // a chunk per destination
+            for (const auto dest : broadcast.dests) {
+                auto route = topology->route(broadcast.src, dest);
+                transmissions_count += route.size() - 1;
+
+                auto chunk = std::make_unique<Chunk>(chunk_size, route, record_arrival, &arrivals[arrival_index++]);
+                topology->send(std::move(chunk));
+            }
+        }
+    }
+
+    // run simulation
+    while (!event_queue->finished()) {
+        event_queue->proceed();
+    }
+
+    const auto end = std::chrono::steady_clock::now();
+    const auto seconds = std::chrono::duration<double>(end - start).count();
+
+    auto arrival_times_sum = 0.0;
+    for (const auto& arrival : arrivals) {
+        arrival_times_sum += static_cast<double>(arrival.time);
+    }
+    const auto mean_arrival_time = arrival_times_sum / static_cast<double>(arrivals.size());
+
+    return {transmissions_count, event_queue->get_current_time(), mean_arrival_time, seconds};
+}
+
+void print_result(const std::string& name, const BenchmarkResult& result) {
+    // every link transmission schedules a chunk arrival and a link-free event
+    std::cout << std::left << std::setw(10) << name << std::right << std::setw(12) << result.transmissions_count
+              << " transmissions " << std::setw(12) << 2 * result.transmissions_count << " events " << std::fixed
+              << std::setprecision(3) << std::setw(9) << result.seconds << " s  finish time " << result.finish_time
+              << " ns  mean arrival " << std::setprecision(1) << result.mean_arrival_time << " ns" << std::endl;
+}
+
+void print_usage(const char* const argv0) {
+    std::cerr << "Usage: " << argv0 << " [options]\n"
+              << "  --network PATH        network configuration (default: ../../input/Mesh2D_64x64.yml)\n"
+              << "  --broadcasts N        broadcasts per NPU (default: 1)\n"
+              << "  --fanout N            destinations per broadcast (default: 64)\n"
+              << "  --chunk-size BYTES    size of each message (default: 65536)" << std::endl;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    auto network_path = std::string("../../input/Mesh2D_64x64.yml");
+    auto broadcasts_per_npu = 1;
+    auto fanout = 64;
+    auto chunk_size = ChunkSize{65'536};
+
+    // parse arguments
+    for (auto i = 1; i < argc; i++) {
+        const auto option = std::string(argv[i]);
+        if (i + 1 >= argc) {
+            print_usage(argv[0]);
+            return -1;
+        }
+        const auto value = std::string(argv[++i]);
+
+        if (option == "--network") {
+            network_path = value;
+        } else if (option == "--broadcasts") {
+            broadcasts_per_npu = std::stoi(value);
+        } else if (option == "--fanout") {
+            fanout = std::stoi(value);
+        } else if (option == "--chunk-size") {
+            chunk_size = std::stoull(value);
+        } else {
+            print_usage(argv[0]);
+            return -1;
+        }
+    }
+
+    // generate traffic
+    const auto network_parser = NetworkParser(network_path);
+    const auto npus_count = construct_topology(network_parser)->get_npus_count();
+    if (fanout <= 0 || fanout >= npus_count) {
+        std::cerr << "[Error] (network/analytical) " << "fanout (" << fanout << ") should be in [1, " << npus_count - 1
+                  << "]" << std::endl;
+        return -1;
+    }
+    const auto broadcasts = generate_traffic(npus_count, broadcasts_per_npu, fanout);
+    std::cout << "Network: " << network_path << ", " << npus_count << " NPUs, " << broadcasts.size()
+              << " broadcasts to " << fanout << " NPUs of " << chunk_size << " B" << std::endl;
+
+    // unicast fan-out vs. multicast tree
+    const auto unicast = run_traffic(network_parser, broadcasts, chunk_size, false);
+    print_result("unicast", unicast);
+    const auto multicast = run_traffic(network_parser, broadcasts, chunk_size, true);
+    print_result("multicast", multicast);
+
+    std::cout << "event reduction " << std::setprecision(2)
+              << static_cast<double>(unicast.transmissions_count) / static_cast<double>(multicast.transmissions_count)
+              << "x, speedup " << unicast.seconds / multicast.seconds << "x" << std::endl;
+
+    return 0;
+}
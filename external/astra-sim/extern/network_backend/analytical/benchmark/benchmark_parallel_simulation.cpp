@@ -0,0 +1,216 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include "common/EventQueue.h"
+#include "common/NetworkParser.h"
+#include "common/Type.h"
+#include "congestion_aware/Chunk.h"
+#include "congestion_aware/Helper.h"
+#include "congestion_aware/ParallelSimulator.h"
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace NetworkAnalytical;
+using namespace NetworkAnalyticalCongestionAware;
+
+namespace {
+
+/// a message of the synthetic traffic
+struct Message {
+    /// source NPU
+    DeviceId src;
+
+    /// destination NPU
+    DeviceId dest;
+};
+
+/// arrival record of a message, filled by the chunk callback
+struct Arrival {
+    /// event queue to read the arrival time from
+    EventQueue* event_queue;
+
+    /// arrival time of the message
+    EventTime time;
+};
+
+void record_arrival(void* const arrival_ptr) {
+    auto* const arrival = static_cast<Arrival*>(arrival_ptr);
+    arrival->time = arrival->event_queue->get_current_time();
+}
+
+/**
+ * Generate uniform random traffic: every NPU sends the given number of messages
+ * to uniformly chosen other NPUs.
+ */
+std::vector<Message> generate_traffic(const int npus_count, const int messages_per_npu) {
+    auto messages = std::vector<Message>();
+    messages.reserve(static_cast<size_t>(npus_count) * messages_per_npu);
+
+    auto random_engine = std::mt19937_64(42);
+    auto dest_distribution = std::uniform_int_distribution<int>(0, npus_count - 2);
+    for (auto i = 0; i < messages_per_npu; i++) {
+        for (auto src = 0; src < npus_count; src++) {
+            // skip the source itself
+            auto dest = dest_distribution(random_engine);
+            if (dest >= src) {
+                dest++;
+            }
+            messages.push_back({src, dest});
+        }
+    }
+
+    return messages;
+}
+
+struct BenchmarkResult {
+    int regions_count;
+    uint64_t checksum;
+    EventTime finish_time;
+    double seconds;
+};
+
+/**
+ * Simulate the traffic, sequentially if threads_count is 0.
+ */
+BenchmarkResult run_traffic(const NetworkParser& network_parser,
+                            const std::vector<Message>& messages,
+                            const ChunkSize chunk_size,
+                            const int threads_count) {
+    const auto event_queue = std::make_shared<EventQueue>();
+    Topology::set_event_queue(event_queue);
+    const auto topology = construct_topology(network_parser);
+
+    auto simulator = std::unique_ptr<ParallelSimulator>();
+    if (threads_count > 0) {
+        simulator = std::make_unique<ParallelSimulator>(topology, event_queue, threads_count);
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+
+    // inject all messages at time 0
+    auto arrivals = std::vector<Arrival>(messages.size(), Arrival{event_queue.get(), 0});
+    for (auto i = size_t{0}; i < messages.size(); i++) {
+        auto route = topology->route(messages[i].src, messages[i].dest);
+        auto chunk = std::make_unique<Chunk>(chunk_size, route, record_arrival, &arrivals[i]);
+        topology->send(std::move(chunk));
+    }
+
+    // run simulation
+    if (simulator != nullptr) {
+        simulator->run();
+    } else {
+        while (!event_queue->finished()) {
+            event_queue->proceed();
+        }
+    }
+
+    const auto end = std::chrono::steady_clock::now();
+    const auto seconds = std::chrono::duration<double>(end - start).count();
+
+    // order-sensitive checksum of the arrival times
+    auto checksum = uint64_t{0};
+    for (const auto& arrival : arrivals) {
+        checksum = checksum * 1'000'003 + arrival.time;
+    }
+
+    const auto regions_count = (simulator != nullptr) ? simulator->get_regions_count() : 1;
+    return {regions_count, checksum, event_queue->get_current_time(), seconds};
+}
+
+std::vector<int> parse_threads_list(const std::string& threads_list) {
+    auto threads_counts = std::vector<int>();
+    auto stream = std::istringstream(threads_list);
+    auto token = std::string();
+    while (std::getline(stream, token, ',')) {
+        threads_counts.push_back(std::stoi(token));
+    }
+    return threads_counts;
+}
+
+void print_usage(const char* const argv0) {
+    std::cerr << "Usage: " << argv0 << " [options]\n"
+              << "  --network PATH        network configuration (default: ../../input/Mesh2D_64x64.yml)\n"
+              << "  --threads LIST        comma-separated thread counts (default: 1,2,4,8)\n"
+              << "  --messages N          random messages per NPU (default: 16)\n"
+              << "  --chunk-size BYTES    size of each message (default: 65536)" << std::endl;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    auto network_path = std::string("../../input/Mesh2D_64x64.yml");
+    auto threads_list = std::string("1,2,4,8");
+    auto messages_per_npu = 16;
+    auto chunk_size = ChunkSize{65'536};
+
+    // parse arguments
+    for (auto i = 1; i < argc; i++) {
+        const auto option = std::string(argv[i]);
+        if (i + 1 >= argc) {
+            print_usage(argv[0]);
+            return -1;
+        }
+        const auto value = std::string(argv[++i]);
+
+        if (option == "--network") {
+            network_path = value;
+        } else if (option == "--threads") {
+            threads_list = value;
+        } else if (option == "--messages") {
+            messages_per_npu = std::stoi(value);
+        } else if (option == "--chunk-size") {
+            chunk_size = std::stoull(value);
+        } else {
+            print_usage(argv[0]);
+            return -1;
+        }
+    }
+
+    // generate traffic
+    const auto network_parser = NetworkParser(network_path);
+    const auto npus_count = construct_topology(network_parser)->get_npus_count();
+    const auto messages = generate_traffic(npus_count, messages_per_npu);
+    std::cout << "Network: " << network_path << ", " << npus_count << " NPUs, " << messages.size()
+              << " messages of " << chunk_size << " B" << std::endl;
+
+    // sequential simulation as the baseline
+    const auto sequential = run_traffic(network_parser, messages, chunk_size, 0);
+    std::cout << std::left << std::setw(12) << "sequential" << std::right << std::setw(9) << 1 << " regions "
+              << std::fixed << std::setprecision(3) << std::setw(10) << sequential.seconds << " s  speedup "
+              << std::setprecision(2) << std::setw(6) << 1.0 << "  finish time " << sequential.finish_time << " ns"
+              << std::endl;
+
+    // parallel simulation per thread count
+    auto mismatch = false;
+    const auto threads_counts = parse_threads_list(threads_list);
+    for (auto i = size_t{0}; i < threads_counts.size(); i++) {
+        const auto result = run_traffic(network_parser, messages, chunk_size, threads_counts[i]);
+        const auto speedup = sequential.seconds / result.seconds;
+
+        std::cout << std::left << std::setw(12) << (std::to_string(threads_counts[i]) + " threads") << std::right
+                  << std::setw(9) << result.regions_count << " regions " << std::fixed << std::setprecision(3)
+                  << std::setw(10) << result.seconds << " s  speedup " << std::setprecision(2) << std::setw(6)
+                  << speedup << "  finish time " << result.finish_time << " ns" << std::endl;
+
+        // every thread count must deliver every message at the time of the sequential simulation
+        if (result.checksum != sequential.checksum) {
+            mismatch = true;
+        }
+    }
+
+    if (mismatch) {
+        std::cerr << "[Error] (network/analytical) arrival times differ from the sequential simulation" << std::endl;
+        return -1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,276 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include "common/EventQueue.h"
+#include "common/NetworkParser.h"
+#include "common/TopologyUtils.h"
+#include "common/Type.h"
+#include "congestion_aware/Chunk.h"
+#include "congestion_aware/Link.h"
+#include "congestion_aware/Mesh2D.h"
+#include "congestion_aware/Torus2D.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace NetworkAnalytical;
+using namespace NetworkAnalyticalCongestionAware;
+
+namespace {
+
+/// a message of the synthetic traffic
+struct Message {
+    /// source NPU
+    DeviceId src;
+
+    /// destination NPU
+    DeviceId dest;
+};
+
+/// arrival record of a message, filled by the chunk callback
+struct Arrival {
+    /// event queue to read the arrival time from
+    EventQueue* event_queue;
+
+    /// arrival time of the message
+    EventTime time;
+};
+
+void record_arrival(void* const arrival_ptr) {
+    auto* const arrival = static_cast<Arrival*>(arrival_ptr);
+    arrival->time = arrival->event_queue->get_current_time();
+}
+
+/**
+ * Generate the traffic:
+ *   - uniform: every NPU sends the given number of messages to uniformly chosen other NPUs
+ *   - row-broadcast: every NPU of the first row sends a message to every other NPU
+ */
+std::vector<Message> generate_traffic(const std::string& pattern,
+                                      const int npus_count,
+                                      const int cols,
+                                      const int messages_per_npu) {
+    auto messages = std::vector<Message>();
+
+    if (pattern == "row-broadcast") {
+        for (auto src = 0; src < cols; src++) {
+            for (auto dest = 0; dest < npus_count; dest++) {
+                if (dest != src) {
+                    messages.push_back({src, dest});
+                }
+            }
+        }
+        return messages;
+    }
+
+    auto random_engine = std::mt19937_64(42);
+    auto dest_distribution = std::uniform_int_distribution<int>(0, npus_count - 2);
+    for (auto i = 0; i < messages_per_npu; i++) {
+        for (auto src = 0; src < npus_count; src++) {
+            // skip the source itself
+            auto dest = dest_distribution(random_engine);
+            if (dest >= src) {
+                dest++;
+            }
+            messages.push_back({src, dest});
+        }
+    }
+    return messages;
+}
+
+/**
+ * Construct the 2D grid of the network configuration with the given routing policy.
+ */
+std::shared_ptr<Topology> construct_grid(const NetworkParser& network_parser, const RoutingPolicy routing_policy) {
+    const auto topology_type = network_parser.get_topologies_per_dim()[0];
+    const auto npus_count = network_parser.get_npus_counts_per_dim()[0];
+    const auto bandwidth = network_parser.get_bandwidths_per_dim()[0];
+    const auto latency = network_parser.get_latencies_per_dim()[0];
+    const auto params = network_parser.get_topology_params_per_dim()[0];
+
+    if (topology_type == TopologyBuildingBlock::Torus2D) {
+        const auto shape = parse_torus2d_shape(params, npus_count);
+        return std::make_shared<Torus2D>(npus_count, bandwidth, latency, shape.rows, shape.cols, routing_policy);
+    }
+    const auto shape = parse_mesh2d_shape(params, npus_count);
+    return std::make_shared<Mesh2D>(npus_count, bandwidth, latency, shape.rows, shape.cols, routing_policy);
+}
+
+/**
+ * Measure the time to construct the route of every message,
+ * as a list of devices and as link ids.
+ */
+void run_route_lookup(const Topology& topology, const std::vector<Message>& messages) {
+    auto checksum = uint64_t{0};
+
+    auto start = std::chrono::steady_clock::now();
+    for (const auto& message : messages) {
+        const auto route = topology.route(message.src, message.dest);
+        checksum += route.size() - 1;
+    }
+    const auto device_route_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    start = std::chrono::steady_clock::now();
+    for (const auto& message : messages) {
+        const auto route = topology.link_route(message.src, message.dest);
+        checksum -= route.get_hops_count();
+    }
+    const auto link_route_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    const auto messages_count = static_cast<double>(messages.size());
+    std::cout << "route lookup: devices " << std::fixed << std::setprecision(1)
+              << device_route_seconds * 1e9 / messages_count << " ns, links "
+              << link_route_seconds * 1e9 / messages_count << " ns per route, speedup " << std::setprecision(2)
+              << device_route_seconds / link_route_seconds << "x" << (checksum == 0 ? "" : " (MISMATCH)")
+              << std::endl;
+}
+
+struct BenchmarkResult {
+    EventTime finish_time;
+    double mean_arrival_time;
+    EventTime max_link_busy_time;
+    double seconds;
+};
+
+/**
+ * Simulate the traffic under the given routing policy.
+ */
+BenchmarkResult run_traffic(const NetworkParser& network_parser,
+                            const RoutingPolicy routing_policy,
+                            const std::vector<Message>& messages,
+                            const ChunkSize chunk_size) {
+    const auto event_queue = std::make_shared<EventQueue>();
+    Topology::set_event_queue(event_queue);
+    const auto topology = construct_grid(network_parser, routing_policy);
+
+    const auto start = std::chrono::steady_clock::now();
+
+    // inject all messages at time 0
+    auto arrivals = std::vector<Arrival>(messages.size(), Arrival{event_queue.get(), 0});
+    for (auto i = size_t{0}; i < messages.size(); i++) {
+        auto route = topology->link_route(messages[i].src, messages[i].dest, i);
+        auto chunk = std::make_unique<Chunk>(chunk_size, messages[i].src, std::move(route), record_arrival,
+                                             &arrivals[i]);
+        topology->send(std::move(chunk));
+    }
+
+    // run simulation
+    while (!event_queue->finished()) {
+        event_queue->proceed();
+    }
+
+    const auto end = std::chrono::steady_clock::now();
+    const auto seconds = std::chrono::duration<double>(end - start).count();
+    const auto finish_time = event_queue->get_current_time();
+
+    auto arrival_times_sum = 0.0;
+    for (const auto& arrival : arrivals) {
+        arrival_times_sum += static_cast<double>(arrival.time);
+    }
+    const auto mean_arrival_time = arrival_times_sum / static_cast<double>(arrivals.size());
+
+    // the hottest link bounds the finish time
+    auto max_link_busy_time = EventTime{0};
+    for (auto link_id = 0; link_id < topology->get_links_count(); link_id++) {
+        max_link_busy_time = std::max(max_link_busy_time, topology->get_link(link_id)->get_stats(finish_time).busy_time);
+    }
+
+    return {finish_time, mean_arrival_time, max_link_busy_time, seconds};
+}
+
+void print_result(const std::string& name, const BenchmarkResult& result) {
+    std::cout << std::left << std::setw(10) << name << std::right << std::fixed << std::setprecision(3)
+              << std::setw(9) << result.seconds << " s  finish time " << result.finish_time << " ns  mean arrival "
+              << std::setprecision(1) << result.mean_arrival_time << " ns  hottest link busy "
+              << result.max_link_busy_time << " ns" << std::endl;
+}
+
+void print_usage(const char* const argv0) {
+    std::cerr << "Usage: " << argv0 << " [options]\n"
+              << "  --network PATH        Mesh2D/Torus2D network configuration (default: ../../input/Mesh2D_64x64.yml)\n"
+              << "  --pattern NAME        uniform or row-broadcast (default: uniform)\n"
+              << "  --messages N          messages per NPU of the uniform pattern (default: 16)\n"
+              << "  --chunk-size BYTES    size of each message (default: 65536)" << std::endl;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    auto network_path = std::string("../../input/Mesh2D_64x64.yml");
+    auto pattern = std::string("uniform");
+    auto messages_per_npu = 16;
+    auto chunk_size = ChunkSize{65'536};
+
+    // parse arguments
+    for (auto i = 1; i < argc; i++) {
+        const auto option = std::string(argv[i]);
+        if (i + 1 >= argc) {
+            print_usage(argv[0]);
+            return -1;
+        }
+        const auto value = std::string(argv[++i]);
+
+        if (option == "--network") {
+            network_path = value;
+        } else if (option == "--pattern") {
+            pattern = value;
+        } else if (option == "--messages") {
+            messages_per_npu = std::stoi(value);
+        } else if (option == "--chunk-size") {
+            chunk_size = std::stoull(value);
+        } else {
+            print_usage(argv[0]);
+            return -1;
+        }
+    }
+
+    if (pattern != "uniform" && pattern != "row-broadcast") {
+        print_usage(argv[0]);
+        return -1;
+    }
+
+    // routing policies apply to 2D grids only
+    const auto network_parser = NetworkParser(network_path);
+    const auto topology_type = network_parser.get_topologies_per_dim()[0];
+    if (network_parser.get_dims_count() != 1 ||
+        (topology_type != TopologyBuildingBlock::Mesh2D && topology_type != TopologyBuildingBlock::Torus2D)) {
+        std::cerr << "[Error] (network/analytical) " << "routing benchmark requires a Mesh2D or Torus2D network"
+                  << std::endl;
+        return -1;
+    }
+
+    // generate traffic
+    const auto event_queue = std::make_shared<EventQueue>();
+    Topology::set_event_queue(event_queue);
+    const auto topology = construct_grid(network_parser, RoutingPolicy::XY);
+    const auto npus_count = topology->get_npus_count();
+    const auto cols = topology->get_npus_count_per_dim()[1];
+    const auto messages = generate_traffic(pattern, npus_count, cols, messages_per_npu);
+    std::cout << "Network: " << network_path << ", " << npus_count << " NPUs, " << messages.size() << " " << pattern
+              << " messages of " << chunk_size << " B" << std::endl;
+
+    // route construction cost
+    run_route_lookup(*topology, messages);
+
+    // simulation under each routing policy
+    const auto routing_policies = std::vector<std::pair<std::string, RoutingPolicy>>{
+        {"XY", RoutingPolicy::XY},
+        {"YX", RoutingPolicy::YX},
+        {"O1TURN", RoutingPolicy::O1Turn},
+        {"Adaptive", RoutingPolicy::Adaptive},
+    };
+    for (const auto& [name, routing_policy] : routing_policies) {
+        print_result(name, run_traffic(network_parser, routing_policy, messages, chunk_size));
+    }
+
+    return 0;
+}
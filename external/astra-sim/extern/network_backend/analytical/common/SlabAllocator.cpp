@@ -0,0 +1,163 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include "common/SlabAllocator.h"
+#include <mutex>
+#include <new>
+#include <vector>
+
+using namespace NetworkAnalytical;
+
+namespace {
+
+/// blocks are rounded up to (and aligned to) this granularity
+constexpr std::size_t block_granularity = 16;
+
+/// number of size classes: blocks up to 256 bytes are pooled
+constexpr std::size_t size_classes_count = 16;
+
+/// size of a slab carved into blocks
+constexpr std::size_t slab_size = 64 * 1024;
+
+/// number of blocks moved between a thread and the depot at once
+constexpr std::size_t batch_size = 256;
+
+/// free block, chained into a free list
+struct FreeBlock {
+    FreeBlock* next;
+};
+
+/// free list of a size class
+struct FreeList {
+    /// first free block
+    FreeBlock* head = nullptr;
+
+    /// number of free blocks
+    std::size_t count = 0;
+};
+
+/**
+ * Blocks shared by all threads.
+ * A thread hands batches of free blocks over to the depot when it frees more blocks than it allocates
+ * (e.g., chunks created by another thread), and takes them back before carving a new slab.
+ */
+struct Depot {
+    /// guards the depot
+    std::mutex mutex;
+
+    /// batches of batch_size free blocks of each size class
+    std::vector<FreeBlock*> batches[size_classes_count];
+
+    /// every slab ever allocated, kept until the process exits
+    std::vector<void*> slabs;
+};
+
+/// per-thread free list of each size class
+thread_local FreeList free_lists[size_classes_count];
+
+Depot& depot() noexcept {
+    // never destroyed: blocks may be freed during static destruction
+    static auto* const depot = new Depot();
+    return *depot;
+}
+
+std::size_t size_class(const std::size_t size) noexcept {
+    return (size == 0) ? 0 : (size - 1) / block_granularity;
+}
+
+void refill(const std::size_t size_class) {
+    auto& free_list = free_lists[size_class];
+    auto& shared = depot();
+    auto* slab = static_cast<char*>(nullptr);
+    {
+        const auto lock = std::lock_guard<std::mutex>(shared.mutex);
+
+        // take a batch from the depot if any
+        auto& batches = shared.batches[size_class];
+        if (!batches.empty()) {
+            free_list.head = batches.back();
+            free_list.count = batch_size;
+            batches.pop_back();
+            return;
+        }
+
+        // otherwise, allocate a new slab
+        slab = static_cast<char*>(::operator new(slab_size));
+        shared.slabs.push_back(slab);
+    }
+
+    // carve the slab into blocks of this size class
+    const auto block_size = (size_class + 1) * block_granularity;
+    const auto blocks_count = slab_size / block_size;
+    for (auto i = blocks_count; i > 0; i--) {
+        auto* const block = reinterpret_cast<FreeBlock*>(slab + (i - 1) * block_size);
+        block->next = free_list.head;
+        free_list.head = block;
+    }
+    free_list.count += blocks_count;
+}
+
+void release_batch(const std::size_t size_class) {
+    auto& free_list = free_lists[size_class];
+
+    // detach the first batch_size blocks
+    auto* const batch = free_list.head;
+    auto* last = batch;
+    for (auto i = std::size_t{1}; i < batch_size; i++) {
+        last = last->next;
+    }
+    free_list.head = last->next;
+    free_list.count -= batch_size;
+    last->next = nullptr;
+
+    // hand them over to the depot
+    auto& shared = depot();
+    const auto lock = std::lock_guard<std::mutex>(shared.mutex);
+    shared.batches[size_class].push_back(batch);
+}
+
+}  // namespace
+
+void* SlabAllocator::allocate(const std::size_t size) {
+    const auto cls = size_class(size);
+    if (cls >= size_classes_count) {
+        return ::operator new(size);
+    }
+
+    auto& free_list = free_lists[cls];
+    if (free_list.head == nullptr) {
+        refill(cls);
+    }
+
+    // pop a free block
+    auto* const block = free_list.head;
+    free_list.head = block->next;
+    free_list.count--;
+    return block;
+}
+
+void SlabAllocator::deallocate(void* const ptr, const std::size_t size) noexcept {
+    if (ptr == nullptr) {
+        return;
+    }
+
+    const auto cls = size_class(size);
+    if (cls >= size_classes_count) {
+        ::operator delete(ptr);
+        return;
+    }
+
+    // push the block back into the free list of this thread
+    auto& free_list = free_lists[cls];
+    auto* const block = static_cast<FreeBlock*>(ptr);
+    block->next = free_list.head;
+    free_list.head = block;
+    free_list.count++;
+
+    // keep the blocks freed by this thread available to the other threads
+    if (free_list.count >= 2 * batch_size) {
+        release_batch(cls);
+    }
+}
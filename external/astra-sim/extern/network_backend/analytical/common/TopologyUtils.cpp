@@ -274,4 +274,45 @@ ButterflySpec parse_butterfly_spec(const std::string& param, const int npus_coun
     return finalize_butterfly(npus_count, radix_hint, stages_hint);
 }
 
+std::vector<int> partition_grid(const GridShape shape, const int regions_count) noexcept {
+    assert(shape.rows > 0 && shape.cols > 0);
+    assert(0 < regions_count && regions_count <= shape.rows * shape.cols);
+
+    // choose (region rows x region cols) cutting the fewest grid edges
+    auto best_region_rows = -1;
+    auto best_cut = INT64_MAX;
+    for (auto region_rows = 1; region_rows <= std::min(regions_count, shape.rows); region_rows++) {
+        if (regions_count % region_rows != 0) {
+            continue;
+        }
+        const auto region_cols = regions_count / region_rows;
+        if (region_cols > shape.cols) {
+            continue;
+        }
+        const auto cut = static_cast<int64_t>(region_rows - 1) * shape.cols +
+                         static_cast<int64_t>(region_cols - 1) * shape.rows;
+        if (cut < best_cut) {
+            best_cut = cut;
+            best_region_rows = region_rows;
+        }
+    }
+
+    const auto npus_count = shape.rows * shape.cols;
+    auto region_ids = std::vector<int>(npus_count);
+    for (auto id = 0; id < npus_count; id++) {
+        if (best_region_rows < 0) {
+            // no block grid fits: split row-major ids into contiguous ranges
+            region_ids[id] = static_cast<int>(static_cast<int64_t>(id) * regions_count / npus_count);
+            continue;
+        }
+
+        // rectangular blocks of (almost) equal size
+        const auto region_cols = regions_count / best_region_rows;
+        const auto region_row = (id / shape.cols) * best_region_rows / shape.rows;
+        const auto region_col = (id % shape.cols) * region_cols / shape.cols;
+        region_ids[id] = region_row * region_cols + region_col;
+    }
+    return region_ids;
+}
+
 }  // namespace NetworkAnalytical
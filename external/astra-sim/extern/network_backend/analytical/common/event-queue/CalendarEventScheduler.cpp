@@ -0,0 +1,208 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include "common/CalendarEventScheduler.h"
+#include <algorithm>
+#include <cassert>
+
+using namespace NetworkAnalytical;
+
+CalendarEventScheduler::CalendarEventScheduler() noexcept
+    : buckets_mask(min_buckets_count - 1),
+      width_shift(0),
+      slots_count(0),
+      last_event_time(0),
+      cached_bucket(0),
+      cached_bucket_valid(false) {
+    // create empty calendar
+    buckets = std::vector<std::vector<TimeSlot>>(min_buckets_count);
+}
+
+bool CalendarEventScheduler::empty() const noexcept {
+    return slots_count == 0;
+}
+
+EventTime CalendarEventScheduler::next_event_time() noexcept {
+    assert(!empty());
+
+    // locate the earliest bucket if not known
+    if (!cached_bucket_valid) {
+        cached_bucket = find_earliest_bucket();
+        cached_bucket_valid = true;
+    }
+
+    return buckets[cached_bucket].back().event_time;
+}
+
+void CalendarEventScheduler::schedule(const EventTime event_time,
+                                      const Callback callback,
+                                      const CallbackArg callback_arg) noexcept {
+    // events cannot be scheduled in the past
+    assert(event_time >= last_event_time);
+
+    // store the event
+    const auto index = pool.allocate(callback, callback_arg);
+
+    // find the time slot from the back (earliest) side of the bucket
+    auto& bucket = buckets[bucket_of(event_time)];
+    auto position = bucket.size();
+    while (position > 0 && bucket[position - 1].event_time < event_time) {
+        position--;
+    }
+
+    if (position > 0 && bucket[position - 1].event_time == event_time) {
+        // time slot exists: append the event to its chain
+        auto& slot = bucket[position - 1];
+        pool.set_next(slot.tail, index);
+        slot.tail = index;
+        return;
+    }
+
+    // create a new time slot
+    bucket.insert(bucket.begin() + static_cast<std::ptrdiff_t>(position), TimeSlot{event_time, index, index});
+    slots_count++;
+
+    // the new time slot may precede the cached earliest one
+    if (cached_bucket_valid && event_time < buckets[cached_bucket].back().event_time) {
+        cached_bucket_valid = false;
+    }
+
+    // grow the calendar if buckets got crowded
+    if (slots_count > 2 * buckets.size()) {
+        resize(2 * buckets.size());
+    }
+}
+
+Event CalendarEventScheduler::pop() noexcept {
+    assert(!empty());
+
+    // locate the earliest time slot
+    last_event_time = next_event_time();
+    auto& bucket = buckets[cached_bucket];
+    auto& slot = bucket.back();
+
+    // dequeue the first event of the time slot
+    const auto index = slot.head;
+    const auto next = pool.get_next(index);
+
+    if (next != EventPool::npos) {
+        slot.head = next;
+        return pool.release(index);
+    }
+
+    // time slot drained: drop it
+    bucket.pop_back();
+    slots_count--;
+    cached_bucket_valid = false;
+
+    // shrink the calendar if buckets got sparse
+    if (buckets.size() > min_buckets_count && slots_count < buckets.size() / 2) {
+        resize(buckets.size() / 2);
+    }
+
+    return pool.release(index);
+}
+
+size_t CalendarEventScheduler::bucket_of(const EventTime event_time) const noexcept {
+    return static_cast<size_t>(event_time >> width_shift) & buckets_mask;
+}
+
+size_t CalendarEventScheduler::find_earliest_bucket() const noexcept {
+    assert(!empty());
+
+    // scan one year of days, starting from the day of the last dequeued event
+    auto day = last_event_time >> width_shift;
+    auto bucket = static_cast<size_t>(day) & buckets_mask;
+    for (auto i = size_t{0}; i < buckets.size(); i++) {
+        const auto& candidate = buckets[bucket];
+        if (!candidate.empty() && (candidate.back().event_time >> width_shift) == day) {
+            return bucket;
+        }
+
+        day++;
+        bucket = (bucket + 1) & buckets_mask;
+    }
+
+    // nothing within a year: search the earliest event time directly
+    auto earliest_bucket = buckets.size();
+    for (auto i = size_t{0}; i < buckets.size(); i++) {
+        if (buckets[i].empty()) {
+            continue;
+        }
+        if (earliest_bucket == buckets.size() ||
+            buckets[i].back().event_time < buckets[earliest_bucket].back().event_time) {
+            earliest_bucket = i;
+        }
+    }
+
+    assert(earliest_bucket < buckets.size());
+    return earliest_bucket;
+}
+
+int CalendarEventScheduler::estimate_width_shift(std::vector<TimeSlot>& slots) const noexcept {
+    // need at least two event times to measure separations
+    if (slots.size() < 2) {
+        return width_shift;
+    }
+
+    // sample the earliest event times
+    const auto samples_count = std::min(slots.size(), width_samples_count);
+    const auto by_time = [](const TimeSlot& lhs, const TimeSlot& rhs) { return lhs.event_time < rhs.event_time; };
+    std::nth_element(slots.begin(), slots.begin() + static_cast<std::ptrdiff_t>(samples_count - 1), slots.end(),
+                     by_time);
+    std::sort(slots.begin(), slots.begin() + static_cast<std::ptrdiff_t>(samples_count), by_time);
+
+    // average separation of the sampled event times
+    const auto total_separation = slots[samples_count - 1].event_time - slots[0].event_time;
+    const auto average_separation = total_separation / (samples_count - 1);
+
+    // re-average ignoring outlying separations
+    auto trimmed_separation = EventTime{0};
+    auto trimmed_count = EventTime{0};
+    for (auto i = size_t{1}; i < samples_count; i++) {
+        const auto separation = slots[i].event_time - slots[i - 1].event_time;
+        if (separation <= 2 * average_separation) {
+            trimmed_separation += separation;
+            trimmed_count++;
+        }
+    }
+    const auto separation = (trimmed_count > 0) ? (trimmed_separation / trimmed_count) : average_separation;
+
+    // bucket width is set to about 3x the separation, rounded up to a power of 2
+    const auto width = std::max<EventTime>(3 * separation, 1);
+    auto new_width_shift = 0;
+    while ((EventTime{1} << new_width_shift) < width && new_width_shift < 63) {
+        new_width_shift++;
+    }
+    return new_width_shift;
+}
+
+void CalendarEventScheduler::resize(const size_t new_buckets_count) noexcept {
+    assert(new_buckets_count >= min_buckets_count);
+    assert((new_buckets_count & (new_buckets_count - 1)) == 0);
+
+    // collect all time slots
+    auto slots = std::vector<TimeSlot>();
+    slots.reserve(slots_count);
+    for (const auto& bucket : buckets) {
+        slots.insert(slots.end(), bucket.begin(), bucket.end());
+    }
+
+    // reconfigure the calendar
+    width_shift = estimate_width_shift(slots);
+    buckets_mask = new_buckets_count - 1;
+    buckets = std::vector<std::vector<TimeSlot>>(new_buckets_count);
+
+    // redistribute time slots, earliest at the back of each bucket
+    for (const auto& slot : slots) {
+        buckets[bucket_of(slot.event_time)].push_back(slot);
+    }
+    for (auto& bucket : buckets) {
+        std::sort(bucket.begin(), bucket.end(),
+                  [](const TimeSlot& lhs, const TimeSlot& rhs) { return lhs.event_time > rhs.event_time; });
+    }
+
+    cached_bucket_valid = false;
+}
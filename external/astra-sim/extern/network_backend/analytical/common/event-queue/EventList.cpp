@@ -33,3 +33,17 @@ void EventList::invoke_events() noexcept {
         events.pop_front();
     }
 }
+
+bool EventList::empty() const noexcept {
+    return events.empty();
+}
+
+Event EventList::pop_event() noexcept {
+    // event list should not be empty
+    assert(!events.empty());
+
+    // dequeue the first event
+    const auto event = events.front();
+    events.pop_front();
+    return event;
+}
@@ -0,0 +1,59 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include "common/EventPool.h"
+#include <cassert>
+
+using namespace NetworkAnalytical;
+
+EventPool::EventPool() noexcept : free_head(npos) {
+    // create empty pool
+    nodes = std::vector<Node>();
+}
+
+EventPool::Index EventPool::allocate(const Callback callback, const CallbackArg callback_arg) noexcept {
+    assert(callback != nullptr);
+
+    // grow the pool if no recycled slot is available
+    if (free_head == npos) {
+        assert(nodes.size() < npos);
+        nodes.push_back({callback, callback_arg, npos});
+        return static_cast<Index>(nodes.size() - 1);
+    }
+
+    // reuse a recycled slot
+    const auto index = free_head;
+    auto& node = nodes[index];
+    free_head = node.next;
+    node = {callback, callback_arg, npos};
+    return index;
+}
+
+Event EventPool::release(const Index index) noexcept {
+    assert(index < nodes.size());
+
+    // take out the event
+    auto& node = nodes[index];
+    const auto event = Event(node.callback, node.callback_arg);
+
+    // recycle the slot
+    node.callback = nullptr;
+    node.next = free_head;
+    free_head = index;
+
+    return event;
+}
+
+EventPool::Index EventPool::get_next(const Index index) const noexcept {
+    assert(index < nodes.size());
+
+    return nodes[index].next;
+}
+
+void EventPool::set_next(const Index index, const Index next) noexcept {
+    assert(index < nodes.size());
+
+    nodes[index].next = next;
+}
@@ -4,13 +4,52 @@ LICENSE file in the root directory of this source tree.
 *******************************************************************************/
 
 #include "common/EventQueue.h"
+#include "common/CalendarEventScheduler.h"
+#include "common/HeapEventScheduler.h"
+#include "common/LinearEventScheduler.h"
 #include <cassert>
+#include <cstdlib>
+#include <iostream>
 
 using namespace NetworkAnalytical;
 
-EventQueue::EventQueue() noexcept : current_time(0) {
+EventSchedulerType EventQueue::parse_scheduler_type(const std::string& scheduler_name) noexcept {
+    if (scheduler_name == "linear") {
+        return EventSchedulerType::Linear;
+    }
+
+    if (scheduler_name == "heap") {
+        return EventSchedulerType::Heap;
+    }
+
+    if (scheduler_name == "calendar") {
+        return EventSchedulerType::Calendar;
+    }
+
+    std::cerr << "[Error] (network/analytical) Event scheduler " << scheduler_name
+              << " not supported (expected linear/heap/calendar)" << std::endl;
+    std::exit(-1);
+}
+
+EventQueue::EventQueue(const EventSchedulerType scheduler_type) noexcept
+    : current_time(0),
+      invoked_events_count(0),
+      trace_recorder(nullptr) {
     // create empty event queue
-    event_queue = std::list<EventList>();
+    switch (scheduler_type) {
+    case EventSchedulerType::Linear:
+        scheduler = std::make_unique<LinearEventScheduler>();
+        break;
+    case EventSchedulerType::Heap:
+        scheduler = std::make_unique<HeapEventScheduler>();
+        break;
+    case EventSchedulerType::Calendar:
+        scheduler = std::make_unique<CalendarEventScheduler>();
+        break;
+    default:
+        std::cerr << "[Error] (network/analytical) Unsupported event scheduler" << std::endl;
+        std::exit(-1);
+    }
 }
 
 EventTime EventQueue::get_current_time() const noexcept {
@@ -19,25 +58,40 @@ EventTime EventQueue::get_current_time() const noexcept {
 
 bool EventQueue::finished() const noexcept {
     // check whether event queue is empty
-    return event_queue.empty();
+    return scheduler->empty();
+}
+
+uint64_t EventQueue::get_invoked_events_count() const noexcept {
+    return invoked_events_count;
+}
+
+EventTime EventQueue::get_next_event_time() noexcept {
+    assert(!finished());
+
+    return scheduler->next_event_time();
 }
 
 void EventQueue::proceed() noexcept {
     // to proceed, next event should exist
     assert(!finished());
 
-    // proceed to the next event time
-    auto& current_event_list = event_queue.front();
-
     // check the validity and update current time
-    assert(current_event_list.get_event_time() > current_time);
-    current_time = current_event_list.get_event_time();
+    // (events may be scheduled at the current time between two proceed() calls)
+    assert(scheduler->next_event_time() >= current_time);
+    current_time = scheduler->next_event_time();
 
-    // invoke events
-    current_event_list.invoke_events();
+    // invoke all events at the current time,
+    // including the ones scheduled at the current time by these events
+    while (!scheduler->empty() && scheduler->next_event_time() == current_time) {
+        auto event = scheduler->pop();
+        event.invoke_event();
+        invoked_events_count++;
+    }
 
-    // drop processed event list
-    event_queue.pop_front();
+    // mark the end of this step in the trace
+    if (trace_recorder != nullptr) {
+        trace_recorder->advance_epoch();
+    }
 }
 
 void EventQueue::schedule_event(const EventTime event_time,
@@ -46,26 +100,33 @@ void EventQueue::schedule_event(const EventTime event_time,
     // time should be at least larger than current time
     assert(event_time >= current_time);
 
-    // find the entry to insert event
-    auto event_list_it = event_queue.begin();
-    while (event_list_it != event_queue.end() && event_list_it->get_event_time() < event_time) {
-        event_list_it++;
+    if (trace_recorder != nullptr) {
+        // record the call and schedule the wrapped event
+        const auto recorded_arg = trace_recorder->record(event_time, callback, callback_arg);
+        scheduler->schedule(event_time, EventTraceRecorder::invoke_recorded_event, recorded_arg);
+        return;
     }
 
-    // There can be three scenarios:
-    // (1) event list matching with event_time is found
-    // (2) there's no event list matching with event_time
-    //   (2-1) the event_time requested is
-    //   larger than the largest event time scheduled
-    //   (2-2) the event_time requested is
-    //   smaller than the largest event time scheduled
-    // for both (2-1) or (2-2), a new event should be created
-    if (event_list_it == event_queue.end() || event_time < event_list_it->get_event_time()) {
-        // insert new event_list
-        event_list_it = event_queue.insert(event_list_it, EventList(event_time));
+    scheduler->schedule(event_time, callback, callback_arg);
+}
+
+std::unique_ptr<EventScheduler> EventQueue::replace_scheduler(std::unique_ptr<EventScheduler> new_scheduler) noexcept {
+    assert(new_scheduler != nullptr);
+    assert(new_scheduler->empty());
+
+    // move pending events in (event time, schedule order)
+    while (!scheduler->empty()) {
+        const auto event_time = scheduler->next_event_time();
+        const auto [callback, callback_arg] = scheduler->pop().get_handler_arg();
+        new_scheduler->schedule(event_time, callback, callback_arg);
     }
 
-    // now, whether (1) or (2), the entry to insert the event is found
-    // add event to event_list
-    event_list_it->add_event(callback, callback_arg);
+    scheduler.swap(new_scheduler);
+    return new_scheduler;
+}
+
+void EventQueue::record_trace(const std::string& path) noexcept {
+    assert(trace_recorder == nullptr);
+
+    trace_recorder = std::make_unique<EventTraceRecorder>(path);
 }
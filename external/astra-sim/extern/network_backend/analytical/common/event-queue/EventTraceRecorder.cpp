@@ -0,0 +1,94 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include "common/EventTraceRecorder.h"
+#include <cassert>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+using namespace NetworkAnalytical;
+
+namespace {
+
+/// magic header identifying an event trace file
+constexpr char trace_magic[8] = {'A', 'N', 'E', 'Q', 'T', 'R', 'C', '1'};
+
+}  // namespace
+
+std::vector<EventTraceRecorder::Record> EventTraceRecorder::load(const std::string& path) noexcept {
+    auto trace_file = std::ifstream(path, std::ios::binary);
+    if (!trace_file) {
+        std::cerr << "[Error] (network/analytical) cannot open event trace: " << path << std::endl;
+        std::exit(-1);
+    }
+
+    // check the header
+    char magic[sizeof(trace_magic)];
+    trace_file.read(magic, sizeof(magic));
+    if (!trace_file || std::memcmp(magic, trace_magic, sizeof(trace_magic)) != 0) {
+        std::cerr << "[Error] (network/analytical) not an event trace: " << path << std::endl;
+        std::exit(-1);
+    }
+
+    // read all records
+    auto records = std::vector<Record>();
+    auto record = Record();
+    while (trace_file.read(reinterpret_cast<char*>(&record), sizeof(Record))) {
+        records.push_back(record);
+    }
+
+    return records;
+}
+
+void EventTraceRecorder::invoke_recorded_event(void* const recorded_event_ptr) noexcept {
+    assert(recorded_event_ptr != nullptr);
+
+    // take ownership of the wrapped event
+    auto* const recorded_event = static_cast<RecordedEvent*>(recorded_event_ptr);
+    auto* const recorder = recorded_event->recorder;
+    const auto callback = recorded_event->callback;
+    const auto callback_arg = recorded_event->callback_arg;
+
+    // invoke the original callback, attributing new events to this one
+    recorder->current_event_id = recorded_event->id;
+    delete recorded_event;
+    (*callback)(callback_arg);
+    recorder->current_event_id = -1;
+}
+
+EventTraceRecorder::EventTraceRecorder(const std::string& path) noexcept
+    : trace_file(path, std::ios::binary | std::ios::trunc),
+      next_id(0),
+      current_event_id(-1),
+      epoch(0) {
+    if (!trace_file) {
+        std::cerr << "[Error] (network/analytical) cannot create event trace: " << path << std::endl;
+        std::exit(-1);
+    }
+
+    // write the header
+    trace_file.write(trace_magic, sizeof(trace_magic));
+}
+
+CallbackArg EventTraceRecorder::record(const EventTime event_time,
+                                       const Callback callback,
+                                       const CallbackArg callback_arg) noexcept {
+    assert(callback != nullptr);
+
+    // write the record
+    const auto record = Record{event_time, current_event_id, epoch};
+    trace_file.write(reinterpret_cast<const char*>(&record), sizeof(Record));
+
+    // wrap the event
+    auto* const recorded_event = new RecordedEvent{this, next_id, callback, callback_arg};
+    next_id++;
+
+    return static_cast<CallbackArg>(recorded_event);
+}
+
+void EventTraceRecorder::advance_epoch() noexcept {
+    epoch++;
+}
@@ -0,0 +1,54 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include "common/HeapEventScheduler.h"
+#include <algorithm>
+#include <cassert>
+
+using namespace NetworkAnalytical;
+
+HeapEventScheduler::HeapEventScheduler() noexcept : next_sequence(0) {
+    // create empty heap
+    heap = std::vector<HeapEntry>();
+}
+
+bool HeapEventScheduler::empty() const noexcept {
+    return heap.empty();
+}
+
+EventTime HeapEventScheduler::next_event_time() noexcept {
+    assert(!empty());
+
+    return heap.front().event_time;
+}
+
+void HeapEventScheduler::schedule(const EventTime event_time,
+                                  const Callback callback,
+                                  const CallbackArg callback_arg) noexcept {
+    // store the event and push it into the heap
+    const auto index = pool.allocate(callback, callback_arg);
+    heap.push_back({event_time, next_sequence, index});
+    std::push_heap(heap.begin(), heap.end(), later);
+
+    next_sequence++;
+}
+
+Event HeapEventScheduler::pop() noexcept {
+    assert(!empty());
+
+    // take out the earliest entry
+    std::pop_heap(heap.begin(), heap.end(), later);
+    const auto index = heap.back().index;
+    heap.pop_back();
+
+    return pool.release(index);
+}
+
+bool HeapEventScheduler::later(const HeapEntry& lhs, const HeapEntry& rhs) noexcept {
+    if (lhs.event_time != rhs.event_time) {
+        return lhs.event_time > rhs.event_time;
+    }
+    return lhs.sequence > rhs.sequence;
+}
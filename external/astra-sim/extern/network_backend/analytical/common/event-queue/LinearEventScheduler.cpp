@@ -0,0 +1,66 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include "common/LinearEventScheduler.h"
+#include <cassert>
+
+using namespace NetworkAnalytical;
+
+LinearEventScheduler::LinearEventScheduler() noexcept {
+    // create empty event list
+    event_lists = std::list<EventList>();
+}
+
+bool LinearEventScheduler::empty() const noexcept {
+    return event_lists.empty();
+}
+
+EventTime LinearEventScheduler::next_event_time() noexcept {
+    assert(!empty());
+
+    return event_lists.front().get_event_time();
+}
+
+void LinearEventScheduler::schedule(const EventTime event_time,
+                                    const Callback callback,
+                                    const CallbackArg callback_arg) noexcept {
+    // find the entry to insert event
+    auto event_list_it = event_lists.begin();
+    while (event_list_it != event_lists.end() && event_list_it->get_event_time() < event_time) {
+        event_list_it++;
+    }
+
+    // There can be three scenarios:
+    // (1) event list matching with event_time is found
+    // (2) there's no event list matching with event_time
+    //   (2-1) the event_time requested is
+    //   larger than the largest event time scheduled
+    //   (2-2) the event_time requested is
+    //   smaller than the largest event time scheduled
+    // for both (2-1) or (2-2), a new event should be created
+    if (event_list_it == event_lists.end() || event_time < event_list_it->get_event_time()) {
+        // insert new event_list
+        event_list_it = event_lists.insert(event_list_it, EventList(event_time));
+    }
+
+    // now, whether (1) or (2), the entry to insert the event is found
+    // add event to event_list
+    event_list_it->add_event(callback, callback_arg);
+}
+
+Event LinearEventScheduler::pop() noexcept {
+    assert(!empty());
+
+    // dequeue the first event of the earliest event list
+    auto& current_event_list = event_lists.front();
+    const auto event = current_event_list.pop_event();
+
+    // drop the event list once drained
+    if (current_event_list.empty()) {
+        event_lists.pop_front();
+    }
+
+    return event;
+}
@@ -56,7 +56,10 @@ ParsedTopologyToken parse_topology_token(const std::string& token) {
 
 using namespace NetworkAnalytical;
 
-NetworkParser::NetworkParser(const std::string& path) noexcept : dims_count(-1) {
+NetworkParser::NetworkParser(const std::string& path) noexcept
+    : dims_count(-1),
+      parallel_threads(0),
+      routing_policy(RoutingPolicy::XY) {
     // initialize values
     npus_count_per_dim = {};
     bandwidth_per_dim = {};
@@ -118,6 +121,16 @@ std::vector<std::string> NetworkParser::get_topology_params_per_dim() const noex
     return topology_params_per_dim;
 }
 
+int NetworkParser::get_parallel_threads() const noexcept {
+    assert(parallel_threads >= 0);
+
+    return parallel_threads;
+}
+
+RoutingPolicy NetworkParser::get_routing_policy() const noexcept {
+    return routing_policy;
+}
+
 void NetworkParser::parse_network_config_yml(const YAML::Node& network_config) noexcept {
     // parse topology_per_dim
     const auto topology_names = parse_vector<std::string>(network_config["topology"]);
@@ -136,6 +149,25 @@ void NetworkParser::parse_network_config_yml(const YAML::Node& network_config) n
     bandwidth_per_dim = parse_vector<Bandwidth>(network_config["bandwidth"]);
     latency_per_dim = parse_vector<Latency>(network_config["latency"]);
 
+    // parse optional scalar values
+    if (network_config["parallel_threads"]) {
+        try {
+            parallel_threads = network_config["parallel_threads"].as<int>();
+        } catch (const YAML::BadConversion& e) {
+            std::cerr << "[Error] (network/analytical) " << e.what() << std::endl;
+            std::exit(-1);
+        }
+    }
+
+    if (network_config["routing"]) {
+        try {
+            routing_policy = NetworkParser::parse_routing_name(network_config["routing"].as<std::string>());
+        } catch (const YAML::BadConversion& e) {
+            std::cerr << "[Error] (network/analytical) " << e.what() << std::endl;
+            std::exit(-1);
+        }
+    }
+
     // check the validity of the parsed network config
     check_validity();
 }
@@ -172,6 +204,30 @@ TopologyBuildingBlock NetworkParser::parse_topology_name(const std::string& topo
     std::exit(-1);
 }
 
+RoutingPolicy NetworkParser::parse_routing_name(const std::string& routing_name) noexcept {
+    const auto name = trim(routing_name);
+
+    if (name == "XY") {
+        return RoutingPolicy::XY;
+    }
+
+    if (name == "YX") {
+        return RoutingPolicy::YX;
+    }
+
+    if (name == "O1TURN" || name == "O1Turn") {
+        return RoutingPolicy::O1Turn;
+    }
+
+    if (name == "Adaptive") {
+        return RoutingPolicy::Adaptive;
+    }
+
+    std::cerr << "[Error] (network/analytical) Routing policy " << name
+              << " not supported (expected XY/YX/O1TURN/Adaptive)" << std::endl;
+    std::exit(-1);
+}
+
 void NetworkParser::check_validity() const noexcept {
     // dims_count should match
     if (dims_count != npus_count_per_dim.size()) {
@@ -197,6 +253,13 @@ void NetworkParser::check_validity() const noexcept {
         std::exit(-1);
     }
 
+    // parallel_threads should be non-negative
+    if (parallel_threads < 0) {
+        std::cerr << "[Error] (network/analytical) " << "parallel_threads (" << parallel_threads
+                  << ") should be non-negative" << std::endl;
+        std::exit(-1);
+    }
+
     // npus_count should be all positive
     for (const auto& npus_count : npus_count_per_dim) {
         if (npus_count <= 1) {
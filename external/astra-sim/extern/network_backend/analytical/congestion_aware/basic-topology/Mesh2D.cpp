@@ -1,10 +1,16 @@
 #include "congestion_aware/Mesh2D.h"
+#include "common/TopologyUtils.h"
 #include <cassert>
 #include <cstdlib>
 
 using namespace NetworkAnalyticalCongestionAware;
 
-Mesh2D::Mesh2D(const int npus_count, const Bandwidth bandwidth, const Latency latency, const int rows, const int cols) noexcept
+Mesh2D::Mesh2D(const int npus_count,
+               const Bandwidth bandwidth,
+               const Latency latency,
+               const int rows,
+               const int cols,
+               const RoutingPolicy routing_policy) noexcept
     : rows(rows),
       cols(cols),
       BasicTopology(npus_count, npus_count, bandwidth, latency) {
@@ -15,6 +21,7 @@ Mesh2D::Mesh2D(const int npus_count, const Bandwidth bandwidth, const Latency la
     basic_topology_type = TopologyBuildingBlock::Mesh2D;
 
     connect_neighbors(bandwidth, latency);
+    route_table = std::make_unique<GridRouteTable>(*this, rows, cols, false, routing_policy);
 
     npus_count_per_dim.clear();
     npus_count_per_dim.push_back(rows);
@@ -45,29 +52,53 @@ Route Mesh2D::route(const DeviceId src, const DeviceId dest) const noexcept {
     assert(0 <= src && src < npus_count);
     assert(0 <= dest && dest < npus_count);
 
-    const auto [src_row, src_col] = decode(src);
-    const auto [dest_row, dest_col] = decode(dest);
+    // devices along the precomputed links
+    return device_route(src, link_route(src, dest));
+}
 
-    auto current_row = src_row;
-    auto current_col = src_col;
-    auto route = Route();
-    route.push_back(devices[src]);
+LinkRoute Mesh2D::link_route(const DeviceId src, const DeviceId dest, const uint64_t sequence) const noexcept {
+    assert(0 <= src && src < npus_count);
+    assert(0 <= dest && dest < npus_count);
 
-    const auto row_step = (dest_row > current_row) ? 1 : -1;
-    while (current_row != dest_row) {
-        current_row += row_step;
-        const auto next = encode(current_row, current_col);
-        route.push_back(devices[next]);
-    }
+    return route_table->route(src, dest, sequence);
+}
+
+Route Mesh2D::tree_route(const DeviceId src, const DeviceId dest) const noexcept {
+    assert(0 <= src && src < npus_count);
+    assert(0 <= dest && dest < npus_count);
+
+    // a single dimension order for every dest
+    return device_route(src, route_table->tree_route(src, dest));
+}
+
+std::vector<int> Mesh2D::partition_devices(const int regions_count) const noexcept {
+    assert(0 < regions_count && regions_count <= npus_count);
+
+    // spatial blocks of the grid
+    return partition_grid(GridShape{rows, cols}, regions_count);
+}
+
+LinkCoordinate Mesh2D::link_coordinate(const DeviceId src, const DeviceId dest) const noexcept {
+    assert(0 <= src && src < npus_count);
+    assert(0 <= dest && dest < npus_count);
+
+    const auto [src_row, src_col] = decode(src);
+    const auto [dest_row, dest_col] = decode(dest);
 
-    const auto col_step = (dest_col > current_col) ? 1 : -1;
-    while (current_col != dest_col) {
-        current_col += col_step;
-        const auto next = encode(current_row, current_col);
-        route.push_back(devices[next]);
+    // links connect vertical or horizontal neighbors
+    auto direction = '-';
+    if (dest_row == src_row + 1) {
+        direction = 'S';
+    } else if (dest_row == src_row - 1) {
+        direction = 'N';
+    } else if (dest_col == src_col + 1) {
+        direction = 'E';
+    } else if (dest_col == src_col - 1) {
+        direction = 'W';
     }
+    assert(direction != '-');
 
-    return route;
+    return {src_row, src_col, direction};
 }
 
 int Mesh2D::encode(const int row, const int col) const noexcept {
@@ -1,11 +1,17 @@
 #include "congestion_aware/Torus2D.h"
+#include "common/TopologyUtils.h"
 #include <algorithm>
 #include <cassert>
 #include <cstdlib>
 
 using namespace NetworkAnalyticalCongestionAware;
 
-Torus2D::Torus2D(const int npus_count, const Bandwidth bandwidth, const Latency latency, const int rows, const int cols) noexcept
+Torus2D::Torus2D(const int npus_count,
+                 const Bandwidth bandwidth,
+                 const Latency latency,
+                 const int rows,
+                 const int cols,
+                 const RoutingPolicy routing_policy) noexcept
     : rows(rows),
       cols(cols),
       BasicTopology(npus_count, npus_count, bandwidth, latency) {
@@ -16,6 +22,7 @@ Torus2D::Torus2D(const int npus_count, const Bandwidth bandwidth, const Latency
     basic_topology_type = TopologyBuildingBlock::Torus2D;
 
     connect_neighbors(bandwidth, latency);
+    route_table = std::make_unique<GridRouteTable>(*this, rows, cols, true, routing_policy);
 
     npus_count_per_dim.clear();
     npus_count_per_dim.push_back(rows);
@@ -42,39 +49,23 @@ Route Torus2D::route(const DeviceId src, const DeviceId dest) const noexcept {
     assert(0 <= src && src < npus_count);
     assert(0 <= dest && dest < npus_count);
 
-    const auto [src_row, src_col] = decode(src);
-    const auto [dest_row, dest_col] = decode(dest);
+    // devices along the precomputed links
+    return device_route(src, link_route(src, dest));
+}
 
-    auto current_row = src_row;
-    auto current_col = src_col;
-    auto route = Route();
-    route.push_back(devices[src]);
-
-    // vertical traversal
-    int row_diff = dest_row - current_row;
-    int steps_down = (row_diff >= 0) ? row_diff : row_diff + rows;
-    int steps_up = rows - steps_down;
-    int row_direction = (steps_down <= steps_up) ? 1 : -1;
-    int row_steps = std::min(steps_down, steps_up);
-    for (auto step = 0; step < row_steps; step++) {
-        current_row = wrap(current_row, row_direction, rows);
-        const auto next = encode(current_row, current_col);
-        route.push_back(devices[next]);
-    }
+LinkRoute Torus2D::link_route(const DeviceId src, const DeviceId dest, const uint64_t sequence) const noexcept {
+    assert(0 <= src && src < npus_count);
+    assert(0 <= dest && dest < npus_count);
 
-    // horizontal traversal
-    int col_diff = dest_col - current_col;
-    int steps_right = (col_diff >= 0) ? col_diff : col_diff + cols;
-    int steps_left = cols - steps_right;
-    int col_direction = (steps_right <= steps_left) ? 1 : -1;
-    int col_steps = std::min(steps_right, steps_left);
-    for (auto step = 0; step < col_steps; step++) {
-        current_col = wrap(current_col, col_direction, cols);
-        const auto next = encode(current_row, current_col);
-        route.push_back(devices[next]);
-    }
+    return route_table->route(src, dest, sequence);
+}
+
+Route Torus2D::tree_route(const DeviceId src, const DeviceId dest) const noexcept {
+    assert(0 <= src && src < npus_count);
+    assert(0 <= dest && dest < npus_count);
 
-    return route;
+    // a single dimension order for every dest
+    return device_route(src, route_table->tree_route(src, dest));
 }
 
 int Torus2D::wrap(const int coordinate, const int delta, const int bound) const noexcept {
@@ -87,6 +78,36 @@ int Torus2D::wrap(const int coordinate, const int delta, const int bound) const
     return next;
 }
 
+std::vector<int> Torus2D::partition_devices(const int regions_count) const noexcept {
+    assert(0 < regions_count && regions_count <= npus_count);
+
+    // spatial blocks of the grid
+    return partition_grid(GridShape{rows, cols}, regions_count);
+}
+
+LinkCoordinate Torus2D::link_coordinate(const DeviceId src, const DeviceId dest) const noexcept {
+    assert(0 <= src && src < npus_count);
+    assert(0 <= dest && dest < npus_count);
+
+    const auto [src_row, src_col] = decode(src);
+    const auto [dest_row, dest_col] = decode(dest);
+
+    // links connect vertical or horizontal neighbors, including wrap-around links
+    auto direction = '-';
+    if (src_col == dest_col && dest_row == wrap(src_row, 1, rows)) {
+        direction = 'S';
+    } else if (src_col == dest_col && dest_row == wrap(src_row, -1, rows)) {
+        direction = 'N';
+    } else if (src_row == dest_row && dest_col == wrap(src_col, 1, cols)) {
+        direction = 'E';
+    } else if (src_row == dest_row && dest_col == wrap(src_col, -1, cols)) {
+        direction = 'W';
+    }
+    assert(direction != '-');
+
+    return {src_row, src_col, direction};
+}
+
 int Torus2D::encode(const int row, const int col) const noexcept {
     return row * cols + col;
 }
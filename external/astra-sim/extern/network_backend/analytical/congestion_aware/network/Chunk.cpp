@@ -4,8 +4,10 @@ LICENSE file in the root directory of this source tree.
 *******************************************************************************/
 
 #include "congestion_aware/Chunk.h"
+#include "common/SlabAllocator.h"
 #include "congestion_aware/Device.h"
 #include "congestion_aware/Link.h"
+#include "congestion_aware/Topology.h"
 #include <cassert>
 
 using namespace NetworkAnalyticalCongestionAware;
@@ -20,57 +22,177 @@ void Chunk::chunk_arrived_next_device(void* const chunk_ptr) noexcept {
     chunk->mark_arrived_next_device();
 
     if (chunk->arrived_dest()) {
+        if (chunk->is_multicast()) {
+            // multicast chunk arrived the end of its branch:
+            // replicate it to the child branches, and deliver if this is a destination
+            const auto& current_node = chunk->current_device();
+            current_node->multicast(std::move(chunk));
+            return;
+        }
+
         // chunk arrived dest, invoke callback
         // as chunk is unique_ptr, will be destroyed automatically
         chunk->invoke_callback();
     } else {
         // send this chunk to next dest
-        const auto current_node = chunk->current_device();
+        const auto& current_node = chunk->current_device();
         current_node->send(std::move(chunk));  // send chunk to next des
     }
 }
 
-Chunk::Chunk(const ChunkSize chunk_size, Route route, const Callback callback, const CallbackArg callback_arg) noexcept
+void* Chunk::operator new(const std::size_t size) {
+    return SlabAllocator::allocate(size);
+}
+
+void Chunk::operator delete(void* const ptr, const std::size_t size) noexcept {
+    SlabAllocator::deallocate(ptr, size);
+}
+
+Chunk::Chunk(const ChunkSize chunk_size, const Route& route, const Callback callback, const CallbackArg callback_arg) noexcept
+    : Chunk(chunk_size, route.front()->get_id(), LinkRoute(route), callback, callback_arg) {}
+
+Chunk::Chunk(const ChunkSize chunk_size,
+             const DeviceId src,
+             LinkRoute link_route,
+             const Callback callback,
+             const CallbackArg callback_arg) noexcept
     : chunk_size(chunk_size),
-      route(std::move(route)),
+      route(std::move(link_route)),
+      hop(0),
+      current_device_id(src),
+      topology(nullptr),
       callback(callback),
-      callback_arg(callback_arg) {
+      callback_arg(callback_arg),
+      multicast_route(nullptr),
+      multicast_callback_args(nullptr),
+      branch_id(-1) {
     assert(chunk_size > 0);
-    assert(!this->route.empty());
+    assert(src >= 0);
     assert(callback != nullptr);
 }
 
-std::shared_ptr<Device> Chunk::current_device() const noexcept {
-    // assert the route is not empty
-    assert(!route.empty());
+Chunk::Chunk(const ChunkSize chunk_size,
+             std::shared_ptr<const MulticastRoute> multicast_route,
+             const Callback callback,
+             std::vector<CallbackArg> callback_args) noexcept
+    : chunk_size(chunk_size),
+      route(),
+      hop(0),
+      current_device_id(-1),
+      topology(nullptr),
+      callback(callback),
+      callback_arg(nullptr),
+      multicast_route(std::move(multicast_route)),
+      multicast_callback_args(std::make_shared<const std::vector<CallbackArg>>(std::move(callback_args))),
+      branch_id(-1) {
+    assert(chunk_size > 0);
+    assert(this->multicast_route != nullptr);
+    assert(callback != nullptr);
+    assert(static_cast<int>(multicast_callback_args->size()) == this->multicast_route->get_dests_count());
 
-    // return the first npu in route
-    return route.front();
+    // the chunk sits at the source until replicated
+    const auto first_branch = this->multicast_route->get_src_branches().front();
+    current_device_id = this->multicast_route->get_branch(first_branch).route.front()->get_id();
 }
 
-std::shared_ptr<Device> Chunk::next_device() const noexcept {
+Chunk::Chunk(const Chunk& parent, const int branch_id) noexcept
+    : chunk_size(parent.chunk_size),
+      hop(0),
+      current_device_id(parent.current_device_id),
+      topology(parent.topology),
+      callback(parent.callback),
+      callback_arg(nullptr),
+      multicast_route(parent.multicast_route),
+      multicast_callback_args(parent.multicast_callback_args),
+      branch_id(branch_id) {
+    // the links of the branch are kept alive by the multicast route
+    const auto& branch_links = multicast_route->get_branch(branch_id).links;
+    route = LinkRoute(branch_links.data(), static_cast<int>(branch_links.size()));
+    assert(route.get_hops_count() >= 1);
+}
+
+void Chunk::set_topology(const Topology* const topology) noexcept {
+    assert(topology != nullptr);
+
+    this->topology = topology;
+}
+
+const std::shared_ptr<Device>& Chunk::current_device() const noexcept {
+    // assert the chunk is being sent
+    assert(topology != nullptr);
+
+    // return the device the last traversed link leads to
+    return topology->get_device(current_device_id);
+}
+
+const std::shared_ptr<Device>& Chunk::next_device() const noexcept {
     // assert the chunk has next dest
     assert(!arrived_dest());
+    assert(topology != nullptr);
 
     // return next dest
-    const auto next_dest = std::next(route.begin(), 1);
-    return *next_dest;
+    return topology->get_device(topology->get_link_dest(route.get_link(hop)));
+}
+
+Link* Chunk::next_link() const noexcept {
+    // assert the chunk has next dest
+    assert(!arrived_dest());
+    assert(topology != nullptr);
+
+    // return the next link of the route
+    return topology->get_link(route.get_link(hop));
 }
 
 void Chunk::mark_arrived_next_device() noexcept {
     // if this method is being called,
     // it means the chunk hasn't arrived its final dest yet
     assert(!arrived_dest());
+    assert(topology != nullptr);
 
-    // pop previous node from the route
-    // marking the current node has been changed
-    route.pop_front();
+    // move to the end of the next link
+    current_device_id = topology->get_link_dest(route.get_link(hop));
+    hop++;
 }
 
 bool Chunk::arrived_dest() const noexcept {
-    // if a chunk arrived dest, route length should be 1
-    // i.e., only containing the dest node
-    return route.size() == 1;
+    // if a chunk arrived dest, no link is left in the route
+    return hop == route.get_hops_count();
+}
+
+bool Chunk::next_device_is_dest() const noexcept {
+    // if the next device is the dest, only one link is left in the route
+    return hop + 1 == route.get_hops_count();
+}
+
+bool Chunk::is_multicast() const noexcept {
+    return multicast_route != nullptr;
+}
+
+bool Chunk::arrived_multicast_dest() const noexcept {
+    assert(is_multicast());
+    assert(arrived_dest());
+
+    // the source is never a destination
+    if (branch_id < 0) {
+        return false;
+    }
+    return multicast_route->get_branch(branch_id).dest_index >= 0;
+}
+
+std::vector<std::unique_ptr<Chunk>> Chunk::replicate() const noexcept {
+    assert(is_multicast());
+    assert(arrived_dest());
+
+    // branches leaving the current device
+    const auto& child_branches = (branch_id < 0) ? multicast_route->get_src_branches()
+                                                 : multicast_route->get_branch(branch_id).children;
+
+    auto replicas = std::vector<std::unique_ptr<Chunk>>();
+    replicas.reserve(child_branches.size());
+    for (const auto child_branch : child_branches) {
+        replicas.push_back(std::unique_ptr<Chunk>(new Chunk(*this, child_branch)));
+    }
+    return replicas;
 }
 
 ChunkSize Chunk::get_size() const noexcept {
@@ -81,6 +203,14 @@ ChunkSize Chunk::get_size() const noexcept {
 }
 
 void Chunk::invoke_callback() noexcept {
+    if (is_multicast()) {
+        // invoke callback with the argument of the arrived destination
+        const auto dest_index = multicast_route->get_branch(branch_id).dest_index;
+        assert(0 <= dest_index && dest_index < static_cast<int>(multicast_callback_args->size()));
+        (*callback)((*multicast_callback_args)[dest_index]);
+        return;
+    }
+
     // invoke callback
     (*callback)(callback_arg);
 }
@@ -30,20 +30,38 @@ void Device::send(std::unique_ptr<Chunk> chunk) noexcept {
     // assert the chunk hasn't arrived its final destination yet
     assert(!chunk->arrived_dest());
 
-    // get next dest
-    const auto next_dest = chunk->next_device();
-    const auto next_dest_id = next_dest->get_id();
-
     // assert the next dest is connected to this node
-    assert(connected(next_dest_id));
+    assert(connected(chunk->next_device()->get_id()));
 
     // send the chunk to the next dest
-    // delegate this task to the link
-    links[next_dest_id]->send(std::move(chunk));
+    // delegate this task to the link, found by its id in the route
+    auto* const link = chunk->next_link();
+    link->send(std::move(chunk));
+}
+
+void Device::multicast(std::unique_ptr<Chunk> chunk) noexcept {
+    // assert the validity of the chunk
+    assert(chunk != nullptr);
+    assert(chunk->is_multicast());
+
+    // assert the chunk sits at this node
+    assert(chunk->current_device()->get_id() == device_id);
+    assert(chunk->arrived_dest());
+
+    // send a replica over every branch leaving this node
+    for (auto& replica : chunk->replicate()) {
+        send(std::move(replica));
+    }
+
+    // deliver the chunk if this node is a destination
+    if (chunk->arrived_multicast_dest()) {
+        chunk->invoke_callback();
+    }
 }
 
-void Device::connect(const DeviceId id, const Bandwidth bandwidth, const Latency latency) noexcept {
+void Device::connect(const DeviceId id, const LinkId link_id, const Bandwidth bandwidth, const Latency latency) noexcept {
     assert(id >= 0);
+    assert(link_id >= 0);
     assert(bandwidth > 0);
     assert(latency >= 0);
 
@@ -52,6 +70,17 @@ void Device::connect(const DeviceId id, const Bandwidth bandwidth, const Latency
 
     // create link
     links[id] = std::make_shared<Link>(bandwidth, latency);
+    link_ids[id] = link_id;
+}
+
+LinkId Device::get_link_id(const DeviceId dest) const noexcept {
+    assert(connected(dest));
+
+    return link_ids.at(dest);
+}
+
+const std::map<DeviceId, std::shared_ptr<Link>>& Device::get_links() const noexcept {
+    return links;
 }
 
 bool Device::connected(const DeviceId dest) const noexcept {
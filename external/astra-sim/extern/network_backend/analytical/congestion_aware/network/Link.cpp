@@ -7,13 +7,17 @@ LICENSE file in the root directory of this source tree.
 #include "common/NetworkFunction.h"
 #include "congestion_aware/Chunk.h"
 #include "congestion_aware/Device.h"
+#include <algorithm>
 #include <cassert>
 
 using namespace NetworkAnalytical;
 using namespace NetworkAnalyticalCongestionAware;
 
 // declaring static event_queue
-std::shared_ptr<EventQueue> Link::event_queue;
+thread_local std::shared_ptr<EventQueue> Link::event_queue;
+
+// declaring static stats_bucket_width
+thread_local EventTime Link::stats_bucket_width = 0;
 
 void Link::link_become_free(void* const link_ptr) noexcept {
     assert(link_ptr != nullptr);
@@ -37,11 +41,24 @@ void Link::set_event_queue(std::shared_ptr<EventQueue> event_queue_ptr) noexcept
     Link::event_queue = std::move(event_queue_ptr);
 }
 
+void Link::set_stats_bucket_width(const EventTime bucket_width) noexcept {
+    // set the bucket width
+    Link::stats_bucket_width = bucket_width;
+}
+
+EventTime Link::get_stats_bucket_width() noexcept {
+    return Link::stats_bucket_width;
+}
+
 Link::Link(const Bandwidth bandwidth, const Latency latency) noexcept
     : bandwidth(bandwidth),
       latency(latency),
       pending_chunks(),
-      busy(false) {
+      busy(false),
+      region(nullptr),
+      next_region_id(-1),
+      stats({0, 0, 0, 0, 0.0, {}}),
+      pending_chunks_updated_time(0) {
     assert(bandwidth > 0);
     assert(latency >= 0);
 
@@ -49,12 +66,45 @@ Link::Link(const Bandwidth bandwidth, const Latency latency) noexcept
     bandwidth_Bpns = bw_GBps_to_Bpns(bandwidth);
 }
 
+void Link::bind_region(SimulationRegion* const region, const int next_region_id) noexcept {
+    assert(region != nullptr);
+    assert(next_region_id >= 0);
+
+    // link events are scheduled to the simulation regions from now on
+    this->region = region;
+    this->next_region_id = next_region_id;
+}
+
+Bandwidth Link::get_bandwidth() const noexcept {
+    assert(bandwidth > 0);
+
+    return bandwidth;
+}
+
+Latency Link::get_latency() const noexcept {
+    assert(latency >= 0);
+
+    return latency;
+}
+
+LinkStats Link::get_stats(const EventTime end_time) const noexcept {
+    assert(end_time >= pending_chunks_updated_time);
+
+    // close the pending chunks integral at the end time
+    auto link_stats = stats;
+    const auto elapsed_time = static_cast<double>(end_time - pending_chunks_updated_time);
+    link_stats.pending_chunks_time += static_cast<double>(pending_chunks.size()) * elapsed_time;
+    return link_stats;
+}
+
 void Link::send(std::unique_ptr<Chunk> chunk) noexcept {
     assert(chunk != nullptr);
 
     if (busy) {
         // link is busy, add to pending chunks
+        update_pending_chunks_time(current_time());
         pending_chunks.push_back(std::move(chunk));
+        stats.max_pending_chunks = std::max<uint64_t>(stats.max_pending_chunks, pending_chunks.size());
     } else {
         // service this chunk immediately
         schedule_chunk_transmission(std::move(chunk));
@@ -66,6 +116,7 @@ void Link::process_pending_transmission() noexcept {
     assert(pending_chunk_exists());
 
     // get chunk to process
+    update_pending_chunks_time(current_time());
     auto chunk = std::move(pending_chunks.front());
     pending_chunks.pop_front();
 
@@ -78,6 +129,10 @@ bool Link::pending_chunk_exists() const noexcept {
     return !pending_chunks.empty();
 }
 
+int Link::get_pending_chunks_count() const noexcept {
+    return static_cast<int>(pending_chunks.size());
+}
+
 void Link::set_busy() noexcept {
     // set busy to true
     busy = true;
@@ -119,17 +174,94 @@ void Link::schedule_chunk_transmission(std::unique_ptr<Chunk> chunk) noexcept {
 
     // get metadata
     const auto chunk_size = chunk->get_size();
-    const auto current_time = Link::event_queue->get_current_time();
+    const auto communication_time = communication_delay(chunk_size);
+    const auto serialization_time = serialization_delay(chunk_size);
+    const auto start_time = current_time();
+    record_transmission(chunk_size, start_time, serialization_time);
+
+    // parallel simulation: schedule events to the simulation regions
+    if (region != nullptr) {
+        schedule_region_events(std::move(chunk), communication_time, serialization_time);
+        return;
+    }
 
     // schedule chunk arrival event
-    const auto communication_time = communication_delay(chunk_size);
-    const auto chunk_arrival_time = current_time + communication_time;
+    const auto chunk_arrival_time = start_time + communication_time;
     auto* const chunk_ptr = static_cast<void*>(chunk.release());
     Link::event_queue->schedule_event(chunk_arrival_time, Chunk::chunk_arrived_next_device, chunk_ptr);
 
     // schedule link free time
-    const auto serialization_time = serialization_delay(chunk_size);
-    const auto link_free_time = current_time + serialization_time;
+    const auto link_free_time = start_time + serialization_time;
     auto* const link_ptr = static_cast<void*>(this);
     Link::event_queue->schedule_event(link_free_time, link_become_free, link_ptr);
 }
+
+void Link::schedule_region_events(std::unique_ptr<Chunk> chunk,
+                                  const EventTime communication_time,
+                                  const EventTime serialization_time) noexcept {
+    assert(chunk != nullptr);
+    assert(region != nullptr);
+
+    // schedule chunk arrival event
+    const auto current_time = region->get_current_time();
+    const auto chunk_arrival_time = current_time + communication_time;
+    const auto arriving_dest = chunk->next_device_is_dest();
+    auto* const chunk_ptr = static_cast<void*>(chunk.release());
+    if (arriving_dest) {
+        // destination callback runs in the sequential part of the simulation
+        region->post_sequential_event(chunk_arrival_time, Chunk::chunk_arrived_next_device, chunk_ptr);
+    } else {
+        region->post_event(next_region_id, chunk_arrival_time, Chunk::chunk_arrived_next_device, chunk_ptr);
+    }
+
+    // schedule link free time
+    const auto link_free_time = current_time + serialization_time;
+    auto* const link_ptr = static_cast<void*>(this);
+    region->schedule_event(link_free_time, link_become_free, link_ptr);
+}
+
+EventTime Link::current_time() const noexcept {
+    // parallel simulation: time of the simulation region
+    if (region != nullptr) {
+        return region->get_current_time();
+    }
+
+    return Link::event_queue->get_current_time();
+}
+
+void Link::update_pending_chunks_time(const EventTime time) noexcept {
+    assert(time >= pending_chunks_updated_time);
+
+    // accumulate (number of pending chunks) * (elapsed time)
+    const auto elapsed_time = static_cast<double>(time - pending_chunks_updated_time);
+    stats.pending_chunks_time += static_cast<double>(pending_chunks.size()) * elapsed_time;
+    pending_chunks_updated_time = time;
+}
+
+void Link::record_transmission(const ChunkSize chunk_size,
+                               const EventTime start_time,
+                               const EventTime serialization_time) noexcept {
+    // update counters
+    stats.bytes += chunk_size;
+    stats.chunks_count++;
+    stats.busy_time += serialization_time;
+
+    if (Link::stats_bucket_width == 0) {
+        return;
+    }
+
+    // split the busy interval over the time buckets it overlaps
+    const auto end_time = start_time + serialization_time;
+    auto bucket = start_time / Link::stats_bucket_width;
+    auto time = start_time;
+    while (time < end_time) {
+        const auto bucket_end_time = (bucket + 1) * Link::stats_bucket_width;
+        const auto busy_until = std::min(end_time, bucket_end_time);
+        if (stats.bucket_busy_time.size() <= bucket) {
+            stats.bucket_busy_time.resize(bucket + 1, 0);
+        }
+        stats.bucket_busy_time[bucket] += busy_until - time;
+        time = busy_until;
+        bucket++;
+    }
+}
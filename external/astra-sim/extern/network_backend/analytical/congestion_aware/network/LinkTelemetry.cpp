@@ -0,0 +1,132 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include "congestion_aware/LinkTelemetry.h"
+#include "congestion_aware/Device.h"
+#include "congestion_aware/Link.h"
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+
+using namespace NetworkAnalyticalCongestionAware;
+
+namespace {
+
+/// magic header identifying a link telemetry file
+constexpr char telemetry_magic[8] = {'L', 'I', 'N', 'K', 'S', 'T', 'A', 'T'};
+
+/// write a value in its in-memory representation
+template <typename T>
+void write_value(std::ofstream& file, const T value) noexcept {
+    file.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+}  // namespace
+
+LinkTelemetry::LinkTelemetry(const Topology& topology, const EventTime end_time) noexcept
+    : end_time(end_time),
+      bucket_width(Link::get_stats_bucket_width()),
+      buckets_count(0) {
+    // collect the counters of every link
+    for (auto src = 0; src < topology.get_devices_count(); src++) {
+        for (const auto& [dest, link] : topology.get_device(src)->get_links()) {
+            auto record = LinkRecord{src, dest, topology.link_coordinate(src, dest), link->get_stats(end_time)};
+            buckets_count = std::max(buckets_count, record.stats.bucket_busy_time.size());
+            records.push_back(std::move(record));
+        }
+    }
+}
+
+const std::vector<LinkTelemetry::LinkRecord>& LinkTelemetry::get_records() const noexcept {
+    return records;
+}
+
+void LinkTelemetry::dump(const std::string& path) const noexcept {
+    // choose the format by the file extension
+    const auto binary_extension = std::string(".bin");
+    if (path.size() >= binary_extension.size() &&
+        path.compare(path.size() - binary_extension.size(), binary_extension.size(), binary_extension) == 0) {
+        dump_binary(path);
+    } else {
+        dump_csv(path);
+    }
+}
+
+double LinkTelemetry::bucket_utilization(const LinkRecord& record, const size_t bucket) const noexcept {
+    assert(bucket_width > 0);
+    assert(bucket < buckets_count);
+
+    // links idle until the end have fewer buckets
+    if (bucket >= record.stats.bucket_busy_time.size()) {
+        return 0.0;
+    }
+    return static_cast<double>(record.stats.bucket_busy_time[bucket]) / static_cast<double>(bucket_width);
+}
+
+void LinkTelemetry::dump_csv(const std::string& path) const noexcept {
+    auto file = std::ofstream(path, std::ios::trunc);
+    if (!file) {
+        std::cerr << "[Error] (network/analytical) cannot create link telemetry: " << path << std::endl;
+        std::exit(-1);
+    }
+
+    // header
+    file << "src,dest,row,col,direction,bytes,chunks,busy_ns,utilization,max_pending,mean_pending";
+    for (auto bucket = size_t{0}; bucket < buckets_count; bucket++) {
+        file << ",bucket_" << bucket;
+    }
+    file << '\n';
+
+    // one row per link
+    const auto duration = static_cast<double>(std::max<EventTime>(end_time, 1));
+    for (const auto& record : records) {
+        const auto& stats = record.stats;
+        file << record.src << ',' << record.dest << ',' << record.coordinate.row << ',' << record.coordinate.col
+             << ',' << record.coordinate.direction << ',' << stats.bytes << ',' << stats.chunks_count << ','
+             << stats.busy_time << ',' << static_cast<double>(stats.busy_time) / duration << ','
+             << stats.max_pending_chunks << ',' << stats.pending_chunks_time / duration;
+        for (auto bucket = size_t{0}; bucket < buckets_count; bucket++) {
+            file << ',' << bucket_utilization(record, bucket);
+        }
+        file << '\n';
+    }
+}
+
+void LinkTelemetry::dump_binary(const std::string& path) const noexcept {
+    auto file = std::ofstream(path, std::ios::binary | std::ios::trunc);
+    if (!file) {
+        std::cerr << "[Error] (network/analytical) cannot create link telemetry: " << path << std::endl;
+        std::exit(-1);
+    }
+
+    // header
+    file.write(telemetry_magic, sizeof(telemetry_magic));
+    write_value(file, static_cast<uint32_t>(records.size()));
+    write_value(file, static_cast<uint32_t>(buckets_count));
+    write_value(file, static_cast<uint64_t>(bucket_width));
+    write_value(file, static_cast<uint64_t>(end_time));
+
+    // one record per link
+    const auto duration = static_cast<double>(std::max<EventTime>(end_time, 1));
+    for (const auto& record : records) {
+        const auto& stats = record.stats;
+        write_value(file, static_cast<int32_t>(record.src));
+        write_value(file, static_cast<int32_t>(record.dest));
+        write_value(file, static_cast<int32_t>(record.coordinate.row));
+        write_value(file, static_cast<int32_t>(record.coordinate.col));
+        write_value(file, static_cast<uint8_t>(record.coordinate.direction));
+        write_value(file, static_cast<uint64_t>(stats.bytes));
+        write_value(file, static_cast<uint64_t>(stats.chunks_count));
+        write_value(file, static_cast<uint64_t>(stats.busy_time));
+        write_value(file, static_cast<uint64_t>(stats.max_pending_chunks));
+        write_value(file, stats.pending_chunks_time / duration);
+        for (auto bucket = size_t{0}; bucket < buckets_count; bucket++) {
+            write_value(file, static_cast<float>(bucket_utilization(record, bucket)));
+        }
+    }
+}
@@ -0,0 +1,336 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include "congestion_aware/ParallelSimulator.h"
+#include "congestion_aware/Device.h"
+#include "congestion_aware/Link.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <limits>
+
+using namespace NetworkAnalyticalCongestionAware;
+
+ParallelSimulator::ParallelSimulator(std::shared_ptr<Topology> topology,
+                                     std::shared_ptr<EventQueue> event_queue,
+                                     const int threads_count) noexcept
+    : topology(std::move(topology)),
+      event_queue(std::move(event_queue)),
+      lookahead(0),
+      window_buffer(0),
+      next_event_order(1),
+      sequential_scheduler(nullptr),
+      command(Command::RunWindow),
+      window_end(0),
+      arrived_count(0),
+      barrier_generation(0) {
+    assert(this->topology != nullptr);
+    assert(this->event_queue != nullptr);
+
+    if (threads_count <= 0) {
+        std::cerr << "[Error] (network/analytical) " << "number of parallel simulation threads (" << threads_count
+                  << ") should be positive" << std::endl;
+        std::exit(-1);
+    }
+
+    // create regions, at most one per device
+    const auto regions_count = std::min(threads_count, this->topology->get_devices_count());
+    for (auto i = 0; i < regions_count; i++) {
+        regions.push_back(std::make_unique<SimulationRegion>(i, regions_count));
+    }
+
+    // assign links to regions
+    bind_links();
+
+    // the sequential part posts into the buffer received by the first window
+    for (const auto& region : regions) {
+        region->set_outbox_buffer(1 - window_buffer);
+    }
+
+    // events scheduled so far are ordered as scheduled by the root (order 0),
+    // and the event queue invokes its events through the sequential scheduler from now on
+    SimulationRegion::begin_invocation(this->event_queue->get_current_time(), 0);
+    auto scheduler = std::make_unique<SequentialScheduler>(regions, next_event_order);
+    sequential_scheduler = scheduler.get();
+    original_scheduler = this->event_queue->replace_scheduler(std::move(scheduler));
+}
+
+ParallelSimulator::~ParallelSimulator() noexcept {
+    // worker threads are joined by run()
+    assert(workers.empty());
+
+    // region events cannot be invoked without the regions
+    assert(next_region_event_time() == SimulationRegion::no_event);
+
+    // hand the remaining events back to the original scheduler
+    event_queue->replace_scheduler(std::move(original_scheduler));
+}
+
+void ParallelSimulator::run() noexcept {
+    // launch region threads
+    const auto regions_count = static_cast<int>(regions.size());
+    const auto stats_bucket_width = Link::get_stats_bucket_width();
+    for (auto i = 1; i < regions_count; i++) {
+        workers.emplace_back(&ParallelSimulator::run_worker, this, i, stats_bucket_width);
+    }
+
+    while (true) {
+        collect_sequential_events();
+
+        // earliest pending events of both parts
+        const auto region_time = next_region_event_time();
+        const auto sequential_time = sequential_scheduler->next_sequential_event_time();
+
+        // no event left
+        if (region_time == SimulationRegion::no_event && sequential_time == SimulationRegion::no_event) {
+            break;
+        }
+
+        if (region_time < sequential_time) {
+            // regions run up to the lookahead, and at most up to the next sequential event
+            window_end = std::min(region_time + lookahead, sequential_time);
+            run_parallel_window();
+        } else {
+            // region events of the same time are interleaved with the sequential ones
+            run_sequential_step();
+        }
+    }
+
+    // stop region threads
+    command = Command::Stop;
+    wait_barrier();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    workers.clear();
+
+    // events scheduled from now on are ordered after every invoked event
+    SimulationRegion::begin_invocation(event_queue->get_current_time(), next_event_order++);
+}
+
+int ParallelSimulator::get_regions_count() const noexcept {
+    return static_cast<int>(regions.size());
+}
+
+EventTime ParallelSimulator::get_lookahead() const noexcept {
+    assert(lookahead > 0);
+
+    return lookahead;
+}
+
+void ParallelSimulator::bind_links() noexcept {
+    const auto regions_count = static_cast<int>(regions.size());
+    const auto devices_count = topology->get_devices_count();
+    const auto region_ids = topology->partition_devices(regions_count);
+    assert(static_cast<int>(region_ids.size()) == devices_count);
+
+    auto min_latency = std::numeric_limits<Latency>::max();
+    for (auto src = 0; src < devices_count; src++) {
+        const auto src_region = region_ids[src];
+        assert(0 <= src_region && src_region < regions_count);
+
+        for (const auto& [dest, link] : topology->get_device(src)->get_links()) {
+            link->bind_region(regions[src_region].get(), region_ids[dest]);
+            min_latency = std::min(min_latency, link->get_latency());
+        }
+    }
+
+    // chunks take at least the link latency to reach the next device
+    lookahead = static_cast<EventTime>(std::floor(min_latency));
+    if (lookahead < 1) {
+        std::cerr << "[Error] (network/analytical) " << "parallel simulation requires link latency of at least 1 ns "
+                  << "as lookahead (got " << min_latency << " ns)" << std::endl;
+        std::exit(-1);
+    }
+}
+
+void ParallelSimulator::collect_sequential_events() noexcept {
+    for (const auto& region : regions) {
+        for (const auto& event : region->take_sequential_events()) {
+            sequential_scheduler->schedule_posted_event(event);
+        }
+    }
+}
+
+EventTime ParallelSimulator::next_region_event_time() const noexcept {
+    auto next_time = SimulationRegion::no_event;
+
+    // pending events, and events to be received by the next window
+    for (const auto& region : regions) {
+        next_time = std::min(next_time, region->next_event_time());
+        next_time = std::min(next_time, region->get_outbox_time(1 - window_buffer));
+    }
+
+    return next_time;
+}
+
+void ParallelSimulator::run_sequential_step() noexcept {
+    // receive the events posted by the last window, which may be due at the next event time
+    for (const auto& region : regions) {
+        region->receive_events(regions, 1 - window_buffer);
+    }
+    for (const auto& region : regions) {
+        region->clear_outbox_time(1 - window_buffer);
+    }
+
+    // regions have invoked every event before the next event time
+    const auto event_time = event_queue->get_next_event_time();
+    for (const auto& region : regions) {
+        region->set_current_time(event_time);
+    }
+
+    // invoke the events of this time through the sequential scheduler
+    event_queue->proceed();
+}
+
+void ParallelSimulator::run_parallel_window() noexcept {
+    // regions post into the buffer not being received
+    for (const auto& region : regions) {
+        region->set_outbox_buffer(window_buffer);
+    }
+
+    // run the window, region 0 on this thread
+    command = Command::RunWindow;
+    wait_barrier();
+    regions[0]->run_window(regions, 1 - window_buffer, window_end);
+    wait_barrier();
+
+    // order the events invoked by the window, and resolve their orders on all region threads
+    next_event_order = SimulationRegion::order_window(regions, next_event_order);
+    command = Command::ResolveWindow;
+    wait_barrier();
+    regions[0]->resolve_window();
+    wait_barrier();
+
+    // the received buffer is drained: swap buffers
+    for (const auto& region : regions) {
+        region->clear_outbox_time(1 - window_buffer);
+    }
+    window_buffer = 1 - window_buffer;
+
+    // the sequential part posts into the buffer received by the next window
+    for (const auto& region : regions) {
+        region->set_outbox_buffer(1 - window_buffer);
+    }
+}
+
+void ParallelSimulator::run_worker(const int region_id, const EventTime stats_bucket_width) noexcept {
+    assert(0 < region_id && region_id < static_cast<int>(regions.size()));
+
+    // links of this region record their utilization on this thread
+    Link::set_stats_bucket_width(stats_bucket_width);
+
+    while (true) {
+        // wait for the next command
+        wait_barrier();
+        if (command == Command::Stop) {
+            return;
+        }
+
+        if (command == Command::RunWindow) {
+            regions[region_id]->run_window(regions, 1 - window_buffer, window_end);
+        } else {
+            regions[region_id]->resolve_window();
+        }
+        wait_barrier();
+    }
+}
+
+void ParallelSimulator::wait_barrier() noexcept {
+    const auto threads_count = static_cast<int>(regions.size());
+    const auto generation = barrier_generation.load(std::memory_order_acquire);
+
+    // the last thread to arrive releases the others
+    if (arrived_count.fetch_add(1, std::memory_order_acq_rel) + 1 == threads_count) {
+        arrived_count.store(0, std::memory_order_relaxed);
+        barrier_generation.fetch_add(1, std::memory_order_release);
+        return;
+    }
+
+    // spin shortly, then yield the core
+    auto spins = 0;
+    while (barrier_generation.load(std::memory_order_acquire) == generation) {
+        if (++spins > 1024) {
+            std::this_thread::yield();
+        }
+    }
+}
+
+ParallelSimulator::SequentialScheduler::SequentialScheduler(
+    const std::vector<std::unique_ptr<SimulationRegion>>& regions,
+    SimulationRegion::EventOrder& next_event_order) noexcept
+    : regions(regions),
+      next_event_order(next_event_order) {}
+
+bool ParallelSimulator::SequentialScheduler::empty() const noexcept {
+    if (!events.empty()) {
+        return false;
+    }
+
+    return std::all_of(regions.begin(), regions.end(), [](const auto& region) noexcept {
+        return region->next_event_time() == SimulationRegion::no_event;
+    });
+}
+
+EventTime ParallelSimulator::SequentialScheduler::next_event_time() noexcept {
+    assert(!empty());
+
+    auto next_time = next_sequential_event_time();
+    for (const auto& region : regions) {
+        next_time = std::min(next_time, region->next_event_time());
+    }
+    return next_time;
+}
+
+void ParallelSimulator::SequentialScheduler::schedule(const EventTime event_time,
+                                                      const Callback callback,
+                                                      const CallbackArg callback_arg) noexcept {
+    assert(callback != nullptr);
+
+    schedule_posted_event({SimulationRegion::make_event_key(event_time), callback, callback_arg});
+}
+
+Event ParallelSimulator::SequentialScheduler::pop() noexcept {
+    assert(!empty());
+
+    // find the earliest event among this scheduler and the regions
+    const SimulationRegion::EventKey* next_key = events.empty() ? nullptr : &events.front().key;
+    SimulationRegion* next_region = nullptr;
+    for (const auto& region : regions) {
+        if (region->next_event_time() == SimulationRegion::no_event) {
+            continue;
+        }
+        const auto& key = region->get_next_event_key();
+        if (next_key == nullptr || SimulationRegion::precedes(key, *next_key)) {
+            next_key = &key;
+            next_region = region.get();
+        }
+    }
+
+    // dequeue it
+    auto event = SimulationRegion::RegionEvent();
+    if (next_region != nullptr) {
+        event = next_region->take_next_event();
+    } else {
+        std::pop_heap(events.begin(), events.end(), SimulationRegion::later);
+        event = events.back();
+        events.pop_back();
+    }
+
+    // events scheduled by its callback are ordered as its children
+    SimulationRegion::begin_invocation(event.key.event_time, next_event_order++);
+    return Event(event.callback, event.callback_arg);
+}
+
+void ParallelSimulator::SequentialScheduler::schedule_posted_event(const SimulationRegion::RegionEvent& event) noexcept {
+    events.push_back(event);
+    std::push_heap(events.begin(), events.end(), SimulationRegion::later);
+}
+
+EventTime ParallelSimulator::SequentialScheduler::next_sequential_event_time() const noexcept {
+    return events.empty() ? SimulationRegion::no_event : events.front().key.event_time;
+}
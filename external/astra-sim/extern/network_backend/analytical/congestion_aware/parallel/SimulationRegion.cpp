@@ -0,0 +1,258 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include "congestion_aware/SimulationRegion.h"
+#include <algorithm>
+#include <cassert>
+#include <queue>
+
+using namespace NetworkAnalyticalCongestionAware;
+
+// declaring static invocation context
+thread_local EventTime SimulationRegion::invocation_time = 0;
+thread_local SimulationRegion::EventOrder SimulationRegion::invocation_order = 0;
+thread_local uint64_t SimulationRegion::invocation_children_count = 0;
+
+void SimulationRegion::begin_invocation(const EventTime event_time, const EventOrder event_order) noexcept {
+    invocation_time = event_time;
+    invocation_order = event_order;
+    invocation_children_count = 0;
+}
+
+SimulationRegion::EventKey SimulationRegion::make_event_key(const EventTime event_time) noexcept {
+    assert(event_time >= invocation_time);
+
+    // events scheduled by the same invocation keep their schedule order
+    return {event_time, invocation_time, invocation_order, invocation_children_count++};
+}
+
+bool SimulationRegion::precedes(const EventKey& lhs, const EventKey& rhs) noexcept {
+    if (lhs.event_time != rhs.event_time) {
+        return lhs.event_time < rhs.event_time;
+    }
+    if (lhs.schedule_time != rhs.schedule_time) {
+        return lhs.schedule_time < rhs.schedule_time;
+    }
+    if (lhs.parent_order != rhs.parent_order) {
+        return lhs.parent_order < rhs.parent_order;
+    }
+    return lhs.child_index < rhs.child_index;
+}
+
+bool SimulationRegion::later(const RegionEvent& lhs, const RegionEvent& rhs) noexcept {
+    return precedes(rhs.key, lhs.key);
+}
+
+SimulationRegion::EventOrder SimulationRegion::order_window(
+    const std::vector<std::unique_ptr<SimulationRegion>>& regions,
+    const EventOrder first_order) noexcept {
+    // head of the window of a region: (key with its parent order resolved, region id)
+    using WindowHead = std::pair<EventKey, int>;
+    const auto later_head = [](const WindowHead& lhs, const WindowHead& rhs) noexcept {
+        return precedes(rhs.first, lhs.first);
+    };
+    auto heads = std::priority_queue<WindowHead, std::vector<WindowHead>, decltype(later_head)>(later_head);
+
+    // the parent of an event invoked during the window was invoked before it by the same region,
+    // hence it is already ordered when the event becomes the head of its region
+    const auto push_head = [&heads, &regions](const int region_id) noexcept {
+        const auto& region = regions[region_id];
+        const auto index = region->window_orders.size();
+        if (index < region->window_events.size()) {
+            auto key = region->window_events[index];
+            key.parent_order = region->resolve_order(key.parent_order);
+            heads.emplace(key, region_id);
+        }
+    };
+
+    // merge the windows of all regions
+    for (auto i = 0; i < static_cast<int>(regions.size()); i++) {
+        regions[i]->window_orders.clear();
+        push_head(i);
+    }
+    auto next_order = first_order;
+    while (!heads.empty()) {
+        const auto region_id = heads.top().second;
+        heads.pop();
+
+        regions[region_id]->window_orders.push_back(next_order++);
+        push_head(region_id);
+    }
+
+    return next_order;
+}
+
+SimulationRegion::SimulationRegion(const int region_id, const int regions_count) noexcept
+    : region_id(region_id),
+      current_time(0),
+      outbox_times{no_event, no_event},
+      outbox_buffer(0) {
+    assert(0 <= region_id && region_id < regions_count);
+
+    // create empty outboxes
+    for (auto& outbox : outboxes) {
+        outbox = std::vector<std::vector<RegionEvent>>(regions_count);
+    }
+}
+
+EventTime SimulationRegion::get_current_time() const noexcept {
+    return current_time;
+}
+
+void SimulationRegion::set_current_time(const EventTime event_time) noexcept {
+    assert(event_time >= current_time);
+
+    current_time = event_time;
+}
+
+void SimulationRegion::schedule_event(const EventTime event_time,
+                                      const Callback callback,
+                                      const CallbackArg callback_arg) noexcept {
+    assert(event_time >= current_time);
+    assert(callback != nullptr);
+
+    // push the event into the heap
+    events.push_back({make_event_key(event_time), callback, callback_arg});
+    std::push_heap(events.begin(), events.end(), later);
+}
+
+void SimulationRegion::post_event(const int region_id,
+                                  const EventTime event_time,
+                                  const Callback callback,
+                                  const CallbackArg callback_arg) noexcept {
+    assert(0 <= region_id && region_id < static_cast<int>(outboxes[outbox_buffer].size()));
+
+    // event of this region: schedule directly
+    if (region_id == this->region_id) {
+        schedule_event(event_time, callback, callback_arg);
+        return;
+    }
+
+    // buffer the event until the next synchronization
+    assert(callback != nullptr);
+    outboxes[outbox_buffer][region_id].push_back({make_event_key(event_time), callback, callback_arg});
+    outbox_times[outbox_buffer] = std::min(outbox_times[outbox_buffer], event_time);
+}
+
+void SimulationRegion::post_sequential_event(const EventTime event_time,
+                                             const Callback callback,
+                                             const CallbackArg callback_arg) noexcept {
+    assert(event_time >= current_time);
+    assert(callback != nullptr);
+
+    sequential_events.push_back({make_event_key(event_time), callback, callback_arg});
+}
+
+void SimulationRegion::set_outbox_buffer(const int buffer) noexcept {
+    assert(buffer == 0 || buffer == 1);
+
+    outbox_buffer = buffer;
+}
+
+EventTime SimulationRegion::get_outbox_time(const int buffer) const noexcept {
+    assert(buffer == 0 || buffer == 1);
+
+    return outbox_times[buffer];
+}
+
+void SimulationRegion::clear_outbox_time(const int buffer) noexcept {
+    assert(buffer == 0 || buffer == 1);
+
+    outbox_times[buffer] = no_event;
+}
+
+EventTime SimulationRegion::next_event_time() const noexcept {
+    // heap front holds the earliest event
+    return events.empty() ? no_event : events.front().key.event_time;
+}
+
+const SimulationRegion::EventKey& SimulationRegion::get_next_event_key() const noexcept {
+    assert(!events.empty());
+
+    return events.front().key;
+}
+
+SimulationRegion::RegionEvent SimulationRegion::take_next_event() noexcept {
+    assert(!events.empty());
+
+    std::pop_heap(events.begin(), events.end(), later);
+    const auto event = events.back();
+    events.pop_back();
+
+    current_time = event.key.event_time;
+    return event;
+}
+
+std::vector<SimulationRegion::RegionEvent> SimulationRegion::take_sequential_events() noexcept {
+    auto taken = std::vector<RegionEvent>();
+    taken.swap(sequential_events);
+    return taken;
+}
+
+void SimulationRegion::receive_events(const std::vector<std::unique_ptr<SimulationRegion>>& regions,
+                                      const int buffer) noexcept {
+    assert(buffer == 0 || buffer == 1);
+
+    // receive events other regions posted to this region, keeping their keys
+    for (const auto& region : regions) {
+        auto& inbox = region->outboxes[buffer][region_id];
+        for (const auto& event : inbox) {
+            assert(event.key.event_time >= current_time);
+            events.push_back(event);
+            std::push_heap(events.begin(), events.end(), later);
+        }
+        inbox.clear();
+    }
+}
+
+void SimulationRegion::run_window(const std::vector<std::unique_ptr<SimulationRegion>>& regions,
+                                  const int buffer,
+                                  const EventTime window_end) noexcept {
+    receive_events(regions, buffer);
+
+    // invoke events inside the window in the sequential invocation order,
+    // numbering them provisionally by their index in the window
+    assert(window_events.empty());
+    while (!events.empty() && events.front().key.event_time < window_end) {
+        const auto event = take_next_event();
+
+        begin_invocation(event.key.event_time, provisional_order | window_events.size());
+        window_events.push_back(event.key);
+        (*event.callback)(event.callback_arg);
+    }
+}
+
+void SimulationRegion::resolve_window() noexcept {
+    assert(window_orders.size() == window_events.size());
+
+    const auto resolve = [this](std::vector<RegionEvent>& region_events) noexcept {
+        for (auto& event : region_events) {
+            event.key.parent_order = resolve_order(event.key.parent_order);
+        }
+    };
+
+    // resolution keeps the heap ordered: it preserves the order of the events invoked during the window,
+    // which are the only ones scheduled at the times of the window
+    resolve(events);
+    for (auto& outbox : outboxes) {
+        for (auto& region_events : outbox) {
+            resolve(region_events);
+        }
+    }
+    resolve(sequential_events);
+
+    window_events.clear();
+    window_orders.clear();
+}
+
+SimulationRegion::EventOrder SimulationRegion::resolve_order(const EventOrder event_order) const noexcept {
+    if ((event_order & provisional_order) == 0) {
+        return event_order;
+    }
+
+    const auto index = event_order & ~provisional_order;
+    assert(index < window_orders.size());
+    return window_orders[index];
+}
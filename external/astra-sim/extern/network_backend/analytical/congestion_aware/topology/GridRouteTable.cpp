@@ -0,0 +1,198 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include "congestion_aware/GridRouteTable.h"
+#include "congestion_aware/Device.h"
+#include "congestion_aware/Link.h"
+#include "congestion_aware/Topology.h"
+#include <cassert>
+#include <cstdlib>
+
+using namespace NetworkAnalyticalCongestionAware;
+
+namespace {
+
+/// number of steps and direction moving from src to dest along a dimension
+struct Steps {
+    /// number of links to traverse
+    int count;
+
+    /// true if moving towards higher coordinates (South/East)
+    bool positive;
+};
+
+Steps steps_between(const int src, const int dest, const int bound, const bool wrap_around) noexcept {
+    const auto diff = dest - src;
+    if (!wrap_around) {
+        return {std::abs(diff), diff >= 0};
+    }
+
+    // shortest way around the ring, positive direction on ties
+    const auto forward = (diff >= 0) ? diff : diff + bound;
+    const auto backward = bound - forward;
+    if (forward <= backward) {
+        return {forward, true};
+    }
+    return {backward, false};
+}
+
+/// splitmix64 finalizer
+uint64_t mix(uint64_t value) noexcept {
+    value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    value = (value ^ (value >> 27)) * 0x94d049bb133111ebULL;
+    return value ^ (value >> 31);
+}
+
+bool o1turn_rows_first(const DeviceId src, const DeviceId dest, const uint64_t sequence) noexcept {
+    const auto pair = (static_cast<uint64_t>(static_cast<uint32_t>(src)) << 32) | static_cast<uint32_t>(dest);
+    return (mix(mix(sequence + 0x9e3779b97f4a7c15ULL) ^ pair) & 1) == 0;
+}
+
+}  // namespace
+
+GridRouteTable::GridRouteTable(const Topology& topology,
+                               const int rows,
+                               const int cols,
+                               const bool wrap_around,
+                               const RoutingPolicy routing_policy) noexcept
+    : topology(&topology),
+      rows(rows),
+      cols(cols),
+      wrap_around(wrap_around),
+      routing_policy(routing_policy) {
+    assert(rows > 0);
+    assert(cols > 0);
+
+    // South/North lines per column, East/West lines per row, each stored twice
+    line_offsets[South] = 0;
+    line_offsets[North] = line_offsets[South] + cols * 2 * rows;
+    line_offsets[East] = line_offsets[North] + cols * 2 * rows;
+    line_offsets[West] = line_offsets[East] + rows * 2 * cols;
+    links.assign(line_offsets[West] + rows * 2 * cols, -1);
+
+    // id of the link from (row, col) to its neighbor, -1 if not connected
+    const auto link_between = [&](const int row, const int col, const int next_row, const int next_col) {
+        if (next_row < 0 || next_row >= rows || next_col < 0 || next_col >= cols) {
+            if (!wrap_around) {
+                return -1;
+            }
+        }
+        const auto src = row * cols + col;
+        const auto dest = ((next_row + rows) % rows) * cols + ((next_col + cols) % cols);
+        const auto& device = topology.get_device(src);
+        if (device->get_links().count(dest) == 0) {
+            return -1;
+        }
+        return device->get_link_id(dest);
+    };
+
+    for (auto col = 0; col < cols; col++) {
+        for (auto index = 0; index < 2 * rows; index++) {
+            // South line starts at row 0, North line starts at the last row
+            const auto south_row = index % rows;
+            const auto north_row = rows - 1 - south_row;
+            links[line_offsets[South] + col * 2 * rows + index] = link_between(south_row, col, south_row + 1, col);
+            links[line_offsets[North] + col * 2 * rows + index] = link_between(north_row, col, north_row - 1, col);
+        }
+    }
+    for (auto row = 0; row < rows; row++) {
+        for (auto index = 0; index < 2 * cols; index++) {
+            // East line starts at column 0, West line starts at the last column
+            const auto east_col = index % cols;
+            const auto west_col = cols - 1 - east_col;
+            links[line_offsets[East] + row * 2 * cols + index] = link_between(row, east_col, row, east_col + 1);
+            links[line_offsets[West] + row * 2 * cols + index] = link_between(row, west_col, row, west_col - 1);
+        }
+    }
+}
+
+LinkRoute GridRouteTable::route(const DeviceId src, const DeviceId dest, const uint64_t sequence) const noexcept {
+    switch (routing_policy) {
+    case RoutingPolicy::XY:
+        return dimension_order_route(src, dest, true);
+    case RoutingPolicy::YX:
+        return dimension_order_route(src, dest, false);
+    case RoutingPolicy::O1Turn:
+        return dimension_order_route(src, dest, o1turn_rows_first(src, dest, sequence));
+    case RoutingPolicy::Adaptive: {
+        // both dimension orders are minimal: take the less congested one, XY on ties
+        const auto xy_route = dimension_order_route(src, dest, true);
+        const auto yx_route = dimension_order_route(src, dest, false);
+        if (pending_chunks_count(yx_route) < pending_chunks_count(xy_route)) {
+            return yx_route;
+        }
+        return xy_route;
+    }
+    default:
+        assert(false);
+        return {};
+    }
+}
+
+LinkRoute GridRouteTable::tree_route(const DeviceId src, const DeviceId dest) const noexcept {
+    return dimension_order_route(src, dest, routing_policy != RoutingPolicy::YX);
+}
+
+LinkRoute GridRouteTable::dimension_order_route(const DeviceId src, const DeviceId dest, const bool rows_first) const
+    noexcept {
+    assert(0 <= src && src < rows * cols);
+    assert(0 <= dest && dest < rows * cols);
+
+    const auto src_row = src / cols;
+    const auto src_col = src % cols;
+    const auto dest_row = dest / cols;
+    const auto dest_col = dest % cols;
+
+    if (rows_first) {
+        // vertical in the src column, then horizontal in the dest row
+        const auto first = row_segment(src_col, src_row, dest_row);
+        const auto second = col_segment(dest_row, src_col, dest_col);
+        return {first.links, first.links_count, second.links, second.links_count};
+    }
+
+    // horizontal in the src row, then vertical in the dest column
+    const auto first = col_segment(src_row, src_col, dest_col);
+    const auto second = row_segment(dest_col, src_row, dest_row);
+    return {first.links, first.links_count, second.links, second.links_count};
+}
+
+const LinkId* GridRouteTable::line(const Direction direction, const int line, const int index) const noexcept {
+    const auto line_length = (direction == South || direction == North) ? 2 * rows : 2 * cols;
+    assert(0 <= index && index < line_length);
+
+    return links.data() + line_offsets[direction] + line * line_length + index;
+}
+
+GridRouteTable::Segment GridRouteTable::row_segment(const int col, const int src_row, const int dest_row) const
+    noexcept {
+    const auto steps = steps_between(src_row, dest_row, rows, wrap_around);
+    if (steps.count == 0) {
+        return {nullptr, 0};
+    }
+
+    // South line indexes rows from the top, North line from the bottom
+    const auto segment = steps.positive ? line(South, col, src_row) : line(North, col, rows - 1 - src_row);
+    return {segment, steps.count};
+}
+
+GridRouteTable::Segment GridRouteTable::col_segment(const int row, const int src_col, const int dest_col) const
+    noexcept {
+    const auto steps = steps_between(src_col, dest_col, cols, wrap_around);
+    if (steps.count == 0) {
+        return {nullptr, 0};
+    }
+
+    // East line indexes columns from the left, West line from the right
+    const auto segment = steps.positive ? line(East, row, src_col) : line(West, row, cols - 1 - src_col);
+    return {segment, steps.count};
+}
+
+int GridRouteTable::pending_chunks_count(const LinkRoute& route) const noexcept {
+    auto pending_chunks_count = 0;
+    for (auto hop = 0; hop < route.get_hops_count(); hop++) {
+        pending_chunks_count += topology->get_link(route.get_link(hop))->get_pending_chunks_count();
+    }
+    return pending_chunks_count;
+}
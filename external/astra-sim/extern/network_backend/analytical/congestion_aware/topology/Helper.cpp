@@ -40,6 +40,15 @@ std::shared_ptr<Topology> NetworkAnalyticalCongestionAware::construct_topology(
     const auto latency = latencies_per_dim[0];
     const auto params = topology_params_per_dim[0];
 
+    // routing policies apply to 2D grid topologies only
+    const auto routing_policy = network_parser.get_routing_policy();
+    if (routing_policy != RoutingPolicy::XY && topology_type != TopologyBuildingBlock::Mesh2D &&
+        topology_type != TopologyBuildingBlock::Torus2D) {
+        std::cerr << "[Error] (network/analytical/congestion_aware) "
+                  << "routing policy is only supported by Mesh2D and Torus2D" << std::endl;
+        std::exit(-1);
+    }
+
     switch (topology_type) {
     case TopologyBuildingBlock::Ring:
         return std::make_shared<Ring>(npus_count, bandwidth, latency);
@@ -49,11 +58,11 @@ std::shared_ptr<Topology> NetworkAnalyticalCongestionAware::construct_topology(
         return std::make_shared<FullyConnected>(npus_count, bandwidth, latency);
     case TopologyBuildingBlock::Mesh2D: {
         const auto shape = parse_mesh2d_shape(params, npus_count);
-        return std::make_shared<Mesh2D>(npus_count, bandwidth, latency, shape.rows, shape.cols);
+        return std::make_shared<Mesh2D>(npus_count, bandwidth, latency, shape.rows, shape.cols, routing_policy);
     }
     case TopologyBuildingBlock::Torus2D: {
         const auto shape = parse_torus2d_shape(params, npus_count);
-        return std::make_shared<Torus2D>(npus_count, bandwidth, latency, shape.rows, shape.cols);
+        return std::make_shared<Torus2D>(npus_count, bandwidth, latency, shape.rows, shape.cols, routing_policy);
     }
     case TopologyBuildingBlock::Butterfly: {
         const auto spec = parse_butterfly_spec(params, npus_count);
@@ -0,0 +1,76 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include "congestion_aware/LinkRoute.h"
+#include "congestion_aware/Device.h"
+#include <cassert>
+#include <iterator>
+
+using namespace NetworkAnalyticalCongestionAware;
+
+namespace {
+
+/// ids of the links between consecutive devices of a route
+std::vector<LinkId> links_of(const Route& route) noexcept {
+    assert(!route.empty());
+
+    auto links = std::vector<LinkId>();
+    links.reserve(route.size() - 1);
+    for (auto it = std::next(route.begin()); it != route.end(); it++) {
+        links.push_back((*std::prev(it))->get_link_id((*it)->get_id()));
+    }
+    return links;
+}
+
+}  // namespace
+
+LinkRoute::LinkRoute() noexcept
+    : first_links(nullptr),
+      first_count(0),
+      second_links(nullptr),
+      second_count(0),
+      owned_links(nullptr) {}
+
+LinkRoute::LinkRoute(const LinkId* const links, const int links_count) noexcept
+    : LinkRoute(links, links_count, nullptr, 0) {}
+
+LinkRoute::LinkRoute(const LinkId* const first_links,
+                     const int first_count,
+                     const LinkId* const second_links,
+                     const int second_count) noexcept
+    : first_links(first_links),
+      first_count(first_count),
+      second_links(second_links),
+      second_count(second_count),
+      owned_links(nullptr) {
+    assert(first_count >= 0);
+    assert(second_count >= 0);
+    assert(first_count == 0 || first_links != nullptr);
+    assert(second_count == 0 || second_links != nullptr);
+}
+
+LinkRoute::LinkRoute(std::vector<LinkId> links) noexcept
+    : second_links(nullptr),
+      second_count(0),
+      owned_links(std::make_shared<const std::vector<LinkId>>(std::move(links))) {
+    // the shared vector never moves, so the segment stays valid across copies
+    first_links = owned_links->data();
+    first_count = static_cast<int>(owned_links->size());
+}
+
+LinkRoute::LinkRoute(const Route& route) noexcept : LinkRoute(links_of(route)) {}
+
+int LinkRoute::get_hops_count() const noexcept {
+    return first_count + second_count;
+}
+
+LinkId LinkRoute::get_link(const int hop) const noexcept {
+    assert(0 <= hop && hop < get_hops_count());
+
+    if (hop < first_count) {
+        return first_links[hop];
+    }
+    return second_links[hop - first_count];
+}
@@ -0,0 +1,128 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include "congestion_aware/MulticastRoute.h"
+#include "congestion_aware/Device.h"
+#include <cassert>
+#include <map>
+#include <set>
+
+using namespace NetworkAnalyticalCongestionAware;
+
+namespace {
+
+/// node of the prefix tree merging the unicast routes
+struct TreeNode {
+    /// device of the node
+    std::shared_ptr<Device> device;
+
+    /// index of the destination at this node, -1 if none
+    int dest_index;
+
+    /// map[next device id] -> child node index
+    std::map<DeviceId, int> children;
+};
+
+}  // namespace
+
+MulticastRoute::MulticastRoute(const std::vector<Route>& routes) noexcept
+    : dests_count(static_cast<int>(routes.size())),
+      hops_count(0) {
+    assert(!routes.empty());
+
+    // merge the routes into a prefix tree rooted at the source
+    auto nodes = std::vector<TreeNode>();
+    nodes.push_back({routes.front().front(), -1, {}});
+    [[maybe_unused]] auto tree_devices = std::set<DeviceId>{nodes.front().device->get_id()};
+    for (auto dest_index = 0; dest_index < dests_count; dest_index++) {
+        const auto& route = routes[dest_index];
+        assert(route.size() >= 2);
+        assert(route.front()->get_id() == nodes.front().device->get_id());
+
+        auto node = 0;
+        for (auto it = std::next(route.begin()); it != route.end(); it++) {
+            const auto device_id = (*it)->get_id();
+            const auto child = nodes[node].children.find(device_id);
+            if (child != nodes[node].children.end()) {
+                node = child->second;
+                continue;
+            }
+
+            // new node: routes diverging once must not meet again, or the union is not a tree
+            assert(tree_devices.insert(device_id).second);
+            const auto new_node = static_cast<int>(nodes.size());
+            nodes.push_back({*it, -1, {}});
+            nodes[node].children.emplace(device_id, new_node);
+            node = new_node;
+        }
+
+        // destinations must be distinct
+        assert(nodes[node].dest_index == -1);
+        nodes[node].dest_index = dest_index;
+    }
+
+    // split the tree into branches, in depth-first order:
+    // a branch ends at a destination or at a fork
+    auto pending = std::vector<std::pair<int, int>>();  // (parent branch, first node of the branch)
+    for (auto it = nodes.front().children.rbegin(); it != nodes.front().children.rend(); it++) {
+        pending.emplace_back(-1, it->second);
+    }
+
+    while (!pending.empty()) {
+        const auto [parent, first_node] = pending.back();
+        pending.pop_back();
+
+        const auto branch_id = static_cast<int>(branches.size());
+        if (parent < 0) {
+            src_branches.push_back(branch_id);
+        } else {
+            branches[parent].children.push_back(branch_id);
+        }
+
+        // branch starts at the device it leaves from
+        auto branch = Branch{{}, {}, -1, {}};
+        branch.route.push_back(parent < 0 ? nodes.front().device : branches[parent].route.back());
+
+        // follow the tree until a destination or a fork
+        auto node = first_node;
+        while (true) {
+            branch.links.push_back(branch.route.back()->get_link_id(nodes[node].device->get_id()));
+            branch.route.push_back(nodes[node].device);
+            hops_count++;
+            if (nodes[node].dest_index >= 0 || nodes[node].children.size() != 1) {
+                break;
+            }
+            node = nodes[node].children.begin()->second;
+        }
+        branch.dest_index = nodes[node].dest_index;
+        branches.push_back(std::move(branch));
+
+        for (auto it = nodes[node].children.rbegin(); it != nodes[node].children.rend(); it++) {
+            pending.emplace_back(branch_id, it->second);
+        }
+    }
+}
+
+int MulticastRoute::get_dests_count() const noexcept {
+    assert(dests_count > 0);
+
+    return dests_count;
+}
+
+const std::vector<int>& MulticastRoute::get_src_branches() const noexcept {
+    return src_branches;
+}
+
+const MulticastRoute::Branch& MulticastRoute::get_branch(const int branch_id) const noexcept {
+    assert(0 <= branch_id && branch_id < static_cast<int>(branches.size()));
+
+    return branches[branch_id];
+}
+
+int MulticastRoute::get_hops_count() const noexcept {
+    assert(hops_count > 0);
+
+    return hops_count;
+}
@@ -5,7 +5,9 @@ LICENSE file in the root directory of this source tree.
 
 #include "congestion_aware/Topology.h"
 #include "congestion_aware/Link.h"
+#include "congestion_aware/MulticastRoute.h"
 #include <cassert>
+#include <cstdint>
 
 using namespace NetworkAnalyticalCongestionAware;
 
@@ -54,9 +56,68 @@ std::vector<Bandwidth> Topology::get_bandwidth_per_dim() const noexcept {
     return bandwidth_per_dim;
 }
 
+const std::shared_ptr<Device>& Topology::get_device(const DeviceId id) const noexcept {
+    assert(0 <= id && id < devices_count);
+
+    return devices[id];
+}
+
+int Topology::get_links_count() const noexcept {
+    return static_cast<int>(links.size());
+}
+
+Link* Topology::get_link(const LinkId id) const noexcept {
+    assert(0 <= id && id < static_cast<LinkId>(links.size()));
+
+    return links[id].get();
+}
+
+DeviceId Topology::get_link_dest(const LinkId id) const noexcept {
+    assert(0 <= id && id < static_cast<LinkId>(link_dests.size()));
+
+    return link_dests[id];
+}
+
+LinkRoute Topology::link_route(const DeviceId src, const DeviceId dest, const uint64_t /* sequence */) const noexcept {
+    assert(0 <= src && src < npus_count);
+    assert(0 <= dest && dest < npus_count);
+
+    // links along the route of devices
+    return LinkRoute(route(src, dest));
+}
+
+Route Topology::tree_route(const DeviceId src, const DeviceId dest) const noexcept {
+    assert(0 <= src && src < npus_count);
+    assert(0 <= dest && dest < npus_count);
+
+    return route(src, dest);
+}
+
+std::vector<int> Topology::partition_devices(const int regions_count) const noexcept {
+    assert(0 < regions_count && regions_count <= devices_count);
+
+    // split devices into contiguous id ranges of (almost) equal size
+    auto region_ids = std::vector<int>(devices_count);
+    for (auto i = 0; i < devices_count; i++) {
+        region_ids[i] = static_cast<int>(static_cast<int64_t>(i) * regions_count / devices_count);
+    }
+    return region_ids;
+}
+
+LinkCoordinate Topology::link_coordinate(const DeviceId src, const DeviceId dest) const noexcept {
+    assert(0 <= src && src < devices_count);
+    assert(0 <= dest && dest < devices_count);
+
+    // no coordinate by default
+    return {-1, -1, '-'};
+}
+
 void Topology::send(std::unique_ptr<Chunk> chunk) noexcept {
     assert(chunk != nullptr);
 
+    // chunk resolves its link ids in this topology
+    chunk->set_topology(this);
+
     // get src npu node_id
     const auto src = chunk->current_device()->get_id();
 
@@ -64,9 +125,30 @@ void Topology::send(std::unique_ptr<Chunk> chunk) noexcept {
     assert(0 <= src && src < devices_count);
 
     // initiate transmission from src
+    if (chunk->is_multicast()) {
+        devices[src]->multicast(std::move(chunk));
+        return;
+    }
     devices[src]->send(std::move(chunk));
 }
 
+std::shared_ptr<MulticastRoute> Topology::multicast_route(const DeviceId src,
+                                                          const std::vector<DeviceId>& dests) const noexcept {
+    assert(0 <= src && src < npus_count);
+    assert(!dests.empty());
+
+    // merge the unicast routes to every destination
+    auto routes = std::vector<Route>();
+    routes.reserve(dests.size());
+    for (const auto dest : dests) {
+        assert(0 <= dest && dest < npus_count);
+        assert(dest != src);
+        routes.push_back(tree_route(src, dest));
+    }
+
+    return std::make_shared<MulticastRoute>(routes);
+}
+
 void Topology::connect(const DeviceId src,
                        const DeviceId dest,
                        const Bandwidth bandwidth,
@@ -81,17 +163,37 @@ void Topology::connect(const DeviceId src,
     assert(latency >= 0);
 
     // connect src -> dest
-    devices[src]->connect(dest, bandwidth, latency);
+    add_link(src, dest, bandwidth, latency);
 
     // if bidirectional, connect dest -> src
     if (bidirectional) {
-        devices[dest]->connect(src, bandwidth, latency);
+        add_link(dest, src, bandwidth, latency);
     }
 }
 
+void Topology::add_link(const DeviceId src, const DeviceId dest, const Bandwidth bandwidth, const Latency latency) noexcept {
+    // register the link in the link table
+    const auto link_id = static_cast<LinkId>(links.size());
+    devices[src]->connect(dest, link_id, bandwidth, latency);
+    links.push_back(devices[src]->get_links().at(dest));
+    link_dests.push_back(dest);
+}
+
 void Topology::instantiate_devices() noexcept {
     // instantiate all devices
     for (auto i = 0; i < devices_count; i++) {
         devices.push_back(std::make_shared<Device>(i));
     }
 }
+
+Route Topology::device_route(const DeviceId src, const LinkRoute& link_route) const noexcept {
+    assert(0 <= src && src < devices_count);
+
+    // follow the links from src
+    auto route = Route();
+    route.push_back(devices[src]);
+    for (auto hop = 0; hop < link_route.get_hops_count(); hop++) {
+        route.push_back(devices[link_dests[link_route.get_link(hop)]]);
+    }
+    return route;
+}
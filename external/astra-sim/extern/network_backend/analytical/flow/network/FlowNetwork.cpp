@@ -0,0 +1,270 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include "flow/FlowNetwork.h"
+#include "common/NetworkFunction.h"
+#include "congestion_aware/Link.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <functional>
+#include <limits>
+
+using namespace NetworkAnalytical;
+using namespace NetworkAnalyticalCongestionAware;
+using namespace NetworkAnalyticalFlow;
+
+namespace {
+
+/// lowest rate assigned to a flow, guarding against rounding errors of the remaining bandwidth
+constexpr auto min_rate = 1e-12;
+
+}  // namespace
+
+FlowNetwork::FlowNetwork(std::shared_ptr<Topology> topology, std::shared_ptr<EventQueue> event_queue) noexcept
+    : topology(std::move(topology)),
+      event_queue(std::move(event_queue)),
+      active_flows_count(0),
+      last_update_time(0),
+      rate_updates_count(0) {
+    assert(this->topology != nullptr);
+    assert(this->event_queue != nullptr);
+
+    // link bandwidths in B/ns
+    const auto links_count = this->topology->get_links_count();
+    link_bandwidths.reserve(links_count);
+    for (auto link_id = 0; link_id < links_count; link_id++) {
+        link_bandwidths.push_back(bw_GBps_to_Bpns(this->topology->get_link(link_id)->get_bandwidth()));
+    }
+    link_flows.resize(links_count);
+
+    // scratch space of the rate assignment
+    remaining_bandwidths.resize(links_count);
+    unassigned_flows_counts.resize(links_count);
+
+    last_update_time = this->event_queue->get_current_time();
+}
+
+void FlowNetwork::send(const DeviceId src,
+                       const DeviceId dest,
+                       const ChunkSize size,
+                       const Callback callback,
+                       const CallbackArg callback_arg,
+                       const uint64_t sequence) noexcept {
+    assert(size > 0);
+    assert(callback != nullptr);
+
+    const auto current_time = event_queue->get_current_time();
+    const auto route = topology->link_route(src, dest, sequence);
+
+    // nothing to transmit
+    if (route.get_hops_count() == 0) {
+        event_queue->schedule_event(current_time, callback, callback_arg);
+        return;
+    }
+
+    // the message pays the latency of each hop once
+    auto links = std::vector<LinkId>();
+    links.reserve(route.get_hops_count());
+    auto latency = Latency{0};
+    for (auto hop = 0; hop < route.get_hops_count(); hop++) {
+        links.push_back(route.get_link(hop));
+        latency += topology->get_link(links.back())->get_latency();
+    }
+
+    // the flow joins the active flows at the next update of this time
+    const auto remaining_bytes = static_cast<double>(size);
+    new_flows.push_back({std::move(links), false, size, remaining_bytes, 0.0, current_time,
+                         static_cast<EventTime>(latency), callback, callback_arg});
+    schedule_update(current_time);
+}
+
+const std::shared_ptr<Topology>& FlowNetwork::get_topology() const noexcept {
+    return topology;
+}
+
+int FlowNetwork::get_active_flows_count() const noexcept {
+    return active_flows_count;
+}
+
+uint64_t FlowNetwork::get_rate_updates_count() const noexcept {
+    return rate_updates_count;
+}
+
+void FlowNetwork::update(void* const flow_network_ptr) noexcept {
+    assert(flow_network_ptr != nullptr);
+
+    auto* const flow_network = static_cast<FlowNetwork*>(flow_network_ptr);
+    flow_network->update_flows();
+}
+
+void FlowNetwork::schedule_update(const EventTime update_time) noexcept {
+    // an earlier update reschedules the next one itself
+    if (!update_times.empty() && *update_times.begin() <= update_time) {
+        return;
+    }
+
+    update_times.insert(update_time);
+    event_queue->schedule_event(update_time, update, this);
+}
+
+void FlowNetwork::update_flows() noexcept {
+    const auto current_time = event_queue->get_current_time();
+    update_times.erase(current_time);
+    drain_flows(current_time);
+
+    // finish flows whose last byte left the source
+    auto flows_changed = false;
+    for (auto slot = 0; slot < static_cast<int>(flows.size()); slot++) {
+        auto& flow = flows[slot];
+        if (!flow.active || flow.finish_time > current_time) {
+            continue;
+        }
+
+        event_queue->schedule_event(current_time + flow.latency, flow.callback, flow.callback_arg);
+        flow.active = false;
+        active_flows_count--;
+        finished_slots.push_back(slot);
+        flows_changed = true;
+    }
+
+    // admit flows sent since the last update
+    if (!new_flows.empty()) {
+        for (auto& flow : new_flows) {
+            admit_flow(std::move(flow));
+        }
+        new_flows.clear();
+        flows_changed = true;
+    }
+
+    // rates change only when flows start or finish
+    if (flows_changed) {
+        assign_rates(current_time);
+    }
+
+    // schedule the next finish, also when this update was outdated by a rate change
+    // (the earlier update suppressed scheduling the later finish times)
+    auto next_finish_time = std::numeric_limits<EventTime>::max();
+    for (const auto& flow : flows) {
+        if (flow.active) {
+            next_finish_time = std::min(next_finish_time, flow.finish_time);
+        }
+    }
+    if (active_flows_count > 0) {
+        schedule_update(next_finish_time);
+    }
+}
+
+void FlowNetwork::drain_flows(const EventTime current_time) noexcept {
+    assert(current_time >= last_update_time);
+
+    const auto elapsed_time = static_cast<double>(current_time - last_update_time);
+    last_update_time = current_time;
+    if (elapsed_time == 0) {
+        return;
+    }
+
+    for (auto& flow : flows) {
+        if (flow.active) {
+            flow.remaining_bytes = std::max(0.0, flow.remaining_bytes - (flow.rate * elapsed_time));
+        }
+    }
+}
+
+void FlowNetwork::admit_flow(Flow flow) noexcept {
+    assert(!flow.active);
+
+    // reuse a released slot if any
+    auto slot = static_cast<int>(flows.size());
+    if (free_slots.empty()) {
+        flows.push_back(std::move(flow));
+    } else {
+        slot = free_slots.back();
+        free_slots.pop_back();
+        flows[slot] = std::move(flow);
+    }
+
+    // register the flow to its links
+    flows[slot].active = true;
+    active_flows_count++;
+    for (const auto link_id : flows[slot].links) {
+        link_flows[link_id].push_back(slot);
+    }
+}
+
+void FlowNetwork::assign_rates(const EventTime current_time) noexcept {
+    // remove finished flows from the links, and compute the initial fair share of every link carrying a flow
+    link_shares.clear();
+    for (auto link_id = 0; link_id < static_cast<int>(link_flows.size()); link_id++) {
+        auto& slots = link_flows[link_id];
+        slots.erase(std::remove_if(slots.begin(), slots.end(), [this](const int slot) { return !flows[slot].active; }),
+                    slots.end());
+
+        unassigned_flows_counts[link_id] = static_cast<int>(slots.size());
+        remaining_bandwidths[link_id] = link_bandwidths[link_id];
+        if (!slots.empty()) {
+            const auto share = link_bandwidths[link_id] / static_cast<double>(slots.size());
+            link_shares.push_back({share, link_id});
+        }
+    }
+    std::make_heap(link_shares.begin(), link_shares.end(), std::greater<>());
+
+    // finished slots are no longer referenced by any link
+    free_slots.insert(free_slots.end(), finished_slots.begin(), finished_slots.end());
+    finished_slots.clear();
+    if (active_flows_count == 0) {
+        return;
+    }
+
+    rate_updates_count++;
+    for (auto& flow : flows) {
+        flow.rate = -1;  // no rate yet
+    }
+
+    // progressive filling: the flows of the link with the smallest share are bottlenecked there.
+    // Assigning a flow the smallest share never lowers the share of another link,
+    // so outdated entries are only too low and get pushed back with their current share.
+    while (!link_shares.empty()) {
+        std::pop_heap(link_shares.begin(), link_shares.end(), std::greater<>());
+        const auto entry = link_shares.back();
+        link_shares.pop_back();
+
+        const auto bottleneck_id = entry.link_id;
+        const auto unassigned_flows_count = unassigned_flows_counts[bottleneck_id];
+        if (unassigned_flows_count == 0) {
+            continue;
+        }
+        const auto share = std::max(0.0, remaining_bandwidths[bottleneck_id]) / unassigned_flows_count;
+        if (share > entry.share) {
+            link_shares.push_back({share, bottleneck_id});
+            std::push_heap(link_shares.begin(), link_shares.end(), std::greater<>());
+            continue;
+        }
+
+        // the flows take the share from every link of their routes
+        const auto rate = std::max(share, min_rate);
+        for (const auto slot : link_flows[bottleneck_id]) {
+            auto& flow = flows[slot];
+            if (flow.rate >= 0) {
+                continue;
+            }
+
+            flow.rate = rate;
+            for (const auto link_id : flow.links) {
+                remaining_bandwidths[link_id] -= rate;
+                unassigned_flows_counts[link_id]--;
+            }
+        }
+    }
+
+    // finish times at the new rates
+    for (auto& flow : flows) {
+        if (flow.active) {
+            assert(flow.rate > 0);
+            const auto transmission_time = std::ceil(flow.remaining_bytes / flow.rate);
+            flow.finish_time = current_time + static_cast<EventTime>(transmission_time);
+        }
+    }
+}
@@ -0,0 +1,113 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#pragma once
+
+#include "common/EventPool.h"
+#include "common/EventScheduler.h"
+#include <cstddef>
+#include <vector>
+
+namespace NetworkAnalytical {
+
+/**
+ * CalendarEventScheduler implements a calendar queue (R. Brown, CACM 1988).
+ *
+ * Distinct event times are hashed into buckets ("days") of a fixed width,
+ * and each event time keeps its events as a FIFO chain in the EventPool.
+ * The calendar resizes itself as the number of distinct pending event times changes,
+ * re-estimating the bucket width from the earliest pending event times,
+ * which keeps both schedule() and pop() O(1) amortized.
+ */
+class CalendarEventScheduler final : public EventScheduler {
+  public:
+    /**
+     * Constructor.
+     */
+    CalendarEventScheduler() noexcept;
+
+    [[nodiscard]] bool empty() const noexcept override;
+
+    [[nodiscard]] EventTime next_event_time() noexcept override;
+
+    void schedule(EventTime event_time, Callback callback, CallbackArg callback_arg) noexcept override;
+
+    [[nodiscard]] Event pop() noexcept override;
+
+  private:
+    /// all events registered at a single event time
+    struct TimeSlot {
+        /// event time
+        EventTime event_time;
+
+        /// first event of the chain
+        EventPool::Index head;
+
+        /// last event of the chain
+        EventPool::Index tail;
+    };
+
+    /// minimum number of buckets in the calendar
+    static constexpr size_t min_buckets_count = 16;
+
+    /// number of earliest event times sampled to estimate the bucket width
+    static constexpr size_t width_samples_count = 25;
+
+    /// storage of pending events
+    EventPool pool;
+
+    /// calendar buckets, each sorted in decreasing event time (earliest at the back)
+    std::vector<std::vector<TimeSlot>> buckets;
+
+    /// buckets count - 1 (buckets count is a power of 2)
+    size_t buckets_mask;
+
+    /// bucket width is 2^width_shift ns
+    int width_shift;
+
+    /// number of distinct pending event times
+    size_t slots_count;
+
+    /// time of the most recently dequeued event, lower bound of all pending event times
+    EventTime last_event_time;
+
+    /// bucket holding the earliest pending event time, valid if cached_bucket_valid
+    size_t cached_bucket;
+
+    /// whether cached_bucket is up to date
+    bool cached_bucket_valid;
+
+    /**
+     * Compute the bucket an event time falls into.
+     *
+     * @param event_time event time
+     * @return bucket index
+     */
+    [[nodiscard]] size_t bucket_of(EventTime event_time) const noexcept;
+
+    /**
+     * Locate the bucket holding the earliest pending event time.
+     *
+     * @return bucket index
+     */
+    [[nodiscard]] size_t find_earliest_bucket() const noexcept;
+
+    /**
+     * Estimate the bucket width from the earliest pending event times.
+     *
+     * @param slots all pending time slots
+     * @return estimated width shift
+     */
+    [[nodiscard]] int estimate_width_shift(std::vector<TimeSlot>& slots) const noexcept;
+
+    /**
+     * Rebuild the calendar with the given number of buckets.
+     *
+     * @param new_buckets_count new number of buckets (power of 2)
+     */
+    void resize(size_t new_buckets_count) noexcept;
+};
+
+}  // namespace NetworkAnalytical
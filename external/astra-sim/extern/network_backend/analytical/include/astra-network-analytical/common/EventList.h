@@ -43,6 +43,20 @@ class EventList {
      */
     void invoke_events() noexcept;
 
+    /**
+     * Check if the event list has no registered event.
+     *
+     * @return true if the event list is empty, false otherwise
+     */
+    [[nodiscard]] bool empty() const noexcept;
+
+    /**
+     * Dequeue the first registered event.
+     *
+     * @return the first registered event
+     */
+    [[nodiscard]] Event pop_event() noexcept;
+
   private:
     /// event time of the event list
     EventTime event_time;
@@ -0,0 +1,86 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#pragma once
+
+#include "common/Event.h"
+#include "common/Type.h"
+#include <cstdint>
+#include <vector>
+
+namespace NetworkAnalytical {
+
+/**
+ * EventPool stores pending events in a contiguous, recycled array.
+ * Events are addressed by index and can be chained into singly-linked FIFO lists,
+ * so schedulers never allocate per event once the pool has warmed up.
+ */
+class EventPool {
+  public:
+    /// index of an event slot inside the pool
+    using Index = uint32_t;
+
+    /// sentinel index representing "no event"
+    static constexpr Index npos = UINT32_MAX;
+
+    /**
+     * Constructor.
+     */
+    EventPool() noexcept;
+
+    /**
+     * Store an event into the pool.
+     *
+     * @param callback callback function pointer
+     * @param callback_arg argument of the callback function
+     * @return index of the stored event
+     */
+    [[nodiscard]] Index allocate(Callback callback, CallbackArg callback_arg) noexcept;
+
+    /**
+     * Take an event out of the pool, recycling its slot.
+     *
+     * @param index index of the event
+     * @return the stored event
+     */
+    [[nodiscard]] Event release(Index index) noexcept;
+
+    /**
+     * Get the event chained after the given event.
+     *
+     * @param index index of the event
+     * @return index of the next event, npos if none
+     */
+    [[nodiscard]] Index get_next(Index index) const noexcept;
+
+    /**
+     * Chain an event after the given event.
+     *
+     * @param index index of the event
+     * @param next index of the event to be chained
+     */
+    void set_next(Index index, Index next) noexcept;
+
+  private:
+    /// single event slot
+    struct Node {
+        /// callback function pointer
+        Callback callback;
+
+        /// argument of the callback function
+        CallbackArg callback_arg;
+
+        /// next event in the chain (or next free slot)
+        Index next;
+    };
+
+    /// contiguous event storage
+    std::vector<Node> nodes;
+
+    /// head of the recycled slot list
+    Index free_head;
+};
+
+}  // namespace NetworkAnalytical
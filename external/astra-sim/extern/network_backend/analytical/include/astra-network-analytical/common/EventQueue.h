@@ -5,20 +5,35 @@ LICENSE file in the root directory of this source tree.
 
 #pragma once
 
-#include "common/EventList.h"
+#include "common/EventScheduler.h"
+#include "common/EventTraceRecorder.h"
 #include "common/Type.h"
+#include <cstdint>
+#include <memory>
+#include <string>
 
 namespace NetworkAnalytical {
 
 /**
- * EventQueue manages scheduled EventLists.
+ * EventQueue manages scheduled events.
+ * Pending events are kept by a pluggable EventScheduler.
  */
 class EventQueue {
   public:
+    /**
+     * Parse an event scheduler name into EventSchedulerType.
+     *
+     * @param scheduler_name "linear", "heap", or "calendar"
+     * @return parsed EventSchedulerType enum class value
+     */
+    [[nodiscard]] static EventSchedulerType parse_scheduler_type(const std::string& scheduler_name) noexcept;
+
     /**
      * Constructor.
+     *
+     * @param scheduler_type data structure keeping the pending events
      */
-    EventQueue() noexcept;
+    explicit EventQueue(EventSchedulerType scheduler_type = EventSchedulerType::Calendar) noexcept;
 
     /**
      * Get current event time of the event queue.
@@ -35,6 +50,21 @@ class EventQueue {
      */
     [[nodiscard]] bool finished() const noexcept;
 
+    /**
+     * Get the number of events invoked so far.
+     *
+     * @return number of invoked events
+     */
+    [[nodiscard]] uint64_t get_invoked_events_count() const noexcept;
+
+    /**
+     * Get the time of the earliest registered event.
+     * The event queue must not be finished.
+     *
+     * @return earliest registered event time
+     */
+    [[nodiscard]] EventTime get_next_event_time() noexcept;
+
     /**
      * Proceed the event queue.
      * i.e., first update the current event time to the next registered event
@@ -52,12 +82,35 @@ class EventQueue {
      */
     void schedule_event(EventTime event_time, Callback callback, CallbackArg callback_arg) noexcept;
 
+    /**
+     * Replace the scheduler keeping the pending events.
+     * Pending events are moved into the new scheduler in the order they would be invoked.
+     *
+     * @param new_scheduler scheduler to keep the pending events from now on
+     * @return previous scheduler, emptied
+     */
+    std::unique_ptr<EventScheduler> replace_scheduler(std::unique_ptr<EventScheduler> new_scheduler) noexcept;
+
+    /**
+     * Record every subsequent schedule_event() call into a trace file,
+     * which can be replayed by the event queue benchmark.
+     *
+     * @param path path of the trace file
+     */
+    void record_trace(const std::string& path) noexcept;
+
   private:
     /// current time of the event queue
     EventTime current_time;
 
-    /// list of EventLists
-    std::list<EventList> event_queue;
+    /// number of events invoked so far
+    uint64_t invoked_events_count;
+
+    /// scheduler keeping the pending events
+    std::unique_ptr<EventScheduler> scheduler;
+
+    /// trace recorder, nullptr if recording is disabled
+    std::unique_ptr<EventTraceRecorder> trace_recorder;
 };
 
 }  // namespace NetworkAnalytical
@@ -0,0 +1,58 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#pragma once
+
+#include "common/Event.h"
+#include "common/Type.h"
+
+namespace NetworkAnalytical {
+
+/**
+ * EventScheduler abstracts the priority structure backing the EventQueue.
+ * Events are ordered by event time, and events sharing the same event time
+ * are dequeued in the order they were scheduled.
+ */
+class EventScheduler {
+  public:
+    /**
+     * Destructor.
+     */
+    virtual ~EventScheduler() noexcept = default;
+
+    /**
+     * Check if there is no pending event.
+     *
+     * @return true if no event is pending, false otherwise
+     */
+    [[nodiscard]] virtual bool empty() const noexcept = 0;
+
+    /**
+     * Get the earliest pending event time.
+     * The scheduler must not be empty.
+     *
+     * @return earliest pending event time
+     */
+    [[nodiscard]] virtual EventTime next_event_time() noexcept = 0;
+
+    /**
+     * Register an event.
+     *
+     * @param event_time time of event
+     * @param callback callback function pointer
+     * @param callback_arg argument of the callback function
+     */
+    virtual void schedule(EventTime event_time, Callback callback, CallbackArg callback_arg) noexcept = 0;
+
+    /**
+     * Dequeue the earliest pending event.
+     * The scheduler must not be empty.
+     *
+     * @return dequeued event
+     */
+    [[nodiscard]] virtual Event pop() noexcept = 0;
+};
+
+}  // namespace NetworkAnalytical
@@ -0,0 +1,107 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#pragma once
+
+#include "common/Type.h"
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace NetworkAnalytical {
+
+/**
+ * EventTraceRecorder records every schedule_event() call of an EventQueue
+ * into a binary trace, so that the scheduling pattern of a simulation
+ * can be replayed later without the simulator (e.g., for benchmarking schedulers).
+ *
+ * Each record stores the event time, the id of the event whose callback scheduled it
+ * (-1 if scheduled outside any event), and the number of proceed() calls
+ * completed at the time it was scheduled. Event ids are implicit record indices.
+ */
+class EventTraceRecorder {
+  public:
+    /// single schedule_event() call
+    struct Record {
+        /// requested event time
+        EventTime event_time;
+
+        /// id of the event that scheduled this event, -1 if none
+        int64_t parent;
+
+        /// number of proceed() calls completed when this event got scheduled
+        uint64_t epoch;
+    };
+
+    /**
+     * Load a recorded trace.
+     *
+     * @param path path of the trace file
+     * @return recorded schedule_event() calls, in order
+     */
+    [[nodiscard]] static std::vector<Record> load(const std::string& path) noexcept;
+
+    /**
+     * Callback wrapping a recorded event:
+     * tracks the currently running event and invokes the original callback.
+     *
+     * @param recorded_event_ptr pointer to the wrapped event
+     */
+    static void invoke_recorded_event(void* recorded_event_ptr) noexcept;
+
+    /**
+     * Constructor.
+     *
+     * @param path path of the trace file to write
+     */
+    explicit EventTraceRecorder(const std::string& path) noexcept;
+
+    /**
+     * Record a schedule_event() call and wrap the callback argument.
+     * The returned argument must be scheduled with invoke_recorded_event.
+     *
+     * @param event_time time of event
+     * @param callback callback function pointer
+     * @param callback_arg argument of the callback function
+     * @return argument to be passed to invoke_recorded_event
+     */
+    [[nodiscard]] CallbackArg record(EventTime event_time, Callback callback, CallbackArg callback_arg) noexcept;
+
+    /**
+     * Mark the completion of a proceed() call.
+     */
+    void advance_epoch() noexcept;
+
+  private:
+    /// event wrapped by the recorder
+    struct RecordedEvent {
+        /// recorder owning the event
+        EventTraceRecorder* recorder;
+
+        /// id of the event
+        int64_t id;
+
+        /// original callback function pointer
+        Callback callback;
+
+        /// original argument of the callback function
+        CallbackArg callback_arg;
+    };
+
+    /// output trace file
+    std::ofstream trace_file;
+
+    /// id of the next recorded event
+    int64_t next_id;
+
+    /// id of the event being invoked, -1 if none
+    int64_t current_event_id;
+
+    /// number of proceed() calls completed
+    uint64_t epoch;
+};
+
+}  // namespace NetworkAnalytical
@@ -0,0 +1,62 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#pragma once
+
+#include "common/EventPool.h"
+#include "common/EventScheduler.h"
+#include <cstdint>
+#include <vector>
+
+namespace NetworkAnalytical {
+
+/**
+ * HeapEventScheduler keeps pending events in a binary min-heap
+ * keyed by (event time, schedule order), i.e., O(log n) per event.
+ */
+class HeapEventScheduler final : public EventScheduler {
+  public:
+    /**
+     * Constructor.
+     */
+    HeapEventScheduler() noexcept;
+
+    [[nodiscard]] bool empty() const noexcept override;
+
+    [[nodiscard]] EventTime next_event_time() noexcept override;
+
+    void schedule(EventTime event_time, Callback callback, CallbackArg callback_arg) noexcept override;
+
+    [[nodiscard]] Event pop() noexcept override;
+
+  private:
+    /// heap element referring to an event in the pool
+    struct HeapEntry {
+        /// event time
+        EventTime event_time;
+
+        /// schedule order, breaking ties among the same event time
+        uint64_t sequence;
+
+        /// index of the event in the pool
+        EventPool::Index index;
+    };
+
+    /// storage of pending events
+    EventPool pool;
+
+    /// binary min-heap of pending events
+    std::vector<HeapEntry> heap;
+
+    /// schedule order of the next event
+    uint64_t next_sequence;
+
+    /**
+     * Heap ordering: the entry with the later (event time, sequence) sinks.
+     */
+    [[nodiscard]] static bool later(const HeapEntry& lhs, const HeapEntry& rhs) noexcept;
+};
+
+}  // namespace NetworkAnalytical
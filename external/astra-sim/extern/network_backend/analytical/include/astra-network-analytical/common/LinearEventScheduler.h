@@ -0,0 +1,39 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#pragma once
+
+#include "common/EventList.h"
+#include "common/EventScheduler.h"
+#include <list>
+
+namespace NetworkAnalytical {
+
+/**
+ * LinearEventScheduler keeps EventLists in a sorted linked list.
+ * Insertion walks the list from the front, i.e., O(#distinct pending event times).
+ * Kept as the reference implementation for benchmarking.
+ */
+class LinearEventScheduler final : public EventScheduler {
+  public:
+    /**
+     * Constructor.
+     */
+    LinearEventScheduler() noexcept;
+
+    [[nodiscard]] bool empty() const noexcept override;
+
+    [[nodiscard]] EventTime next_event_time() noexcept override;
+
+    void schedule(EventTime event_time, Callback callback, CallbackArg callback_arg) noexcept override;
+
+    [[nodiscard]] Event pop() noexcept override;
+
+  private:
+    /// list of EventLists, sorted by event time
+    std::list<EventList> event_lists;
+};
+
+}  // namespace NetworkAnalytical
@@ -66,6 +66,20 @@ class NetworkParser {
      */
     [[nodiscard]] std::vector<std::string> get_topology_params_per_dim() const noexcept;
 
+    /**
+     * Read the optional "parallel_threads" value.
+     *
+     * @return number of parallel simulation threads, 0 for the sequential simulation
+     */
+    [[nodiscard]] int get_parallel_threads() const noexcept;
+
+    /**
+     * Read the optional "routing" value.
+     *
+     * @return routing policy of 2D grid topologies, XY by default
+     */
+    [[nodiscard]] RoutingPolicy get_routing_policy() const noexcept;
+
   private:
     /// number of network dimensions
     int dims_count;
@@ -85,6 +99,12 @@ class NetworkParser {
     /// optional topology parameters per dimension
     std::vector<std::string> topology_params_per_dim;
 
+    /// number of parallel simulation threads (0: sequential simulation)
+    int parallel_threads;
+
+    /// routing policy of 2D grid topologies
+    RoutingPolicy routing_policy;
+
     /**
      * Parse topology name (in string) into TopologyBuildingBlock enum
      *
@@ -95,6 +115,15 @@ class NetworkParser {
      */
     [[nodiscard]] static TopologyBuildingBlock parse_topology_name(const std::string& topology_name) noexcept;
 
+    /**
+     * Parse routing policy name (in string) into RoutingPolicy enum
+     *
+     * @param routing_name routing policy name in string
+     *    which can be "XY", "YX", "O1TURN", or "Adaptive"
+     * @return parsed RoutingPolicy enum class value
+     */
+    [[nodiscard]] static RoutingPolicy parse_routing_name(const std::string& routing_name) noexcept;
+
     /**
      * Parse the given YAML node and retrieve network configuration values
      *
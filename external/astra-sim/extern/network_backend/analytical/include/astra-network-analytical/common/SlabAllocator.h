@@ -0,0 +1,47 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+
+namespace NetworkAnalytical {
+
+/**
+ * SlabAllocator recycles small objects created and destroyed once per message (e.g., chunks).
+ *
+ * Blocks are carved out of large slabs and grouped into 16-byte size classes.
+ * Freed blocks are kept in per-thread free lists and reused by the next allocation of the same size class,
+ * so the allocator does not call the global allocator once it has warmed up.
+ * A block may be freed by another thread than the allocating one (e.g., multicast replicas created by
+ * parallel simulation threads): threads freeing more blocks than they allocate hand batches of them over
+ * to a shared depot, from which the other threads refill. Slabs are kept until the process exits.
+ *
+ * Classes opt in by forwarding their operator new/delete to the allocator,
+ * and their objects must be deleted through a pointer of their own type.
+ */
+class SlabAllocator {
+  public:
+    SlabAllocator() = delete;
+
+    /**
+     * Allocate a block.
+     * Blocks larger than the largest size class come from the global allocator.
+     *
+     * @param size size of the block in bytes
+     * @return pointer to the block
+     */
+    [[nodiscard]] static void* allocate(std::size_t size);
+
+    /**
+     * Release a block allocated by allocate().
+     *
+     * @param ptr pointer to the block
+     * @param size size of the block in bytes, as passed to allocate()
+     */
+    static void deallocate(void* ptr, std::size_t size) noexcept;
+};
+
+}  // namespace NetworkAnalytical
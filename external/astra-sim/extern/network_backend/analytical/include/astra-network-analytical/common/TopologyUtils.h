@@ -2,6 +2,7 @@
 
 #include "common/Type.h"
 #include <string>
+#include <vector>
 
 namespace NetworkAnalytical {
 
@@ -21,4 +22,14 @@ struct ButterflySpec {
 
 [[nodiscard]] ButterflySpec parse_butterfly_spec(const std::string& param, int npus_count) noexcept;
 
+/**
+ * Partition a row-major grid into rectangular blocks of (almost) equal size,
+ * choosing the block arrangement that cuts the fewest grid edges.
+ *
+ * @param shape shape of the grid
+ * @param regions_count number of blocks
+ * @return block id of each grid position
+ */
+[[nodiscard]] std::vector<int> partition_grid(GridShape shape, int regions_count) noexcept;
+
 }  // namespace NetworkAnalytical
@@ -41,4 +41,19 @@ enum class TopologyBuildingBlock {
     Butterfly
 };
 
+/// Routing policy of 2D grid topologies (Mesh2D and Torus2D)
+enum class RoutingPolicy {
+    XY,
+    YX,
+    O1Turn,
+    Adaptive
+};
+
+/// Data structure backing the EventQueue
+enum class EventSchedulerType {
+    Linear,
+    Heap,
+    Calendar
+};
+
 }  // namespace NetworkAnalytical
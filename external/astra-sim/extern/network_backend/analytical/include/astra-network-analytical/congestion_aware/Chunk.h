@@ -6,8 +6,12 @@ LICENSE file in the root directory of this source tree.
 #pragma once
 
 #include "common/Type.h"
+#include "congestion_aware/LinkRoute.h"
+#include "congestion_aware/MulticastRoute.h"
 #include "congestion_aware/Type.h"
+#include <cstddef>
 #include <memory>
+#include <vector>
 
 using namespace NetworkAnalytical;
 
@@ -16,6 +20,10 @@ namespace NetworkAnalyticalCongestionAware {
 /**
  * Chunk class represents a chunk.
  * Chunk is a basic unit of transmission.
+ *
+ * A multicast chunk follows a MulticastRoute instead:
+ * it traverses one branch of the tree at a time,
+ * and is replicated into the child branches at the end of each branch.
  */
 class Chunk {
   public:
@@ -28,6 +36,23 @@ class Chunk {
      */
     static void chunk_arrived_next_device(void* chunk_ptr) noexcept;
 
+    /**
+     * Allocate a chunk from the slab allocator,
+     * as a chunk is created (and destroyed) per message.
+     *
+     * @param size size of the chunk object
+     * @return pointer to the allocated memory
+     */
+    static void* operator new(std::size_t size);
+
+    /**
+     * Return a chunk to the slab allocator.
+     *
+     * @param ptr pointer to the chunk object
+     * @param size size of the chunk object
+     */
+    static void operator delete(void* ptr, std::size_t size) noexcept;
+
     /**
      * Constructor.
      *
@@ -36,36 +61,107 @@ class Chunk {
      * @param callback: callback to be invoked when the chunk arrives destination
      * @param callback_arg: argument of the callback
      */
-    Chunk(ChunkSize chunk_size, Route route, Callback callback, CallbackArg callback_arg) noexcept;
+    Chunk(ChunkSize chunk_size, const Route& route, Callback callback, CallbackArg callback_arg) noexcept;
+
+    /**
+     * Constructor.
+     *
+     * @param chunk_size: size of the chunk
+     * @param src: source device of the chunk
+     * @param link_route: links of the chunk from its source to destination
+     * @param callback: callback to be invoked when the chunk arrives destination
+     * @param callback_arg: argument of the callback
+     */
+    Chunk(ChunkSize chunk_size, DeviceId src, LinkRoute link_route, Callback callback, CallbackArg callback_arg) noexcept;
+
+    /**
+     * Constructor of a multicast chunk, sitting at the source of the multicast route.
+     *
+     * @param chunk_size: size of the chunk
+     * @param multicast_route: multicast route of the chunk from its source to destinations
+     * @param callback: callback to be invoked when the chunk arrives each destination
+     * @param callback_args: argument of the callback, per destination of the multicast route
+     */
+    Chunk(ChunkSize chunk_size,
+          std::shared_ptr<const MulticastRoute> multicast_route,
+          Callback callback,
+          std::vector<CallbackArg> callback_args) noexcept;
+
+    /**
+     * Set the topology the chunk is sent over,
+     * which resolves the link ids of its route.
+     * Invoked by Topology::send().
+     *
+     * @param topology topology the chunk is sent over
+     */
+    void set_topology(const Topology* topology) noexcept;
 
     /**
      * Get the current sitting device of the chunk
      *
      * @return current device of the chunk
      */
-    [[nodiscard]] std::shared_ptr<Device> current_device() const noexcept;
+    [[nodiscard]] const std::shared_ptr<Device>& current_device() const noexcept;
 
     /**
      * Get the next destined device of the chunk
      *
      * @return next device of the chunk
      */
-    [[nodiscard]] std::shared_ptr<Device> next_device() const noexcept;
+    [[nodiscard]] const std::shared_ptr<Device>& next_device() const noexcept;
+
+    /**
+     * Get the link to the next destined device of the chunk
+     *
+     * @return link the chunk traverses next
+     */
+    [[nodiscard]] Link* next_link() const noexcept;
 
     /**
      * Mark the chunk arrived at its next device
-     * i.e., drop the current device from the route
+     * i.e., advance the current device along the route
      */
     void mark_arrived_next_device() noexcept;
 
     /**
      * Check if the chunk arrived at its destination
-     * i.e., if the route length is 1 (only destination device left)
+     * i.e., if no link is left in the route
      *
      * @return true if the chunk arrived at its destination, false otherwise
      */
     [[nodiscard]] bool arrived_dest() const noexcept;
 
+    /**
+     * Check if the next device of the chunk is its destination
+     * i.e., if only one link is left in the route
+     *
+     * @return true if the chunk is on its last hop, false otherwise
+     */
+    [[nodiscard]] bool next_device_is_dest() const noexcept;
+
+    /**
+     * Check if the chunk is a multicast chunk.
+     *
+     * @return true if the chunk follows a multicast route, false otherwise
+     */
+    [[nodiscard]] bool is_multicast() const noexcept;
+
+    /**
+     * Check if the multicast chunk arrived at one of its destinations
+     * i.e., if the branch it traversed ends at a destination.
+     *
+     * @return true if the current device is a destination, false otherwise
+     */
+    [[nodiscard]] bool arrived_multicast_dest() const noexcept;
+
+    /**
+     * Replicate the multicast chunk into every branch leaving its current device.
+     * The chunk must sit at the end of its branch (or at the source).
+     *
+     * @return chunks to be sent over each branch
+     */
+    [[nodiscard]] std::vector<std::unique_ptr<Chunk>> replicate() const noexcept;
+
     /**
      * Get the size of the chunk
      *
@@ -76,6 +172,7 @@ class Chunk {
     /**
      * Invoke the registered callback
      * i.e., this method should be called when the chunk arrives its destination.
+     * A multicast chunk passes the callback argument of the destination it arrived at.
      */
     void invoke_callback() noexcept;
 
@@ -83,17 +180,40 @@ class Chunk {
     /// size of the chunk
     ChunkSize chunk_size;
 
-    /// route of the chunk to its destination.
-    /// Route has the structure of [current device, next device, ..., dest device]
-    /// e.g., if a chunk starts from device 5, then reaches destination 3,
-    /// the route would be e.g., [5, 1, 6, 2, 3]
-    Route route;
+    /// links of the chunk from its source to destination
+    LinkRoute route;
+
+    /// number of links of the route the chunk already traversed
+    int hop;
+
+    /// device the chunk currently sits at
+    DeviceId current_device_id;
+
+    /// topology resolving the link ids of the route, set when the chunk is sent
+    const Topology* topology;
 
     /// callback to be invoked when the chunk arrives at its destination
     Callback callback;
 
     /// argument of the callback
     CallbackArg callback_arg;
+
+    /// multicast route, nullptr for unicast chunks
+    std::shared_ptr<const MulticastRoute> multicast_route;
+
+    /// callback argument per destination of the multicast route
+    std::shared_ptr<const std::vector<CallbackArg>> multicast_callback_args;
+
+    /// branch of the multicast route the chunk traverses, -1 while at the source
+    int branch_id;
+
+    /**
+     * Constructor of a multicast chunk replica.
+     *
+     * @param parent chunk being replicated
+     * @param branch_id branch the replica traverses
+     */
+    Chunk(const Chunk& parent, int branch_id) noexcept;
 };
 
 }  // namespace NetworkAnalyticalCongestionAware
@@ -42,14 +42,40 @@ class Device {
      */
     void send(std::unique_ptr<Chunk> chunk) noexcept;
 
+    /**
+     * Forward a multicast chunk sitting at this device:
+     * replicate it over every branch leaving this device,
+     * then invoke its callback if this device is one of its destinations.
+     *
+     * @param chunk multicast chunk at the source or at the end of a branch
+     */
+    void multicast(std::unique_ptr<Chunk> chunk) noexcept;
+
     /**
      * Connect a device to another device.
      *
      * @param id id of the device to connect this device to
+     * @param link_id id of the link in the link table of the topology
      * @param bandwidth bandwidth of the link
      * @param latency latency of the link
      */
-    void connect(DeviceId id, Bandwidth bandwidth, Latency latency) noexcept;
+    void connect(DeviceId id, LinkId link_id, Bandwidth bandwidth, Latency latency) noexcept;
+
+    /**
+     * Get the id of the link to another device.
+     * The device must be connected to this device.
+     *
+     * @param dest id of the connected device
+     * @return id of the link to the device
+     */
+    [[nodiscard]] LinkId get_link_id(DeviceId dest) const noexcept;
+
+    /**
+     * Get the links to other devices.
+     *
+     * @return map[dest device id] -> link
+     */
+    [[nodiscard]] const std::map<DeviceId, std::shared_ptr<Link>>& get_links() const noexcept;
 
   private:
     /// device Id
@@ -59,6 +85,10 @@ class Device {
     /// map[dest node node_id] -> link
     std::map<DeviceId, std::shared_ptr<Link>> links;
 
+    /// ids of the links to other nodes
+    /// map[dest node node_id] -> link id
+    std::map<DeviceId, LinkId> link_ids;
+
     /**
      * Check if this device is connected to another device.
      *
@@ -0,0 +1,164 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#pragma once
+
+#include "common/Type.h"
+#include "congestion_aware/LinkRoute.h"
+#include "congestion_aware/Type.h"
+#include <cstdint>
+#include <vector>
+
+using namespace NetworkAnalytical;
+
+namespace NetworkAnalyticalCongestionAware {
+
+/**
+ * GridRouteTable precomputes the minimal routes of a 2D grid (Mesh2D or Torus2D),
+ * with device id = row * cols + col.
+ *
+ * For every column (and row), the ids of the links heading south and north (east and west)
+ * are laid out in a flat table, twice in a row so that wrap-around segments stay contiguous.
+ * A dimension-ordered route is then two segments of the table (one per dimension),
+ * so routing a chunk neither allocates nor touches the devices.
+ *
+ * Routes follow the routing policy of the grid:
+ *   - XY: rows first (vertical), then columns (horizontal)
+ *   - YX: columns first, then rows
+ *   - O1Turn: XY or YX, chosen by a hash of (src, dest, sequence), i.e., pseudo-randomly per message
+ *   - Adaptive: XY or YX, whichever currently has fewer chunks pending on its links
+ *
+ * Adaptive routes are chosen once, when the route is constructed (i.e., the chunk is injected);
+ * chunks do not change their dimension order in flight.
+ * Multicast trees always use a single dimension order (XY, or YX under the YX policy),
+ * since the union of routes of mixed orders is not a tree.
+ */
+class GridRouteTable {
+  public:
+    /**
+     * Constructor.
+     * The links between the neighbors of the grid must be already connected.
+     *
+     * @param topology topology the grid links belong to
+     * @param rows number of rows
+     * @param cols number of columns
+     * @param wrap_around true if the grid has wrap-around links (Torus2D), false otherwise
+     * @param routing_policy routing policy of the grid
+     */
+    GridRouteTable(const Topology& topology,
+                   int rows,
+                   int cols,
+                   bool wrap_around,
+                   RoutingPolicy routing_policy) noexcept;
+
+    /**
+     * Construct the route from src to dest following the routing policy.
+     *
+     * @param src src device id
+     * @param dest dest device id
+     * @param sequence identifies the message among the ones from src to dest (O1Turn)
+     * @return links from src to dest
+     */
+    [[nodiscard]] LinkRoute route(DeviceId src, DeviceId dest, uint64_t sequence) const noexcept;
+
+    /**
+     * Construct the route from src to dest merged into multicast trees,
+     * in the dimension order shared by all dests.
+     *
+     * @param src src device id
+     * @param dest dest device id
+     * @return links from src to dest
+     */
+    [[nodiscard]] LinkRoute tree_route(DeviceId src, DeviceId dest) const noexcept;
+
+    /**
+     * Construct the dimension-ordered route from src to dest.
+     *
+     * @param src src device id
+     * @param dest dest device id
+     * @param rows_first true to traverse rows first (XY), false to traverse columns first (YX)
+     * @return links from src to dest
+     */
+    [[nodiscard]] LinkRoute dimension_order_route(DeviceId src, DeviceId dest, bool rows_first) const noexcept;
+
+  private:
+    /// contiguous links of a route along a single dimension
+    struct Segment {
+        /// first link of the segment
+        const LinkId* links;
+
+        /// number of links in the segment
+        int links_count;
+    };
+
+    /// direction of a line of links in the table
+    enum Direction {
+        South = 0,
+        North,
+        East,
+        West
+    };
+
+    /// topology the grid links belong to
+    const Topology* topology;
+
+    /// number of rows
+    int rows;
+
+    /// number of columns
+    int cols;
+
+    /// true if the grid has wrap-around links
+    bool wrap_around;
+
+    /// routing policy of the grid
+    RoutingPolicy routing_policy;
+
+    /// link ids of every line, each line stored twice in a row, -1 where no link exists
+    std::vector<LinkId> links;
+
+    /// offset of the first line of each direction in the table
+    int line_offsets[4];
+
+    /**
+     * Get the link entry of a line in the table.
+     *
+     * @param direction direction of the line
+     * @param line column (South/North) or row (East/West) of the line
+     * @param index index in the line
+     * @return pointer to the link id entry
+     */
+    [[nodiscard]] const LinkId* line(Direction direction, int line, int index) const noexcept;
+
+    /**
+     * Find the segment moving from src to dest along the rows of a column.
+     *
+     * @param col column of the segment
+     * @param src_row src row
+     * @param dest_row dest row
+     * @return links of the segment
+     */
+    [[nodiscard]] Segment row_segment(int col, int src_row, int dest_row) const noexcept;
+
+    /**
+     * Find the segment moving from src to dest along the columns of a row.
+     *
+     * @param row row of the segment
+     * @param src_col src column
+     * @param dest_col dest column
+     * @return links of the segment
+     */
+    [[nodiscard]] Segment col_segment(int row, int src_col, int dest_col) const noexcept;
+
+    /**
+     * Count the chunks pending on the links of a route.
+     *
+     * @param route route to inspect
+     * @return total number of pending chunks along the route
+     */
+    [[nodiscard]] int pending_chunks_count(const LinkRoute& route) const noexcept;
+};
+
+}  // namespace NetworkAnalyticalCongestionAware
@@ -7,7 +7,10 @@ LICENSE file in the root directory of this source tree.
 
 #include "common/EventQueue.h"
 #include "common/Type.h"
+#include "congestion_aware/LinkStats.h"
+#include "congestion_aware/SimulationRegion.h"
 #include "congestion_aware/Type.h"
+#include <cstdint>
 #include <memory>
 
 using namespace NetworkAnalytical;
@@ -29,12 +32,28 @@ class Link {
     static void link_become_free(void* link_ptr) noexcept;
 
     /**
-     * Set the event queue to be used by the link.
+     * Set the event queue to be used by the links.
+     * The event queue is kept per thread, so independent simulations can run on different threads.
      *
      * @param event_queue_ptr pointer to the event queue
      */
     static void set_event_queue(std::shared_ptr<EventQueue> event_queue_ptr) noexcept;
 
+    /**
+     * Set the width of the time buckets link utilization is recorded in.
+     * Must be set before any chunk is sent. Like the event queue, the width is kept per thread.
+     *
+     * @param bucket_width width of a time bucket in ns, 0 to disable bucketing
+     */
+    static void set_stats_bucket_width(EventTime bucket_width) noexcept;
+
+    /**
+     * Get the width of the time buckets link utilization is recorded in.
+     *
+     * @return width of a time bucket in ns, 0 if bucketing is disabled
+     */
+    [[nodiscard]] static EventTime get_stats_bucket_width() noexcept;
+
     /**
      * Constructor.
      *
@@ -43,6 +62,38 @@ class Link {
      */
     Link(Bandwidth bandwidth, Latency latency) noexcept;
 
+    /**
+     * Bind the link to the parallel simulation.
+     * Once bound, the link schedules its events to simulation regions
+     * instead of the shared event queue.
+     *
+     * @param region region of the device the link starts from
+     * @param next_region_id id of the region of the device the link leads to
+     */
+    void bind_region(SimulationRegion* region, int next_region_id) noexcept;
+
+    /**
+     * Get the bandwidth of the link.
+     *
+     * @return bandwidth of the link in GB/s
+     */
+    [[nodiscard]] Bandwidth get_bandwidth() const noexcept;
+
+    /**
+     * Get the latency of the link.
+     *
+     * @return latency of the link in ns
+     */
+    [[nodiscard]] Latency get_latency() const noexcept;
+
+    /**
+     * Get the traffic and occupancy counters of the link.
+     *
+     * @param end_time time the simulation ended, closing the pending chunks integral
+     * @return counters of the link
+     */
+    [[nodiscard]] LinkStats get_stats(EventTime end_time) const noexcept;
+
     /**
      * Try to send a chunk through the link.
      * - If the link is free, service the chunk immediately.
@@ -65,6 +116,13 @@ class Link {
      */
     [[nodiscard]] bool pending_chunk_exists() const noexcept;
 
+    /**
+     * Get the number of chunks waiting for the link.
+     *
+     * @return number of pending chunks
+     */
+    [[nodiscard]] int get_pending_chunks_count() const noexcept;
+
     /**
      * Set the link as busy.
      */
@@ -76,8 +134,11 @@ class Link {
     void set_free() noexcept;
 
   private:
-    /// event queue Link uses to schedule events
-    static std::shared_ptr<EventQueue> event_queue;
+    /// event queue Link uses to schedule events, of the simulation running on this thread
+    static thread_local std::shared_ptr<EventQueue> event_queue;
+
+    /// width of the time buckets link utilization is recorded in, 0 if disabled
+    static thread_local EventTime stats_bucket_width;
 
     /// bandwidth of the link in GB/s
     Bandwidth bandwidth;
@@ -94,6 +155,43 @@ class Link {
     /// flag to indicate if the link is busy
     bool busy;
 
+    /// region scheduling the link events, nullptr if the shared event queue is used
+    SimulationRegion* region;
+
+    /// id of the region of the device the link leads to
+    int next_region_id;
+
+    /// traffic and occupancy counters
+    LinkStats stats;
+
+    /// time the number of pending chunks last changed
+    EventTime pending_chunks_updated_time;
+
+    /**
+     * Get the current time of the link,
+     * from its simulation region if bound, from the event queue otherwise.
+     *
+     * @return current time
+     */
+    [[nodiscard]] EventTime current_time() const noexcept;
+
+    /**
+     * Accumulate the number of pending chunks over time,
+     * must be called before the pending chunks list changes.
+     *
+     * @param time current time
+     */
+    void update_pending_chunks_time(EventTime time) noexcept;
+
+    /**
+     * Record a chunk transmission in the counters.
+     *
+     * @param chunk_size size of the transmitted chunk
+     * @param start_time time the transmission starts
+     * @param serialization_time serialization delay of the chunk
+     */
+    void record_transmission(ChunkSize chunk_size, EventTime start_time, EventTime serialization_time) noexcept;
+
     /**
      * Compute the serialization delay of a chunk on the link.
      * i.e., serialization delay = (chunk size) / (link bandwidth)
@@ -121,6 +219,21 @@ class Link {
      * @param chunk chunk to be transmitted
      */
     void schedule_chunk_transmission(std::unique_ptr<Chunk> chunk) noexcept;
+
+    /**
+     * Schedule the chunk arrival and link free events to simulation regions,
+     * in the same order as to the shared event queue.
+     * - Link becomes free in its own region.
+     * - Chunk arrives at the region of the next device,
+     *   or is handed to the sequential part of the simulation at its destination.
+     *
+     * @param chunk chunk being transmitted
+     * @param communication_time communication delay of the chunk
+     * @param serialization_time serialization delay of the chunk
+     */
+    void schedule_region_events(std::unique_ptr<Chunk> chunk,
+                                EventTime communication_time,
+                                EventTime serialization_time) noexcept;
 };
 
 }  // namespace NetworkAnalyticalCongestionAware
@@ -0,0 +1,95 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#pragma once
+
+#include "congestion_aware/Type.h"
+#include <memory>
+#include <vector>
+
+namespace NetworkAnalyticalCongestionAware {
+
+/**
+ * LinkRoute is the sequence of links a chunk traverses
+ * from its source to destination, as link ids.
+ *
+ * The link ids are read from up to two contiguous segments
+ * of a table that outlives the route (e.g., the precomputed route table of Mesh2D),
+ * so constructing and copying a route does not allocate.
+ * Routes of other topologies own their link ids instead.
+ */
+class LinkRoute {
+  public:
+    /**
+     * Constructor of an empty route.
+     */
+    LinkRoute() noexcept;
+
+    /**
+     * Constructor of a route over one segment of a link table.
+     *
+     * @param links first link of the segment
+     * @param links_count number of links in the segment
+     */
+    LinkRoute(const LinkId* links, int links_count) noexcept;
+
+    /**
+     * Constructor of a route over two segments of link tables,
+     * traversed one after the other.
+     *
+     * @param first_links first link of the first segment
+     * @param first_count number of links in the first segment
+     * @param second_links first link of the second segment
+     * @param second_count number of links in the second segment
+     */
+    LinkRoute(const LinkId* first_links, int first_count, const LinkId* second_links, int second_count) noexcept;
+
+    /**
+     * Constructor of a route owning its link ids.
+     *
+     * @param links links from the source to the destination
+     */
+    explicit LinkRoute(std::vector<LinkId> links) noexcept;
+
+    /**
+     * Constructor of a route owning the ids of the links along a device route.
+     *
+     * @param route devices from the source to the destination
+     */
+    explicit LinkRoute(const Route& route) noexcept;
+
+    /**
+     * Get the number of links in the route.
+     *
+     * @return number of hops from the source to the destination
+     */
+    [[nodiscard]] int get_hops_count() const noexcept;
+
+    /**
+     * Get the link of a hop.
+     *
+     * @param hop index of the hop, from 0 to (hops count - 1)
+     * @return id of the link
+     */
+    [[nodiscard]] LinkId get_link(int hop) const noexcept;
+
+  private:
+    /// first segment of the route
+    const LinkId* first_links;
+
+    /// number of links in the first segment
+    int first_count;
+
+    /// second segment of the route
+    const LinkId* second_links;
+
+    /// number of links in the second segment
+    int second_count;
+
+    /// link ids owned by the route, nullptr if the segments point into a table
+    std::shared_ptr<const std::vector<LinkId>> owned_links;
+};
+
+}  // namespace NetworkAnalyticalCongestionAware
@@ -0,0 +1,53 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#pragma once
+
+#include "common/Type.h"
+#include <cstdint>
+#include <vector>
+
+using namespace NetworkAnalytical;
+
+namespace NetworkAnalyticalCongestionAware {
+
+/**
+ * LinkStats holds the traffic and occupancy counters of a link.
+ */
+struct LinkStats {
+    /// bytes carried by the link
+    uint64_t bytes;
+
+    /// number of chunks carried by the link
+    uint64_t chunks_count;
+
+    /// total serialization time, i.e., time the link was busy, in ns
+    EventTime busy_time;
+
+    /// maximum number of pending chunks
+    uint64_t max_pending_chunks;
+
+    /// integral of the number of pending chunks over time, in chunk * ns
+    double pending_chunks_time;
+
+    /// busy time per time bucket, empty if bucketing is disabled
+    std::vector<EventTime> bucket_busy_time;
+};
+
+/**
+ * LinkCoordinate locates a link in a 2D grid topology.
+ */
+struct LinkCoordinate {
+    /// row of the source device, -1 if the topology is not a grid
+    int row;
+
+    /// column of the source device, -1 if the topology is not a grid
+    int col;
+
+    /// direction of the link: 'N', 'S', 'E', 'W', or '-' if the topology is not a grid
+    char direction;
+};
+
+}  // namespace NetworkAnalyticalCongestionAware
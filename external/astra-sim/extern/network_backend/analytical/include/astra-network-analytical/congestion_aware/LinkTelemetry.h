@@ -0,0 +1,109 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#pragma once
+
+#include "common/Type.h"
+#include "congestion_aware/LinkStats.h"
+#include "congestion_aware/Topology.h"
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace NetworkAnalytical;
+
+namespace NetworkAnalyticalCongestionAware {
+
+/**
+ * LinkTelemetry aggregates the counters of every link of a topology
+ * at the end of the simulation, and dumps them into a file.
+ *
+ * Files ending with ".bin" are written in the binary format, others in CSV:
+ *   - CSV: one row per link with columns
+ *     src,dest,row,col,direction,bytes,chunks,busy_ns,utilization,max_pending,mean_pending
+ *     followed by the utilization of each time bucket (bucket_0, bucket_1, ...)
+ *   - binary (little-endian): header
+ *     "LINKSTAT", uint32 links count, uint32 buckets count, uint64 bucket width, uint64 end time,
+ *     then per link: int32 src, dest, row, col, uint8 direction,
+ *     uint64 bytes, chunks, busy_ns, max_pending, float64 mean_pending, float32 utilization per bucket
+ */
+class LinkTelemetry {
+  public:
+    /// aggregated counters of a link
+    struct LinkRecord {
+        /// source device of the link
+        DeviceId src;
+
+        /// destination device of the link
+        DeviceId dest;
+
+        /// coordinate of the link in the topology
+        LinkCoordinate coordinate;
+
+        /// counters of the link
+        LinkStats stats;
+    };
+
+    /**
+     * Constructor.
+     * Collects the counters of every link, in (src, dest) order.
+     *
+     * @param topology topology to collect the counters from
+     * @param end_time time the simulation ended
+     */
+    LinkTelemetry(const Topology& topology, EventTime end_time) noexcept;
+
+    /**
+     * Get the collected link records.
+     *
+     * @return records of every link
+     */
+    [[nodiscard]] const std::vector<LinkRecord>& get_records() const noexcept;
+
+    /**
+     * Dump the collected counters into a file.
+     *
+     * @param path path of the file, written in binary if ending with ".bin", in CSV otherwise
+     */
+    void dump(const std::string& path) const noexcept;
+
+  private:
+    /// time the simulation ended
+    EventTime end_time;
+
+    /// width of the time buckets, 0 if bucketing is disabled
+    EventTime bucket_width;
+
+    /// number of time buckets
+    size_t buckets_count;
+
+    /// records of every link
+    std::vector<LinkRecord> records;
+
+    /**
+     * Get the utilization of a link in a time bucket.
+     *
+     * @param record record of the link
+     * @param bucket index of the bucket
+     * @return fraction of the bucket the link was busy
+     */
+    [[nodiscard]] double bucket_utilization(const LinkRecord& record, size_t bucket) const noexcept;
+
+    /**
+     * Dump the collected counters in CSV.
+     *
+     * @param path path of the file
+     */
+    void dump_csv(const std::string& path) const noexcept;
+
+    /**
+     * Dump the collected counters in the binary format.
+     *
+     * @param path path of the file
+     */
+    void dump_binary(const std::string& path) const noexcept;
+};
+
+}  // namespace NetworkAnalyticalCongestionAware
@@ -1,7 +1,10 @@
 #pragma once
 
 #include "congestion_aware/BasicTopology.h"
+#include "congestion_aware/GridRouteTable.h"
+#include <memory>
 #include <utility>
+#include <vector>
 
 using namespace NetworkAnalytical;
 
@@ -9,10 +12,24 @@ namespace NetworkAnalyticalCongestionAware {
 
 class Mesh2D final : public BasicTopology {
   public:
-    Mesh2D(int npus_count, Bandwidth bandwidth, Latency latency, int rows, int cols) noexcept;
+    Mesh2D(int npus_count,
+           Bandwidth bandwidth,
+           Latency latency,
+           int rows,
+           int cols,
+           RoutingPolicy routing_policy = RoutingPolicy::XY) noexcept;
 
     [[nodiscard]] Route route(DeviceId src, DeviceId dest) const noexcept override;
 
+    [[nodiscard]] LinkRoute link_route(DeviceId src, DeviceId dest, uint64_t sequence = 0) const noexcept override;
+
+    [[nodiscard]] std::vector<int> partition_devices(int regions_count) const noexcept override;
+
+    [[nodiscard]] LinkCoordinate link_coordinate(DeviceId src, DeviceId dest) const noexcept override;
+
+  protected:
+    [[nodiscard]] Route tree_route(DeviceId src, DeviceId dest) const noexcept override;
+
   private:
     void connect_neighbors(Bandwidth bandwidth, Latency latency) noexcept;
     [[nodiscard]] int encode(int row, int col) const noexcept;
@@ -20,6 +37,9 @@ class Mesh2D final : public BasicTopology {
 
     int rows;
     int cols;
+
+    /// precomputed routes, following the routing policy
+    std::unique_ptr<GridRouteTable> route_table;
 };
 
 }  // namespace NetworkAnalyticalCongestionAware
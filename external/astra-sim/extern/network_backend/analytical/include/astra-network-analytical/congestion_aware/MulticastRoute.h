@@ -0,0 +1,94 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#pragma once
+
+#include "common/Type.h"
+#include "congestion_aware/Type.h"
+#include <vector>
+
+using namespace NetworkAnalytical;
+
+namespace NetworkAnalyticalCongestionAware {
+
+/**
+ * MulticastRoute is the tree a multicast chunk traverses
+ * from its source to a set of destinations.
+ *
+ * The tree is the union of the unicast routes to each destination,
+ * split into branches: a branch starts at the source or a branch point,
+ * and ends at a destination or where the tree forks.
+ * A chunk is replicated once per branch, so links shared by several
+ * destinations carry the chunk only once.
+ */
+class MulticastRoute {
+  public:
+    /// branch of the multicast tree
+    struct Branch {
+        /// devices the branch traverses, [branch start, ..., branch end]
+        Route route;
+
+        /// ids of the links the branch traverses
+        std::vector<LinkId> links;
+
+        /// index of the destination at the branch end, -1 if it is not a destination
+        int dest_index;
+
+        /// branches leaving from the branch end
+        std::vector<int> children;
+    };
+
+    /**
+     * Constructor.
+     *
+     * @param routes unicast route to each destination, all starting from the same source
+     */
+    explicit MulticastRoute(const std::vector<Route>& routes) noexcept;
+
+    /**
+     * Get the number of destinations.
+     *
+     * @return number of destinations
+     */
+    [[nodiscard]] int get_dests_count() const noexcept;
+
+    /**
+     * Get the branches leaving the source.
+     *
+     * @return ids of the branches leaving the source
+     */
+    [[nodiscard]] const std::vector<int>& get_src_branches() const noexcept;
+
+    /**
+     * Get a branch of the tree.
+     *
+     * @param branch_id id of the branch
+     * @return the branch
+     */
+    [[nodiscard]] const Branch& get_branch(int branch_id) const noexcept;
+
+    /**
+     * Get the number of links the tree traverses,
+     * i.e., the number of link transmissions of a multicast chunk.
+     *
+     * @return number of links in the tree
+     */
+    [[nodiscard]] int get_hops_count() const noexcept;
+
+  private:
+    /// number of destinations
+    int dests_count;
+
+    /// branches leaving the source
+    std::vector<int> src_branches;
+
+    /// all branches of the tree
+    std::vector<Branch> branches;
+
+    /// number of links in the tree
+    int hops_count;
+};
+
+}  // namespace NetworkAnalyticalCongestionAware
@@ -0,0 +1,209 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#pragma once
+
+#include "common/EventQueue.h"
+#include "common/EventScheduler.h"
+#include "congestion_aware/SimulationRegion.h"
+#include "congestion_aware/Topology.h"
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace NetworkAnalytical;
+
+namespace NetworkAnalyticalCongestionAware {
+
+/**
+ * ParallelSimulator runs the congestion-aware network with conservative
+ * parallel discrete-event simulation.
+ *
+ * Devices are partitioned into SimulationRegions, each simulated by its own thread.
+ * Regions advance together through time windows no longer than the lookahead
+ * (minimum link latency), so chunks crossing regions always arrive after the window.
+ * Chunk arrivals at their destinations and every event of the given EventQueue
+ * (i.e., the system layer) are invoked sequentially between windows,
+ * together with the region events of the same time.
+ *
+ * Every event is invoked in the order of the sequential simulation (see SimulationRegion),
+ * hence results are bit-identical to the sequential simulation for any number of threads.
+ * This costs a serial merge of the events invoked by each window.
+ */
+class ParallelSimulator {
+  public:
+    /**
+     * Constructor.
+     * Binds every link of the topology to its region,
+     * so it must be constructed before any chunk is sent.
+     *
+     * @param topology topology to simulate
+     * @param event_queue event queue of the sequential part of the simulation
+     * @param threads_count number of threads (and regions)
+     */
+    ParallelSimulator(std::shared_ptr<Topology> topology,
+                      std::shared_ptr<EventQueue> event_queue,
+                      int threads_count) noexcept;
+
+    /**
+     * Destructor.
+     */
+    ~ParallelSimulator() noexcept;
+
+    /**
+     * Run the simulation until no event is left.
+     */
+    void run() noexcept;
+
+    /**
+     * Get the number of regions the topology is partitioned into.
+     *
+     * @return number of regions
+     */
+    [[nodiscard]] int get_regions_count() const noexcept;
+
+    /**
+     * Get the lookahead used to synchronize the regions.
+     *
+     * @return lookahead in ns
+     */
+    [[nodiscard]] EventTime get_lookahead() const noexcept;
+
+  private:
+    /// command issued to the region threads
+    enum class Command { RunWindow, ResolveWindow, Stop };
+
+    /**
+     * SequentialScheduler replaces the scheduler of the event queue during the simulation,
+     * so the event queue invokes its events and the region events of the same time
+     * in the sequential invocation order.
+     */
+    class SequentialScheduler final : public EventScheduler {
+      public:
+        /**
+         * Constructor.
+         *
+         * @param regions spatial regions of the topology
+         * @param next_event_order order of the next invoked event, shared with the parallel windows
+         */
+        SequentialScheduler(const std::vector<std::unique_ptr<SimulationRegion>>& regions,
+                            SimulationRegion::EventOrder& next_event_order) noexcept;
+
+        [[nodiscard]] bool empty() const noexcept override;
+
+        [[nodiscard]] EventTime next_event_time() noexcept override;
+
+        void schedule(EventTime event_time, Callback callback, CallbackArg callback_arg) noexcept override;
+
+        [[nodiscard]] Event pop() noexcept override;
+
+        /**
+         * Register an event a region posted to be invoked sequentially.
+         *
+         * @param event posted event
+         */
+        void schedule_posted_event(const SimulationRegion::RegionEvent& event) noexcept;
+
+        /**
+         * Get the earliest pending event time, excluding the region events.
+         *
+         * @return earliest pending event time, SimulationRegion::no_event if none
+         */
+        [[nodiscard]] EventTime next_sequential_event_time() const noexcept;
+
+      private:
+        /// spatial regions of the topology
+        const std::vector<std::unique_ptr<SimulationRegion>>& regions;
+
+        /// order of the next invoked event
+        SimulationRegion::EventOrder& next_event_order;
+
+        /// events of the event queue and events posted by regions, as a min-heap
+        std::vector<SimulationRegion::RegionEvent> events;
+    };
+
+    /// topology being simulated
+    std::shared_ptr<Topology> topology;
+
+    /// event queue of the sequential part of the simulation
+    std::shared_ptr<EventQueue> event_queue;
+
+    /// spatial regions of the topology
+    std::vector<std::unique_ptr<SimulationRegion>> regions;
+
+    /// worker threads simulating regions 1, 2, ... (region 0 runs on the calling thread)
+    std::vector<std::thread> workers;
+
+    /// minimum link latency
+    EventTime lookahead;
+
+    /// outbox buffer regions write into during windows (the other one is received)
+    int window_buffer;
+
+    /// order of the next invoked event
+    SimulationRegion::EventOrder next_event_order;
+
+    /// scheduler of the event queue during the simulation (owned by the event queue)
+    SequentialScheduler* sequential_scheduler;
+
+    /// scheduler of the event queue before the simulation, restored on destruction
+    std::unique_ptr<EventScheduler> original_scheduler;
+
+    /// command of the current step
+    Command command;
+
+    /// end of the current window
+    EventTime window_end;
+
+    /// number of threads arrived at the barrier
+    std::atomic<int> arrived_count;
+
+    /// barrier generation, increased whenever all threads arrive
+    std::atomic<uint64_t> barrier_generation;
+
+    /**
+     * Bind every link of the topology to the region of its source device.
+     */
+    void bind_links() noexcept;
+
+    /**
+     * Collect the events regions posted to be invoked sequentially.
+     */
+    void collect_sequential_events() noexcept;
+
+    /**
+     * Get the earliest pending event time over all regions and their outboxes.
+     *
+     * @return earliest pending region event time, SimulationRegion::no_event if none
+     */
+    [[nodiscard]] EventTime next_region_event_time() const noexcept;
+
+    /**
+     * Invoke the events of the next event time sequentially,
+     * i.e., the events of the event queue and the region events of that time.
+     */
+    void run_sequential_step() noexcept;
+
+    /**
+     * Run a window on all region threads.
+     */
+    void run_parallel_window() noexcept;
+
+    /**
+     * Run the region thread loop.
+     *
+     * @param region_id id of the region the thread simulates
+     * @param stats_bucket_width link utilization bucket width of the simulation (kept per thread by Link)
+     */
+    void run_worker(int region_id, EventTime stats_bucket_width) noexcept;
+
+    /**
+     * Wait until all threads arrive.
+     */
+    void wait_barrier() noexcept;
+};
+
+}  // namespace NetworkAnalyticalCongestionAware
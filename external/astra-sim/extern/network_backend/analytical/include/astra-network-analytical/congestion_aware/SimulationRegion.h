@@ -0,0 +1,292 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#pragma once
+
+#include "common/Type.h"
+#include "congestion_aware/Type.h"
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <vector>
+
+using namespace NetworkAnalytical;
+
+namespace NetworkAnalyticalCongestionAware {
+
+/**
+ * SimulationRegion is a spatial partition of the topology
+ * simulated by its own thread in the parallel simulation mode.
+ *
+ * Events are invoked in the order of the sequential EventQueue:
+ * by event time, then by the order they were scheduled in.
+ * The schedule order of an event is identified by its EventKey,
+ * i.e., (schedule time, order of the event invoked when it was scheduled, index among the events that one scheduled),
+ * where invoked events are numbered in the sequential invocation order.
+ *
+ * During a window, a region numbers the events it invokes provisionally (by window-local sequence),
+ * which orders them correctly among the events of the region.
+ * Once every region finished the window, order_window() merges the windows of all regions
+ * into the sequential invocation order, and resolve_window() replaces the provisional numbers.
+ */
+class SimulationRegion {
+  public:
+    /// order of an invoked event in the sequential invocation order
+    using EventOrder = uint64_t;
+
+    /// event time representing "no event"
+    static constexpr EventTime no_event = std::numeric_limits<EventTime>::max();
+
+    /// position of an event in the sequential invocation order
+    struct EventKey {
+        /// time of event
+        EventTime event_time;
+
+        /// time the event was scheduled at
+        EventTime schedule_time;
+
+        /// order of the event invoked when this event was scheduled
+        EventOrder parent_order;
+
+        /// index among the events scheduled by the same invoked event
+        uint64_t child_index;
+    };
+
+    /// event held by a region
+    struct RegionEvent {
+        /// position in the sequential invocation order
+        EventKey key;
+
+        /// callback function pointer
+        Callback callback;
+
+        /// argument of the callback function
+        CallbackArg callback_arg;
+    };
+
+    /**
+     * Mark the start of an event invocation on the calling thread.
+     * Events scheduled from now on by this thread are ordered as scheduled by this invocation.
+     *
+     * @param event_time time of the invoked event
+     * @param event_order order of the invoked event
+     */
+    static void begin_invocation(EventTime event_time, EventOrder event_order) noexcept;
+
+    /**
+     * Get the key of the next event scheduled by the current invocation of the calling thread.
+     *
+     * @param event_time time of event
+     * @return key of the event
+     */
+    [[nodiscard]] static EventKey make_event_key(EventTime event_time) noexcept;
+
+    /**
+     * Check whether an event precedes another one in the sequential invocation order.
+     *
+     * @param lhs key of an event
+     * @param rhs key of another event
+     * @return true if lhs is invoked before rhs
+     */
+    [[nodiscard]] static bool precedes(const EventKey& lhs, const EventKey& rhs) noexcept;
+
+    /**
+     * Heap ordering: the event invoked later sinks.
+     */
+    [[nodiscard]] static bool later(const RegionEvent& lhs, const RegionEvent& rhs) noexcept;
+
+    /**
+     * Number the events invoked by all regions during the last window in the sequential invocation order.
+     * Must be called once every region finished the window.
+     *
+     * @param regions all regions of the simulation
+     * @param first_order order of the first event invoked during the window
+     * @return order of the first event invoked after the window
+     */
+    [[nodiscard]] static EventOrder order_window(const std::vector<std::unique_ptr<SimulationRegion>>& regions,
+                                                 EventOrder first_order) noexcept;
+
+    /**
+     * Constructor.
+     *
+     * @param region_id id of the region
+     * @param regions_count total number of regions
+     */
+    SimulationRegion(int region_id, int regions_count) noexcept;
+
+    /**
+     * Get the current event time of the region.
+     *
+     * @return current event time
+     */
+    [[nodiscard]] EventTime get_current_time() const noexcept;
+
+    /**
+     * Set the current event time of the region.
+     * Used when the sequential part of the simulation acts on the region.
+     *
+     * @param event_time new current event time
+     */
+    void set_current_time(EventTime event_time) noexcept;
+
+    /**
+     * Schedule an event to be invoked by this region.
+     *
+     * @param event_time time of event
+     * @param callback callback function pointer
+     * @param callback_arg argument of the callback function
+     */
+    void schedule_event(EventTime event_time, Callback callback, CallbackArg callback_arg) noexcept;
+
+    /**
+     * Post an event to be invoked by the given region.
+     * Events of other regions are buffered until the next synchronization.
+     *
+     * @param region_id id of the region to invoke the event
+     * @param event_time time of event
+     * @param callback callback function pointer
+     * @param callback_arg argument of the callback function
+     */
+    void post_event(int region_id, EventTime event_time, Callback callback, CallbackArg callback_arg) noexcept;
+
+    /**
+     * Post an event to be invoked sequentially, outside any region.
+     * i.e., chunks arriving at their destinations, which call back into the system layer.
+     *
+     * @param event_time time of event
+     * @param callback callback function pointer
+     * @param callback_arg argument of the callback function
+     */
+    void post_sequential_event(EventTime event_time, Callback callback, CallbackArg callback_arg) noexcept;
+
+    /**
+     * Select the outbox buffer posted events are written into.
+     *
+     * @param buffer index of the outbox buffer (0 or 1)
+     */
+    void set_outbox_buffer(int buffer) noexcept;
+
+    /**
+     * Get the earliest event time posted into the given outbox buffer.
+     *
+     * @param buffer index of the outbox buffer (0 or 1)
+     * @return earliest posted event time, no_event if none
+     */
+    [[nodiscard]] EventTime get_outbox_time(int buffer) const noexcept;
+
+    /**
+     * Mark the given outbox buffer as drained.
+     *
+     * @param buffer index of the outbox buffer (0 or 1)
+     */
+    void clear_outbox_time(int buffer) noexcept;
+
+    /**
+     * Get the earliest pending event time of the region.
+     *
+     * @return earliest pending event time, no_event if none
+     */
+    [[nodiscard]] EventTime next_event_time() const noexcept;
+
+    /**
+     * Get the key of the earliest pending event of the region.
+     * The region must have a pending event.
+     *
+     * @return key of the earliest pending event
+     */
+    [[nodiscard]] const EventKey& get_next_event_key() const noexcept;
+
+    /**
+     * Dequeue the earliest pending event, to be invoked by the sequential part of the simulation.
+     * The region must have a pending event.
+     *
+     * @return dequeued event
+     */
+    [[nodiscard]] RegionEvent take_next_event() noexcept;
+
+    /**
+     * Take the events posted to be invoked sequentially.
+     *
+     * @return posted sequential events
+     */
+    [[nodiscard]] std::vector<RegionEvent> take_sequential_events() noexcept;
+
+    /**
+     * Receive the events other regions posted to this region into the given buffer.
+     *
+     * @param regions all regions of the simulation
+     * @param buffer index of the outbox buffer to receive from
+     */
+    void receive_events(const std::vector<std::unique_ptr<SimulationRegion>>& regions, int buffer) noexcept;
+
+    /**
+     * Receive the events other regions posted to this region into the given buffer,
+     * then invoke all events earlier than the given time.
+     *
+     * @param regions all regions of the simulation
+     * @param buffer index of the outbox buffer to receive from
+     * @param window_end events earlier than this time are invoked
+     */
+    void run_window(const std::vector<std::unique_ptr<SimulationRegion>>& regions,
+                    int buffer,
+                    EventTime window_end) noexcept;
+
+    /**
+     * Replace the provisional orders of the events invoked during the last window
+     * by the ones assigned by order_window(), in every event this region holds.
+     */
+    void resolve_window() noexcept;
+
+  private:
+    /// flag of the provisional orders, the other bits are the index in the window
+    static constexpr EventOrder provisional_order = EventOrder{1} << 63;
+
+    /// time of the event being invoked by this thread
+    static thread_local EventTime invocation_time;
+
+    /// order of the event being invoked by this thread
+    static thread_local EventOrder invocation_order;
+
+    /// number of events scheduled by the event being invoked by this thread
+    static thread_local uint64_t invocation_children_count;
+
+    /// id of the region
+    int region_id;
+
+    /// current time of the region
+    EventTime current_time;
+
+    /// binary min-heap of pending events
+    std::vector<RegionEvent> events;
+
+    /// events posted to other regions: outboxes[buffer][destination region]
+    std::vector<std::vector<RegionEvent>> outboxes[2];
+
+    /// earliest event time posted into each outbox buffer
+    EventTime outbox_times[2];
+
+    /// outbox buffer posted events are written into
+    int outbox_buffer;
+
+    /// events to be invoked sequentially
+    std::vector<RegionEvent> sequential_events;
+
+    /// keys of the events invoked during the current window, in invocation order
+    std::vector<EventKey> window_events;
+
+    /// orders assigned to the events invoked during the current window
+    std::vector<EventOrder> window_orders;
+
+    /**
+     * Get the order of the event invoked during the current window, given its provisional order.
+     * Orders that are not provisional are returned as is.
+     *
+     * @param event_order possibly provisional order
+     * @return order in the sequential invocation order
+     */
+    [[nodiscard]] EventOrder resolve_order(EventOrder event_order) const noexcept;
+};
+
+}  // namespace NetworkAnalyticalCongestionAware
@@ -8,6 +8,10 @@ LICENSE file in the root directory of this source tree.
 #include "common/EventQueue.h"
 #include "congestion_aware/Chunk.h"
 #include "congestion_aware/Device.h"
+#include "congestion_aware/LinkRoute.h"
+#include "congestion_aware/LinkStats.h"
+#include "congestion_aware/MulticastRoute.h"
+#include <cstdint>
 #include <memory>
 #include <vector>
 
@@ -21,7 +25,7 @@ namespace NetworkAnalyticalCongestionAware {
 class Topology {
   public:
     /**
-     * Set the event queue to be used by the topology.
+     * Set the event queue to be used by the topologies constructed on the calling thread.
      *
      * @param event_queue pointer to the event queue
      */
@@ -46,8 +50,39 @@ class Topology {
      */
     [[nodiscard]] virtual Route route(DeviceId src, DeviceId dest) const noexcept = 0;
 
+    /**
+     * Construct the route from src to dest as link ids,
+     * which is what chunks traverse.
+     * By default, the links along route(src, dest).
+     *
+     * Topologies choosing among several routes per chunk (e.g., O1TURN)
+     * derive the choice from (src, dest, sequence), so the same message gets the same route
+     * regardless of the order (or thread) routes are constructed in.
+     *
+     * @param src src NPU id
+     * @param dest dest NPU id
+     * @param sequence identifies the message among the ones from src to dest
+     *
+     * @return links from src NPU to dest NPU
+     */
+    [[nodiscard]] virtual LinkRoute link_route(DeviceId src, DeviceId dest, uint64_t sequence = 0) const noexcept;
+
+    /**
+     * Construct the multicast route from src to a set of dests.
+     * The tree is the union of tree_route(src, dest) over all dests,
+     * e.g., dimension-ordered trees for Mesh2D and Torus2D.
+     *
+     * @param src src NPU id
+     * @param dests distinct dest NPU ids, excluding src
+     *
+     * @return multicast route from src NPU to dest NPUs
+     */
+    [[nodiscard]] std::shared_ptr<MulticastRoute> multicast_route(DeviceId src,
+                                                                  const std::vector<DeviceId>& dests) const noexcept;
+
     /**
      * Initiate a transmission of a chunk.
+     * A multicast chunk is replicated along its multicast route.
      *
      * @param chunk chunk to be transmitted
      */
@@ -90,6 +125,56 @@ class Topology {
      */
     [[nodiscard]] std::vector<Bandwidth> get_bandwidth_per_dim() const noexcept;
 
+    /**
+     * Get a device of the topology.
+     *
+     * @param id id of the device
+     * @return pointer to the device
+     */
+    [[nodiscard]] const std::shared_ptr<Device>& get_device(DeviceId id) const noexcept;
+
+    /**
+     * Get the number of links in the topology.
+     *
+     * @return number of links in the topology
+     */
+    [[nodiscard]] int get_links_count() const noexcept;
+
+    /**
+     * Get a link of the topology.
+     *
+     * @param id id of the link
+     * @return pointer to the link
+     */
+    [[nodiscard]] Link* get_link(LinkId id) const noexcept;
+
+    /**
+     * Get the device a link leads to.
+     *
+     * @param id id of the link
+     * @return id of the dest device of the link
+     */
+    [[nodiscard]] DeviceId get_link_dest(LinkId id) const noexcept;
+
+    /**
+     * Partition the devices into regions for the parallel simulation.
+     * By default, devices are split into contiguous id ranges.
+     *
+     * @param regions_count number of regions, not larger than the number of devices
+     * @return region id of each device
+     */
+    [[nodiscard]] virtual std::vector<int> partition_devices(int regions_count) const noexcept;
+
+    /**
+     * Locate the link from src to dest in the topology, for telemetry dumps.
+     * By default, links have no coordinate.
+     *
+     * @param src src device id
+     * @param dest dest device id
+     * @return coordinate of the link
+     */
+    [[nodiscard]] virtual LinkCoordinate link_coordinate(DeviceId src, DeviceId dest) const noexcept;
+
   protected:
     /// number of total devices in the topology
     /// device includes non-NPU devices such as switches
@@ -111,11 +196,37 @@ class Topology {
     /// bandwidth per each network dimension
     std::vector<Bandwidth> bandwidth_per_dim;
 
+    /// holds the entire links in the topology, indexed by link id
+    std::vector<std::shared_ptr<Link>> links;
+
+    /// dest device id of each link, indexed by link id
+    std::vector<DeviceId> link_dests;
+
     /**
      * Instantiate Device objects in the topology.
      */
     void instantiate_devices() noexcept;
 
+    /**
+     * Construct the route of devices a LinkRoute traverses.
+     *
+     * @param src src device id
+     * @param link_route links from src
+     * @return devices from src to the end of the links, including both ends
+     */
+    [[nodiscard]] Route device_route(DeviceId src, const LinkRoute& link_route) const noexcept;
+
+    /**
+     * Construct the route from src to dest merged into multicast trees.
+     * Routes to different dests must only share a prefix, so that their union is a tree.
+     * By default, route(src, dest).
+     *
+     * @param src src NPU id
+     * @param dest dest NPU id
+     * @return route from src NPU to dest NPU
+     */
+    [[nodiscard]] virtual Route tree_route(DeviceId src, DeviceId dest) const noexcept;
+
     /**
      * Connect src -> dest with the given bandwidth and latency.
      * (i.e., a `Link` gets constructed between the two npus)
@@ -129,6 +240,17 @@ class Topology {
      * @param bidirectional true if connection is bidirectional, false otherwise
      */
     void connect(DeviceId src, DeviceId dest, Bandwidth bandwidth, Latency latency, bool bidirectional = true) noexcept;
+
+  private:
+    /**
+     * Construct the src -> dest link and register it in the link table.
+     *
+     * @param src src device id
+     * @param dest dest device id
+     * @param bandwidth bandwidth of link
+     * @param latency latency of link
+     */
+    void add_link(DeviceId src, DeviceId dest, Bandwidth bandwidth, Latency latency) noexcept;
 };
 
 }  // namespace NetworkAnalyticalCongestionAware
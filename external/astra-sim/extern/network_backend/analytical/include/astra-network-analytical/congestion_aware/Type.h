@@ -14,8 +14,12 @@ namespace NetworkAnalyticalCongestionAware {
 class Chunk;
 class Link;
 class Device;
+class Topology;
 
 /// Route is a list of devices
 using Route = std::list<std::shared_ptr<Device>>;
 
+/// Link ID, index of the link in the link table of its topology
+using LinkId = int;
+
 }  // namespace NetworkAnalyticalCongestionAware
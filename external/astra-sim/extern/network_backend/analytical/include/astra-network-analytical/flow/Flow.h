@@ -0,0 +1,50 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#pragma once
+
+#include "common/Type.h"
+#include "congestion_aware/Type.h"
+#include <vector>
+
+using namespace NetworkAnalytical;
+using namespace NetworkAnalyticalCongestionAware;
+
+namespace NetworkAnalyticalFlow {
+
+/**
+ * Flow is a message being transmitted over every link of its route at once,
+ * at the rate assigned by max-min fair sharing of the link bandwidths.
+ */
+struct Flow {
+    /// links from the source to the destination
+    std::vector<LinkId> links;
+
+    /// true while the flow is being transmitted
+    bool active;
+
+    /// size of the message in bytes
+    ChunkSize size;
+
+    /// bytes not transmitted yet
+    double remaining_bytes;
+
+    /// current rate in B/ns
+    double rate;
+
+    /// time the last byte leaves the source at the current rate
+    EventTime finish_time;
+
+    /// sum of the link latencies along the route in ns
+    EventTime latency;
+
+    /// callback to be invoked when the flow arrives at its destination
+    Callback callback;
+
+    /// argument of the callback
+    CallbackArg callback_arg;
+};
+
+}  // namespace NetworkAnalyticalFlow
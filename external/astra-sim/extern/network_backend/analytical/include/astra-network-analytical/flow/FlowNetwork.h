@@ -0,0 +1,188 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#pragma once
+
+#include "common/EventQueue.h"
+#include "common/Type.h"
+#include "congestion_aware/Topology.h"
+#include "flow/Flow.h"
+#include <cstdint>
+#include <memory>
+#include <set>
+#include <vector>
+
+using namespace NetworkAnalytical;
+using namespace NetworkAnalyticalCongestionAware;
+
+namespace NetworkAnalyticalFlow {
+
+/**
+ * FlowNetwork simulates messages as flows instead of store-and-forward chunks.
+ *
+ * A flow occupies every link of its route from the time it is sent,
+ * and active flows share the link bandwidths with max-min fairness.
+ * Rates are recomputed only when flows start or finish (once per simulated time),
+ * so a message costs a single completion event no matter how many hops it takes.
+ * The last byte leaves the source at the finish time,
+ * and arrives at the destination after the latencies of the route.
+ *
+ * Devices, links, and routes are the ones of the congestion-aware topology.
+ */
+class FlowNetwork {
+  public:
+    /**
+     * Constructor.
+     *
+     * @param topology topology providing the links and routes
+     * @param event_queue event queue to schedule the completion events to
+     */
+    FlowNetwork(std::shared_ptr<Topology> topology, std::shared_ptr<EventQueue> event_queue) noexcept;
+
+    /**
+     * Start a flow from src to dest.
+     *
+     * @param src source device id
+     * @param dest destination device id
+     * @param size size of the message in bytes
+     * @param callback callback to be invoked when the flow arrives at dest
+     * @param callback_arg argument of the callback
+     * @param sequence identifies the message among the ones from src to dest (see Topology::link_route)
+     */
+    void send(DeviceId src,
+              DeviceId dest,
+              ChunkSize size,
+              Callback callback,
+              CallbackArg callback_arg,
+              uint64_t sequence = 0) noexcept;
+
+    /**
+     * Get the topology of the network.
+     *
+     * @return topology
+     */
+    [[nodiscard]] const std::shared_ptr<Topology>& get_topology() const noexcept;
+
+    /**
+     * Get the number of flows being transmitted.
+     *
+     * @return number of active flows
+     */
+    [[nodiscard]] int get_active_flows_count() const noexcept;
+
+    /**
+     * Get the number of times the flow rates were recomputed.
+     *
+     * @return number of rate updates
+     */
+    [[nodiscard]] uint64_t get_rate_updates_count() const noexcept;
+
+  private:
+    /// fair share of the bandwidth of a link among its flows without rate
+    struct LinkShare {
+        /// rate each flow without rate would get from the link in B/ns
+        double share;
+
+        /// link id
+        LinkId link_id;
+
+        /// order shares by (share, link id) to pick the bottleneck first
+        bool operator>(const LinkShare& other) const noexcept {
+            return share != other.share ? share > other.share : link_id > other.link_id;
+        }
+    };
+
+    /// topology providing the links and routes
+    std::shared_ptr<Topology> topology;
+
+    /// event queue to schedule the completion events to
+    std::shared_ptr<EventQueue> event_queue;
+
+    /// bandwidth of each link in B/ns
+    std::vector<Bandwidth> link_bandwidths;
+
+    /// flows by slot, including finished flows whose slots are not released yet
+    std::vector<Flow> flows;
+
+    /// number of flows being transmitted
+    int active_flows_count;
+
+    /// slots to reuse for new flows
+    std::vector<int> free_slots;
+
+    /// slots of the flows finished since the last rate update
+    std::vector<int> finished_slots;
+
+    /// slots of the flows crossing each link, finished flows are removed at the next rate update
+    std::vector<std::vector<int>> link_flows;
+
+    /// flows sent since the last update
+    std::vector<Flow> new_flows;
+
+    /// time the remaining bytes of the active flows were last updated
+    EventTime last_update_time;
+
+    /// times of the update events not invoked yet
+    std::set<EventTime> update_times;
+
+    /// number of rate updates
+    uint64_t rate_updates_count;
+
+    /// bandwidth not yet assigned per link (scratch space of assign_rates)
+    std::vector<double> remaining_bandwidths;
+
+    /// number of flows without rate per link (scratch space of assign_rates)
+    std::vector<int> unassigned_flows_counts;
+
+    /// min-heap of the fair shares, possibly outdated (scratch space of assign_rates)
+    std::vector<LinkShare> link_shares;
+
+    /**
+     * Callback of the update events.
+     *
+     * @param flow_network_ptr pointer to the flow network
+     */
+    static void update(void* flow_network_ptr) noexcept;
+
+    /**
+     * Schedule an update event at the given time,
+     * unless an update is already scheduled at or before it.
+     *
+     * @param update_time time of the update
+     */
+    void schedule_update(EventTime update_time) noexcept;
+
+    /**
+     * Finish and admit flows at the current time,
+     * recompute the rates if the active flows changed,
+     * and schedule the update of the next finish time.
+     */
+    void update_flows() noexcept;
+
+    /**
+     * Subtract the bytes transmitted since the last update from the active flows.
+     *
+     * @param current_time current time
+     */
+    void drain_flows(EventTime current_time) noexcept;
+
+    /**
+     * Add a flow to the active flows.
+     *
+     * @param flow flow to be transmitted
+     */
+    void admit_flow(Flow flow) noexcept;
+
+    /**
+     * Assign max-min fair rates to the active flows by progressive filling,
+     * and recompute their finish times.
+     * Finished flows are removed from the links, and their slots released.
+     *
+     * @param current_time current time
+     */
+    void assign_rates(EventTime current_time) noexcept;
+};
+
+}  // namespace NetworkAnalyticalFlow
@@ -5,10 +5,24 @@ LICENSE file in the root directory of this source tree.
 
 #include "common/EventQueue.h"
 #include "common/NetworkParser.h"
+#include "common/SlabAllocator.h"
 #include "common/Type.h"
 #include "congestion_aware/Chunk.h"
 #include "congestion_aware/Helper.h"
+#include "congestion_aware/Link.h"
+#include "congestion_aware/LinkTelemetry.h"
+#include "congestion_aware/Mesh2D.h"
+#include "congestion_aware/ParallelSimulator.h"
+#include "congestion_aware/Torus2D.h"
 #include <gtest/gtest.h>
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <random>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
 
 using namespace NetworkAnalytical;
 using namespace NetworkAnalyticalCongestionAware;
@@ -118,6 +132,88 @@ TEST_F(TestNetworkAnalyticalCongestionAware, ButterflyRoute) {
     EXPECT_EQ(route.size(), 4);  // src + two router stages + dest
 }
 
+TEST_F(TestNetworkAnalyticalCongestionAware, Mesh2DRoutingPolicies) {
+    const auto device_ids = [](const Route& route) {
+        auto ids = std::vector<DeviceId>();
+        for (const auto& device : route) {
+            ids.push_back(device->get_id());
+        }
+        return ids;
+    };
+
+    const auto xy = Mesh2D(16, 50, 500, 4, 4, RoutingPolicy::XY);
+    EXPECT_EQ(device_ids(xy.route(0, 15)), (std::vector<DeviceId>{0, 4, 8, 12, 13, 14, 15}));
+    EXPECT_EQ(xy.link_route(0, 15).get_hops_count(), 6);
+    EXPECT_EQ(xy.link_route(5, 5).get_hops_count(), 0);
+
+    const auto yx = Mesh2D(16, 50, 500, 4, 4, RoutingPolicy::YX);
+    EXPECT_EQ(device_ids(yx.route(0, 15)), (std::vector<DeviceId>{0, 1, 2, 3, 7, 11, 15}));
+    EXPECT_EQ(device_ids(yx.route(15, 0)), (std::vector<DeviceId>{15, 14, 13, 12, 8, 4, 0}));
+
+    // link ids of a route resolve to the same devices
+    const auto route = xy.link_route(0, 15);
+    auto dest = DeviceId{0};
+    for (auto hop = 0; hop < route.get_hops_count(); hop++) {
+        const auto link_id = route.get_link(hop);
+        EXPECT_EQ(xy.get_device(dest)->get_link_id(xy.get_link_dest(link_id)), link_id);
+        dest = xy.get_link_dest(link_id);
+    }
+    EXPECT_EQ(dest, 15);
+}
+
+TEST_F(TestNetworkAnalyticalCongestionAware, Torus2DRoutingPolicies) {
+    const auto torus = Torus2D(16, 50, 500, 4, 4, RoutingPolicy::XY);
+    const auto route = torus.route(0, 15);
+    ASSERT_EQ(route.size(), 3);  // wrap-around in both dimensions
+    EXPECT_EQ(route.front()->get_id(), 0);
+    EXPECT_EQ((*std::next(route.begin()))->get_id(), 12);
+    EXPECT_EQ(route.back()->get_id(), 15);
+
+    // O1TURN takes both dimension orders over the messages of a pair, the same one for the same message
+    const auto o1turn = Torus2D(16, 50, 500, 4, 4, RoutingPolicy::O1Turn);
+    auto second_hops = std::set<DeviceId>();
+    for (auto sequence = uint64_t{0}; sequence < 64; sequence++) {
+        const auto second_hop = o1turn.get_link_dest(o1turn.link_route(0, 5, sequence).get_link(0));
+        EXPECT_EQ(o1turn.get_link_dest(o1turn.link_route(0, 5, sequence).get_link(0)), second_hop);
+        second_hops.insert(second_hop);
+    }
+    EXPECT_EQ(second_hops, (std::set<DeviceId>{1, 4}));
+
+    // multicast trees keep a single dimension order
+    auto dests = std::vector<DeviceId>();
+    for (auto dest = 1; dest < 16; dest++) {
+        dests.push_back(dest);
+    }
+    EXPECT_EQ(o1turn.multicast_route(0, dests)->get_hops_count(), 15);  // spanning tree
+}
+
+TEST_F(TestNetworkAnalyticalCongestionAware, AdaptiveRoutingOnMesh2D) {
+    /// setup
+    const auto network_parser = NetworkParser("../../input/Mesh2D_Adaptive.yml");
+    EXPECT_EQ(network_parser.get_routing_policy(), RoutingPolicy::Adaptive);
+    const auto topology = construct_topology(network_parser);
+
+    /// idle links: ties take XY
+    EXPECT_EQ(topology->get_link_dest(topology->link_route(0, 5).get_link(0)), 4);
+
+    /// congest the link 0 -> 4
+    for (auto i = 0; i < 3; i++) {
+        auto route = topology->link_route(0, 4);
+        auto chunk = std::make_unique<Chunk>(chunk_size, 0, std::move(route), callback, nullptr);
+        topology->send(std::move(chunk));
+    }
+    EXPECT_EQ(topology->get_link(topology->link_route(0, 4).get_link(0))->get_pending_chunks_count(), 2);
+
+    /// test: the route avoids the congested link
+    EXPECT_EQ(topology->get_link_dest(topology->link_route(0, 5).get_link(0)), 1);
+
+    /// Run simulation
+    while (!event_queue->finished()) {
+        event_queue->proceed();
+    }
+    EXPECT_EQ(topology->get_link_dest(topology->link_route(0, 5).get_link(0)), 4);
+}
+
 TEST_F(TestNetworkAnalyticalCongestionAware, AllGatherOnRing) {
     /// setup
     const auto network_parser = NetworkParser("../../input/Ring.yml");
@@ -153,3 +249,384 @@ TEST_F(TestNetworkAnalyticalCongestionAware, AllGatherOnRing) {
     const auto simulation_time = event_queue->get_current_time();
     EXPECT_EQ(simulation_time, 704'116);
 }
+
+TEST_F(TestNetworkAnalyticalCongestionAware, AllGatherOnRingPerEventScheduler) {
+    const auto scheduler_types = {EventSchedulerType::Linear, EventSchedulerType::Heap, EventSchedulerType::Calendar};
+
+    for (const auto scheduler_type : scheduler_types) {
+        /// setup
+        event_queue = std::make_shared<EventQueue>(scheduler_type);
+        Topology::set_event_queue(event_queue);
+        const auto network_parser = NetworkParser("../../input/Ring.yml");
+        const auto topology = construct_topology(network_parser);
+        const auto npus_count = topology->get_npus_count();
+
+        /// Run All-Gather
+        for (int i = 0; i < npus_count; i++) {
+            for (int j = 0; j < npus_count; j++) {
+                if (i == j) {
+                    continue;
+                }
+
+                auto route = topology->route(i, j);
+                auto chunk = std::make_unique<Chunk>(chunk_size, route, callback, nullptr);
+                topology->send(std::move(chunk));
+            }
+        }
+
+        /// Run simulation
+        while (!event_queue->finished()) {
+            event_queue->proceed();
+        }
+
+        /// test
+        const auto simulation_time = event_queue->get_current_time();
+        EXPECT_EQ(simulation_time, 704'116);
+    }
+}
+
+TEST_F(TestNetworkAnalyticalCongestionAware, EventSchedulersMatchHeapOrder) {
+    /// hold model: every invoked event records its id and schedules new events at random delays,
+    /// with many simultaneous (and zero-delay) events, and rare far jumps resizing the calendar
+    struct HoldModel {
+        EventQueue* event_queue;
+        std::mt19937_64 random_engine;
+        std::vector<std::pair<HoldModel*, int>> events;
+        std::vector<std::pair<EventTime, int>> invoked_events;
+        int events_limit;
+
+        void schedule(const EventTime delay) {
+            const auto id = static_cast<int>(events.size());
+            events.emplace_back(this, id);
+            event_queue->schedule_event(event_queue->get_current_time() + delay, invoke, &events.back());
+        }
+
+        EventTime random_delay() {
+            const auto kind = random_engine() % 64;
+            if (kind < 16) {
+                return 0;
+            }
+            if (kind < 40) {
+                return 1 + random_engine() % 4;
+            }
+            if (kind < 63) {
+                return random_engine() % 1'000;
+            }
+            return 1'000'000 + random_engine() % 10'000'000;
+        }
+
+        static void invoke(void* const arg) {
+            const auto [model, id] = *static_cast<std::pair<HoldModel*, int>*>(arg);
+            model->invoked_events.emplace_back(model->event_queue->get_current_time(), id);
+
+            // grow the population up to half the events, then drain it
+            const auto scheduled_count = static_cast<int>(model->events.size());
+            const auto children_count = (scheduled_count < model->events_limit / 2) ? 2 : model->random_engine() % 2;
+            for (auto i = 0; i < static_cast<int>(children_count); i++) {
+                if (static_cast<int>(model->events.size()) < model->events_limit) {
+                    model->schedule(model->random_delay());
+                }
+            }
+        }
+    };
+
+    const auto run_hold_model = [](const EventSchedulerType scheduler_type) {
+        const auto events_limit = 200'000;
+        auto event_queue = EventQueue(scheduler_type);
+        auto model = HoldModel{&event_queue, std::mt19937_64(2'024), {}, {}, events_limit};
+        model.events.reserve(events_limit);  // arguments must not move
+
+        for (auto i = 0; i < 1'000; i++) {
+            model.schedule(model.random_engine() % 100);
+        }
+        while (!event_queue.finished()) {
+            event_queue.proceed();
+        }
+
+        EXPECT_EQ(model.invoked_events.size(), model.events.size());
+        return model.invoked_events;
+    };
+
+    /// test: every scheduler invokes the events in the order of the binary heap
+    const auto heap_order = run_hold_model(EventSchedulerType::Heap);
+    EXPECT_TRUE(std::is_sorted(heap_order.begin(), heap_order.end(),
+                               [](const auto& lhs, const auto& rhs) { return lhs.first < rhs.first; }));
+    EXPECT_EQ(run_hold_model(EventSchedulerType::Calendar), heap_order);
+    EXPECT_EQ(run_hold_model(EventSchedulerType::Linear), heap_order);
+}
+
+TEST_F(TestNetworkAnalyticalCongestionAware, AllToAllOnMesh2DParallel) {
+    /// All-to-All of mixed chunk sizes, where each arriving chunk sends a reply from its callback
+    struct Transfer {
+        std::shared_ptr<Topology> topology;
+        EventQueue* event_queue;
+        DeviceId src;
+        DeviceId dest;
+        ChunkSize reply_size;
+        EventTime arrival_time;
+        EventTime reply_arrival_time;
+
+        static void record_arrival(void* const arg) {
+            auto* const transfer = static_cast<Transfer*>(arg);
+            transfer->arrival_time = transfer->event_queue->get_current_time();
+            auto route = transfer->topology->route(transfer->dest, transfer->src);
+            transfer->topology->send(
+                std::make_unique<Chunk>(transfer->reply_size, std::move(route), record_reply, transfer));
+        }
+
+        static void record_reply(void* const arg) {
+            auto* const transfer = static_cast<Transfer*>(arg);
+            transfer->reply_arrival_time = transfer->event_queue->get_current_time();
+        }
+    };
+
+    const auto run_all_to_all = [&](const int threads_count) {
+        /// setup
+        event_queue = std::make_shared<EventQueue>();
+        Topology::set_event_queue(event_queue);
+        const auto network_parser = NetworkParser("../../input/Mesh2D.yml");
+        const auto topology = construct_topology(network_parser);
+        const auto npus_count = topology->get_npus_count();
+        auto simulator = std::unique_ptr<ParallelSimulator>();
+        if (threads_count > 0) {
+            simulator = std::make_unique<ParallelSimulator>(topology, event_queue, threads_count);
+            EXPECT_EQ(simulator->get_regions_count(), threads_count);
+            EXPECT_EQ(simulator->get_lookahead(), 500);
+        }
+
+        /// Run All-to-All
+        auto transfers = std::vector<Transfer>(npus_count * npus_count);
+        for (int i = 0; i < npus_count; i++) {
+            for (int j = 0; j < npus_count; j++) {
+                if (i == j) {
+                    continue;
+                }
+
+                // sizes are multiples of 1 KB, so that many chunks arrive simultaneously
+                const auto size = ChunkSize{1'024} * (1 + ((3 * i + 5 * j) % 4));
+                auto* const transfer = &transfers[i * npus_count + j];
+                *transfer = {topology, event_queue.get(), i, j, ChunkSize{1'024} * (1 + ((i + j) % 3)), 0, 0};
+                auto route = topology->route(i, j);
+                topology->send(std::make_unique<Chunk>(size, std::move(route), Transfer::record_arrival, transfer));
+            }
+        }
+
+        /// Run simulation
+        if (simulator != nullptr) {
+            simulator->run();
+        } else {
+            while (!event_queue->finished()) {
+                event_queue->proceed();
+            }
+        }
+
+        auto arrival_times = std::vector<EventTime>();
+        for (const auto& transfer : transfers) {
+            arrival_times.push_back(transfer.arrival_time);
+            arrival_times.push_back(transfer.reply_arrival_time);
+        }
+        EXPECT_EQ(event_queue->get_current_time(), *std::max_element(arrival_times.begin(), arrival_times.end()));
+        return arrival_times;
+    };
+
+    /// test: every chunk arrives at the time of the sequential simulation regardless of the threads count
+    const auto sequential_arrivals = run_all_to_all(0);
+    for (const auto threads_count : {1, 2, 4, 16}) {
+        EXPECT_EQ(run_all_to_all(threads_count), sequential_arrivals) << threads_count << " threads";
+    }
+}
+
+TEST_F(TestNetworkAnalyticalCongestionAware, BroadcastOnMesh2D) {
+    /// arrival time of each chunk
+    struct Arrival {
+        EventQueue* event_queue;
+        EventTime time;
+    };
+    const auto record_arrival = [](void* const arg) {
+        auto* const arrival = static_cast<Arrival*>(arg);
+        arrival->time = arrival->event_queue->get_current_time();
+    };
+
+    /// setup
+    const auto network_parser = NetworkParser("../../input/Mesh2D.yml");
+    const auto topology = construct_topology(network_parser);
+    const auto npus_count = topology->get_npus_count();
+
+    /// broadcast from NPU 0
+    auto dests = std::vector<DeviceId>();
+    for (int i = 1; i < npus_count; i++) {
+        dests.push_back(i);
+    }
+    const auto multicast_route = topology->multicast_route(0, dests);
+    EXPECT_EQ(multicast_route->get_dests_count(), npus_count - 1);
+    EXPECT_EQ(multicast_route->get_hops_count(), npus_count - 1);  // spanning tree
+
+    /// Run broadcast
+    auto arrivals = std::vector<Arrival>(dests.size(), Arrival{event_queue.get(), 0});
+    auto callback_args = std::vector<CallbackArg>();
+    for (auto& arrival : arrivals) {
+        callback_args.push_back(&arrival);
+    }
+    auto chunk = std::make_unique<Chunk>(chunk_size, multicast_route, record_arrival, callback_args);
+    topology->send(std::move(chunk));
+
+    /// Run simulation
+    while (!event_queue->finished()) {
+        event_queue->proceed();
+    }
+
+    /// test: each destination receives the chunk as fast as an uncontended unicast
+    for (auto i = 0; i < static_cast<int>(dests.size()); i++) {
+        event_queue = std::make_shared<EventQueue>();
+        Topology::set_event_queue(event_queue);
+        const auto unicast_topology = construct_topology(network_parser);
+
+        auto unicast_arrival = Arrival{event_queue.get(), 0};
+        auto route = unicast_topology->route(0, dests[i]);
+        auto unicast_chunk = std::make_unique<Chunk>(chunk_size, route, record_arrival, &unicast_arrival);
+        unicast_topology->send(std::move(unicast_chunk));
+        while (!event_queue->finished()) {
+            event_queue->proceed();
+        }
+
+        EXPECT_GT(arrivals[i].time, 0);
+        EXPECT_EQ(arrivals[i].time, unicast_arrival.time);
+    }
+}
+
+TEST_F(TestNetworkAnalyticalCongestionAware, LinkTelemetryOnMesh2D) {
+    /// setup
+    const auto network_parser = NetworkParser("../../input/Mesh2D.yml");
+    const auto topology = construct_topology(network_parser);
+
+    /// two chunks contend for the link 0 -> 1, one chunk takes the link 0 -> 4
+    for (const auto dest : {1, 1, 4}) {
+        auto route = topology->route(0, dest);
+        auto chunk = std::make_unique<Chunk>(chunk_size, route, callback, nullptr);
+        topology->send(std::move(chunk));
+    }
+
+    /// Run simulation
+    while (!event_queue->finished()) {
+        event_queue->proceed();
+    }
+
+    /// test
+    const auto end_time = event_queue->get_current_time();
+    const auto telemetry = LinkTelemetry(*topology, end_time);
+    const auto& records = telemetry.get_records();
+    EXPECT_EQ(records.size(), 48);  // 24 bidirectional links
+
+    const auto find_record = [&records](const DeviceId src, const DeviceId dest) {
+        return *std::find_if(records.begin(), records.end(),
+                             [=](const auto& record) { return record.src == src && record.dest == dest; });
+    };
+    const auto east = find_record(0, 1);
+    const auto south = find_record(0, 4);
+    const auto west = find_record(1, 0);
+
+    EXPECT_EQ(east.coordinate.row, 0);
+    EXPECT_EQ(east.coordinate.col, 0);
+    EXPECT_EQ(east.coordinate.direction, 'E');
+    EXPECT_EQ(south.coordinate.direction, 'S');
+    EXPECT_EQ(west.coordinate.direction, 'W');
+
+    EXPECT_EQ(east.stats.bytes, 2 * chunk_size);
+    EXPECT_EQ(east.stats.chunks_count, 2);
+    EXPECT_EQ(east.stats.max_pending_chunks, 1);
+    EXPECT_EQ(south.stats.bytes, chunk_size);
+    EXPECT_EQ(south.stats.max_pending_chunks, 0);
+    EXPECT_EQ(west.stats.bytes, 0);
+
+    // the second chunk waits for the serialization of the first one
+    const auto serialization_time = south.stats.busy_time;
+    EXPECT_EQ(east.stats.busy_time, 2 * serialization_time);
+    EXPECT_DOUBLE_EQ(east.stats.pending_chunks_time, static_cast<double>(serialization_time));
+    EXPECT_EQ(end_time, 2 * serialization_time + 500);
+
+    /// CSV dump has a header and a row per link
+    const auto path = std::string("link_telemetry_test.csv");
+    telemetry.dump(path);
+    auto file = std::ifstream(path);
+    auto lines_count = 0;
+    for (auto line = std::string(); std::getline(file, line);) {
+        lines_count++;
+    }
+    EXPECT_EQ(lines_count, 49);
+    std::remove(path.c_str());
+}
+
+TEST_F(TestNetworkAnalyticalCongestionAware, SlabAllocatorRecyclesBlocks) {
+    /// a freed block is reused by the next allocation of its size class
+    auto* const block = SlabAllocator::allocate(240);
+    SlabAllocator::deallocate(block, 240);
+    EXPECT_EQ(SlabAllocator::allocate(240), block);
+    SlabAllocator::deallocate(block, 240);
+
+    /// blocks allocated by a thread and freed by another one
+    constexpr auto blocks_count = 4096;
+    auto blocks = std::vector<void*>(blocks_count);
+    std::thread([&blocks] {
+        for (auto& allocated_block : blocks) {
+            allocated_block = SlabAllocator::allocate(224);
+        }
+    }).join();
+    for (auto* const freed_block : blocks) {
+        SlabAllocator::deallocate(freed_block, 224);
+    }
+
+    /// test: a third thread reuses them (except the few kept by the freeing thread)
+    const auto freed_blocks = std::set<void*>(blocks.begin(), blocks.end());
+    EXPECT_EQ(freed_blocks.size(), blocks_count);
+    auto reused_count = 0;
+    std::thread([&] {
+        for (auto i = 0; i < blocks_count; i++) {
+            reused_count += static_cast<int>(freed_blocks.count(SlabAllocator::allocate(224)));
+        }
+    }).join();
+    EXPECT_GE(reused_count, blocks_count - 512);
+}
+
+TEST_F(TestNetworkAnalyticalCongestionAware, ConcurrentSimulations) {
+    /// every thread simulates its own All-Gather, with its own event queue
+    constexpr auto threads_count = 4;
+    auto simulation_times = std::vector<EventTime>(threads_count);
+    auto threads = std::vector<std::thread>();
+    for (auto i = 0; i < threads_count; i++) {
+        threads.emplace_back([this, &simulation_time = simulation_times[i]] {
+            /// setup
+            const auto thread_event_queue = std::make_shared<EventQueue>();
+            Topology::set_event_queue(thread_event_queue);
+            const auto network_parser = NetworkParser("../../input/Ring.yml");
+            const auto topology = construct_topology(network_parser);
+            const auto npus_count = topology->get_npus_count();
+
+            /// Run All-Gather
+            for (int src = 0; src < npus_count; src++) {
+                for (int dest = 0; dest < npus_count; dest++) {
+                    if (src != dest) {
+                        auto route = topology->route(src, dest);
+                        auto chunk = std::make_unique<Chunk>(chunk_size, route, callback, nullptr);
+                        topology->send(std::move(chunk));
+                    }
+                }
+            }
+
+            /// Run simulation
+            while (!thread_event_queue->finished()) {
+                thread_event_queue->proceed();
+            }
+            simulation_time = thread_event_queue->get_current_time();
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    /// test: each simulation matches the sequential one, and the event queue of this thread is untouched
+    for (const auto simulation_time : simulation_times) {
+        EXPECT_EQ(simulation_time, 704'116);
+    }
+    EXPECT_TRUE(event_queue->finished());
+    EXPECT_EQ(event_queue->get_current_time(), 0);
+}
@@ -0,0 +1,169 @@
+/******************************************************************************
+This source code is licensed under the MIT license found in the
+LICENSE file in the root directory of this source tree.
+*******************************************************************************/
+
+#include "common/EventQueue.h"
+#include "common/NetworkParser.h"
+#include "common/Type.h"
+#include "congestion_aware/Helper.h"
+#include "flow/FlowNetwork.h"
+#include <gtest/gtest.h>
+#include <vector>
+
+using namespace NetworkAnalytical;
+using namespace NetworkAnalyticalCongestionAware;
+using namespace NetworkAnalyticalFlow;
+
+class TestNetworkAnalyticalFlow : public ::testing::Test {
+  protected:
+    void SetUp() override {
+        // set event queue
+        event_queue = std::make_shared<EventQueue>();
+        Topology::set_event_queue(event_queue);
+
+        // set message size
+        message_size = 1'048'576;  // 1 MB
+    }
+
+    /// arrival record of a flow
+    struct Arrival {
+        EventQueue* event_queue;
+        EventTime time;
+    };
+
+    static void callback(void* const arg) {
+        auto* const arrival = static_cast<Arrival*>(arg);
+        arrival->time = arrival->event_queue->get_current_time();
+    }
+
+    void run() {
+        while (!event_queue->finished()) {
+            event_queue->proceed();
+        }
+    }
+
+    std::shared_ptr<EventQueue> event_queue;
+
+    ChunkSize message_size;
+};
+
+TEST_F(TestNetworkAnalyticalFlow, SingleFlowPipelinesHops) {
+    /// setup
+    const auto network_parser = NetworkParser("../../input/Ring.yml");
+    const auto topology = construct_topology(network_parser);
+    auto flow_network = FlowNetwork(topology, event_queue);
+
+    auto one_hop = Arrival{event_queue.get(), 0};
+    auto two_hops = Arrival{event_queue.get(), 0};
+    flow_network.send(0, 1, message_size, callback, &one_hop);
+    run();
+    flow_network.send(0, 2, message_size, callback, &two_hops);
+    run();
+
+    /// test: serialization is paid once, latency per hop
+    EXPECT_EQ(one_hop.time, 19'532 + 500);
+    EXPECT_EQ(two_hops.time - one_hop.time, 19'532 + 1'000);
+}
+
+TEST_F(TestNetworkAnalyticalFlow, FlowsShareLink) {
+    /// setup
+    const auto network_parser = NetworkParser("../../input/Ring.yml");
+    const auto topology = construct_topology(network_parser);
+    auto flow_network = FlowNetwork(topology, event_queue);
+
+    auto arrivals = std::vector<Arrival>(2, Arrival{event_queue.get(), 0});
+    for (auto& arrival : arrivals) {
+        flow_network.send(0, 1, message_size, callback, &arrival);
+    }
+    run();
+
+    /// test: both flows get half of the bandwidth
+    EXPECT_EQ(arrivals[0].time, 39'063 + 500);
+    EXPECT_EQ(arrivals[1].time, 39'063 + 500);
+    EXPECT_EQ(flow_network.get_rate_updates_count(), 1);
+}
+
+TEST_F(TestNetworkAnalyticalFlow, FlowJoinsMidTransfer) {
+    /// setup
+    const auto network_parser = NetworkParser("../../input/Ring.yml");
+    const auto topology = construct_topology(network_parser);
+    auto flow_network = FlowNetwork(topology, event_queue);
+
+    /// the second flow joins the link while the first one is halfway through
+    struct Join {
+        FlowNetwork* flow_network;
+        ChunkSize size;
+        Arrival arrival;
+    };
+    auto first_flow = Arrival{event_queue.get(), 0};
+    auto join = Join{&flow_network, message_size, Arrival{event_queue.get(), 0}};
+    flow_network.send(0, 1, message_size, callback, &first_flow);
+    event_queue->schedule_event(
+        10'000,
+        [](void* const arg) {
+            auto* const join = static_cast<Join*>(arg);
+            join->flow_network->send(0, 1, join->size, callback, &join->arrival);
+        },
+        &join);
+    run();
+
+    /// test: the first flow is slowed down by the second one, which then takes the whole link
+    EXPECT_EQ(first_flow.time, 29'063 + 500);
+    EXPECT_EQ(join.arrival.time, 39'063 + 500);
+    EXPECT_EQ(flow_network.get_active_flows_count(), 0);
+}
+
+TEST_F(TestNetworkAnalyticalFlow, MaxMinFairRates) {
+    /// setup
+    const auto network_parser = NetworkParser("../../input/Mesh2D.yml");
+    const auto topology = construct_topology(network_parser);
+    auto flow_network = FlowNetwork(topology, event_queue);
+
+    /// link 0 -> 1 carries three flows, link 1 -> 2 carries 0 -> 2 and 1 -> 2
+    auto long_flow = Arrival{event_queue.get(), 0};
+    auto short_flows = std::vector<Arrival>(2, Arrival{event_queue.get(), 0});
+    auto unconstrained_flow = Arrival{event_queue.get(), 0};
+    flow_network.send(0, 2, message_size, callback, &long_flow);
+    flow_network.send(0, 1, message_size, callback, &short_flows[0]);
+    flow_network.send(0, 1, message_size, callback, &short_flows[1]);
+    flow_network.send(1, 2, message_size, callback, &unconstrained_flow);
+    EXPECT_EQ(flow_network.get_active_flows_count(), 0);  // admitted at the next update
+    run();
+
+    /// test: 0 -> 2 is bottlenecked at 1/3 of link 0 -> 1, so 1 -> 2 takes the remaining 2/3
+    EXPECT_EQ(unconstrained_flow.time, 24'415 + 500);
+    EXPECT_EQ(short_flows[0].time, 48'829 + 500);
+    EXPECT_EQ(short_flows[1].time, 48'829 + 500);
+    EXPECT_EQ(long_flow.time, 48'829 + 1'000);
+    EXPECT_EQ(flow_network.get_active_flows_count(), 0);
+    EXPECT_EQ(flow_network.get_rate_updates_count(), 2);
+}
+
+TEST_F(TestNetworkAnalyticalFlow, AllGatherOnRing) {
+    /// setup
+    const auto network_parser = NetworkParser("../../input/Ring.yml");
+    const auto topology = construct_topology(network_parser);
+    const auto npus_count = topology->get_npus_count();
+    auto flow_network = FlowNetwork(topology, event_queue);
+
+    /// Run All-Gather
+    auto arrivals = std::vector<Arrival>(npus_count * npus_count, Arrival{event_queue.get(), 0});
+    for (auto i = 0; i < npus_count; i++) {
+        for (auto j = 0; j < npus_count; j++) {
+            if (i != j) {
+                flow_network.send(i, j, message_size, callback, &arrivals[(i * npus_count) + j]);
+            }
+        }
+    }
+    run();
+
+    /// test: every flow arrived, with a rate update per distinct finish time only
+    for (auto i = 0; i < npus_count; i++) {
+        for (auto j = 0; j < npus_count; j++) {
+            EXPECT_EQ(arrivals[(i * npus_count) + j].time > 0, i != j);
+        }
+    }
+    EXPECT_EQ(flow_network.get_active_flows_count(), 0);
+    EXPECT_LT(flow_network.get_rate_updates_count(), npus_count * (npus_count - 1));
+}
@@ -33,6 +33,11 @@ printf "\tFormatting include:\n"
 find "$TARGET_DIR/include" \( -name "*.cpp" -o -name "*.h" \) -exec \
     clang-format -style=file -i {} \;
 
+# run clang-format for `benchmark`
+printf "\tFormatting benchmark:\n"
+find "$TARGET_DIR/benchmark" \( -name "*.cpp" -o -name "*.h" \) -exec \
+    clang-format -style=file -i {} \;
+
 # run clang-format for `test`
 printf "\tFormatting test:\n"
 find "$TARGET_DIR/test" \( -name "*.cpp" -o -name "*.h" \) -exec \
@@ -0,0 +1,48 @@
+import os
+
+from chakra.src.third_party.utils.protolib import encodeMessage as encode_message
+from chakra.schema.protobuf.et_def_pb2 import (
+    Node as ChakraNode,
+    GlobalMetadata,
+    AttributeProto as ChakraAttr,
+    COMM_SEND_NODE,
+    COMM_RECV_NODE,
+)
+
+def comm_node(node_id: int, node_type: int, src: int, dst: int, msg_size: int) -> ChakraNode:
+    # create Chakra Node
+    node = ChakraNode()
+    node.id = node_id
+    node.name = "Send" if node_type == COMM_SEND_NODE else "Recv"
+    node.type = node_type
+
+    # assign attributes
+    node.attr.append(ChakraAttr(name="is_cpu_op", bool_val=False))
+    node.attr.append(ChakraAttr(name="comm_src", int64_val=src))
+    node.attr.append(ChakraAttr(name="comm_dst", int64_val=dst))
+    node.attr.append(ChakraAttr(name="comm_size", int64_val=msg_size))
+    node.attr.append(ChakraAttr(name="comm_tag", int64_val=0))
+    return node
+
+def main() -> None:
+    # metadata
+    npus_count = 8  # 8 NPUs
+    msg_size = 65_536  # 64 KB
+
+    for npu_id in range(npus_count):
+        next_npu_id = (npu_id + 1) % npus_count
+        prev_npu_id = (npu_id + npus_count - 1) % npus_count
+
+        # every NPU sends to its successor and receives from its predecessor
+        with open(f"ring_trace.{npu_id}.et", "wb") as et:
+            encode_message(et, GlobalMetadata(version="0.0.4"))
+            encode_message(et, comm_node(1, COMM_SEND_NODE, npu_id, next_npu_id, msg_size))
+            encode_message(et, comm_node(2, COMM_RECV_NODE, prev_npu_id, npu_id, msg_size))
+
+        # same receives, but no NPU sends: the simulation does not finish
+        with open(f"unmatched_trace.{npu_id}.et", "wb") as et:
+            encode_message(et, GlobalMetadata(version="0.0.4"))
+            encode_message(et, comm_node(1, COMM_RECV_NODE, prev_npu_id, npu_id, msg_size))
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,41 @@
+#!/bin/bash
+set -e
+
+# Path
+SCRIPT_DIR=$(dirname "$(realpath $0)")
+ASTRA_SIM_BIN=${SCRIPT_DIR}/../../build/astra_analytical/build/bin/AstraSim_Analytical_Congestion_Aware
+
+# Clear outputs
+(
+rm -rf ${SCRIPT_DIR}/outputs/*
+)
+
+# Generate inputs
+(
+echo "[$0] Generating inputs..."
+${SCRIPT_DIR}/inputs/workload/gen.sh
+)
+
+# Run ASTRA-sim
+# (one thread: every run of the sweep reuses the thread of the previous one)
+(
+echo "[$0] Running ASTRA-sim..."
+cd ${SCRIPT_DIR}
+${ASTRA_SIM_BIN} \
+    --sweep=inputs/sweep.json \
+    --sweep-threads=1 \
+    --sweep-output=outputs/sweep.csv
+)
+
+drop_host_time() {
+    cut -d, -f1-7,9-
+}
+
+# Compare outputs
+(
+echo "[$0] Comparing outputs..."
+drop_host_time < ${SCRIPT_DIR}/outputs/sweep.csv > ${SCRIPT_DIR}/outputs/sweep_clean.csv
+diff ${SCRIPT_DIR}/outputs/sweep_clean.csv ${SCRIPT_DIR}/refs/sweep.csv || (echo "Failed." ; exit 1)
+)
+
+echo "[$0] Ok."
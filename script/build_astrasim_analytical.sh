@@ -26,5 +26,11 @@ fi
 echo "[build] Running ASTRA-sim analytical build script..."
 ./build/astra_analytical/build.sh
 
+ORACLE_DIR="${PROJECT_ROOT}/src/spgemm_oracle"
+echo "[build] Building native SpGEMM oracle: ${ORACLE_DIR}"
+cmake -S "${ORACLE_DIR}" -B "${ORACLE_DIR}/build"
+cmake --build "${ORACLE_DIR}/build" -j "$(nproc)"
+
 echo "[build] Done."
 echo "[build] Binary should be at: build/astra_analytical/build/bin/AstraSim_Analytical_Congestion_Aware"
+echo "[build] Oracle should be at: ${ORACLE_DIR}/build/bin/SpGEMM_Oracle"
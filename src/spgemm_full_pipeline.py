@@ -4,6 +4,8 @@
 from __future__ import annotations
 
 import argparse
+import csv
+import json
 import os
 import re
 import subprocess
@@ -45,7 +47,7 @@ def run_cmd(
 
 # ================== 1. SuiteSparse Matrix Loading ==================
 
-def load_ss_matrix(selector: str, dest_dir: str) -> tuple[csr_matrix, ssgetpy.Matrix]:
+def load_ss_matrix(selector: str, dest_dir: str) -> tuple[csr_matrix, ssgetpy.Matrix, str]:
     """
     selector:
       - digits only: explicit ssgetpy id
@@ -73,7 +75,7 @@ def load_ss_matrix(selector: str, dest_dir: str) -> tuple[csr_matrix, ssgetpy.Ma
     mtx_path = os.path.join(tgz_path, rec.name + ".mtx")
     print(f"[ssgetpy] Matrix Market file: {mtx_path}")
     A = mmread(mtx_path).tocsr()
-    return A, rec
+    return A, rec, mtx_path
 
 
 # ================== 2. 2D Mesh Helpers ==================
@@ -661,6 +663,110 @@ def run_astrasim_and_get_comm_time(
     return max_ct
 
 
+def run_astrasim_sweep_and_get_comm_times(
+    workload_prefixes: Dict[str, str],
+    system_config: str,
+    network_config: str,
+    remote_mem_config: str,
+    astrasim_bin: str,
+    workdir: str | Path,
+    threads: int,
+) -> Dict[str, int]:
+    """
+    Simulate every workload (name -> ET prefix) concurrently in a single
+    AstraSim process (--sweep), and return the max communication time of each.
+    """
+    workdir = Path(workdir)
+    manifest_path = workdir / "astrasim_sweep.json"
+    results_path = workdir / "astrasim_sweep.csv"
+
+    manifest = {
+        "defaults": {
+            "system-configuration": system_config,
+            "network-configuration": network_config,
+            "remote-memory-configuration": remote_mem_config,
+        },
+        "runs": [
+            {"name": name, "workload-configuration": prefix}
+            for name, prefix in workload_prefixes.items()
+        ],
+    }
+    with open(manifest_path, "w") as f:
+        json.dump(manifest, f, indent=2)
+
+    print(f"[info] Running AstraSim sweep of {len(workload_prefixes)} workloads")
+    cmd = [
+        astrasim_bin,
+        f"--sweep={manifest_path}",
+        f"--sweep-output={results_path}",
+        f"--sweep-threads={threads}",
+    ]
+    run_cmd(cmd)
+
+    comm_times = {}
+    with open(results_path, newline="") as f:
+        for row in csv.DictReader(f):
+            if row["finished"] != "1":
+                print(f"[warn] AstraSim run {row['name']} did not finish.")
+                comm_times[row["name"]] = -1
+                continue
+            comm_times[row["name"]] = int(row["max_comm_time"])
+            print(
+                f"[info]   {row['name']}: AstraSim Comm time "
+                f"(max over sys[]) = {comm_times[row['name']]}"
+            )
+    return comm_times
+
+
+def run_native_oracle(
+    oracle_bin: str,
+    mtx_path: str,
+    workdir: str,
+    mappings: List[str],
+    num_parts: int,
+    elem_bytes: int,
+    micro_mode: str,
+    micro_max_layers: int,
+    micro_rows_per_layer: int,
+    num_passes: int,
+    threads: int,
+) -> Dict[str, Dict[str, float]]:
+    """
+    Run the native SpGEMM oracle (src/spgemm_oracle), which replaces
+    simulate_bcast_on_mesh + collect_bcast_row_bytes + write_micro_text +
+    chakra_converter: it writes workdir/SpGEMM_<tag>.txt and the Chakra ET
+    workdir/SpGEMM_<tag>.<npu>.et for every mapping TAG:PARTITION:OWNER.
+    Returns the oracle statistics of each mapping tag.
+    """
+    print(f"[info] Running native SpGEMM oracle: {oracle_bin}")
+    cmd = [
+        oracle_bin,
+        "--matrix", mtx_path,
+        "--num-parts", str(num_parts),
+        "--elem-bytes", str(elem_bytes),
+        "--micro-mode", micro_mode,
+        "--micro-max-layers", str(micro_max_layers),
+        "--micro-rows-per-layer", str(micro_rows_per_layer),
+        "--num-passes", str(num_passes),
+        "--workdir", workdir,
+        "--threads", str(threads),
+    ]
+    for mapping in mappings:
+        cmd += ["--mapping", mapping]
+    proc = run_cmd(cmd, capture=True)
+    print(proc.stdout, end="")
+
+    # [oracle] tag=<tag> key=value ...
+    results: Dict[str, Dict[str, float]] = {}
+    for line in proc.stdout.splitlines():
+        if not line.startswith("[oracle] "):
+            continue
+        fields = dict(kv.split("=", 1) for kv in line.split()[1:])
+        tag = fields.pop("tag")
+        results[tag] = {k: (float(v) if "." in v else int(v)) for k, v in fields.items()}
+    return results
+
+
 # ================== 9. Main pipeline ==================
 
 def main():
@@ -753,6 +859,15 @@ def main():
         required=True,
         help="AstraSim remote memory config JSON.",
     )
+    parser.add_argument(
+        "--astrasim-sweep-threads",
+        type=int,
+        default=None,
+        help=(
+            "If set, simulate WaferSpMM and HyperWafer concurrently in a single "
+            "AstraSim process (--sweep) with this many threads (0: all hardware threads)."
+        ),
+    )
 
     # Misc
     parser.add_argument(
@@ -801,13 +916,30 @@ def main():
         help="Rows per MICRO layer if micro-mode=rows_manual.",
     )
 
+    # Native oracle
+    parser.add_argument(
+        "--oracle-bin",
+        default=None,
+        help=(
+            "Optional path to the native SpGEMM_Oracle binary. "
+            "If provided, it replaces the Python 2D mesh oracle, MICRO construction "
+            "and chakra_converter (same outputs, multithreaded)."
+        ),
+    )
+    parser.add_argument(
+        "--oracle-threads",
+        type=int,
+        default=0,
+        help="Threads of the native oracle (0: all hardware threads).",
+    )
+
     args = parser.parse_args()
 
     workdir = Path(args.workdir).absolute()
     ensure_dir(workdir)
 
     # 1. SuiteSparse matrix
-    A, rec = load_ss_matrix(args.matrix_selector, args.ss_dest_dir)
+    A, rec, mtx_path = load_ss_matrix(args.matrix_selector, args.ss_dest_dir)
     print(
         f"[info] Loaded A: {rec.group}/{rec.name}, shape={A.shape}, nnz={A.nnz}"
     )
@@ -849,83 +981,54 @@ def main():
         threads=args.mtk_threads,
         preset_type=args.mtk_preset,
     )
-    row_part_hyper = load_partition(part_path, n_vertices=n_rows_a)
-
-    # Build B-row owners based on hypergraph partitions (use the tile with the highest task count)
-    owner_B_hyper = build_owner_B_hypergraph_center(
-        A=A,
-        row_part=row_part_hyper,
-        num_parts=args.num_parts,
-    )
-
-    # 4. 2D mesh oracle: WaferSpMM vs HyperWafer
-    print("\n[phase] 2D mesh oracle: WaferSpMM baseline")
-    (
-        wafer_total,
-        wafer_gbhop,
-        wafer_peak,
-        _,
-        wafer_avg_tiles_all,
-        wafer_avg_recv_all,
-        wafer_avg_tiles_comm,
-        wafer_avg_recv_comm,
-    ) = simulate_bcast_on_mesh(
-        A=A,
-        B=B,
-        row_part=row_part_wafer,
-        num_parts=args.num_parts,
-        elem_bytes=args.elem_bytes,
-        owner_B=owner_B_wafer,
-    )
-
-    print("\n[phase] 2D mesh oracle: HyperWafer mapping")
-    (
-        hyper_total,
-        hyper_gbhop,
-        hyper_peak,
-        _,
-        hyper_avg_tiles_all,
-        hyper_avg_recv_all,
-        hyper_avg_tiles_comm,
-        hyper_avg_recv_comm,
-    ) = simulate_bcast_on_mesh(
-        A=A,
-        B=B,
-        row_part=row_part_hyper,
-        num_parts=args.num_parts,
-        elem_bytes=args.elem_bytes,
-        owner_B=owner_B_hyper,
-    )
+    if args.oracle_bin is not None:
+        # 4-6. Native oracle: 2D mesh oracle, MICRO and Chakra ET in one pass
+        print("\n[phase] Native 2D mesh oracle + MICRO + Chakra ET")
+        oracle = run_native_oracle(
+            oracle_bin=args.oracle_bin,
+            mtx_path=mtx_path,
+            workdir=str(workdir),
+            mappings=[
+                f"WaferSpMM:rowblock:{args.b_owner_mode}",
+                f"HyperWafer:{part_path}:center",
+            ],
+            num_parts=args.num_parts,
+            elem_bytes=args.elem_bytes,
+            micro_mode=args.micro_mode,
+            micro_max_layers=args.micro_max_layers,
+            micro_rows_per_layer=args.micro_rows_per_layer,
+            num_passes=args.num_passes,
+            threads=args.oracle_threads,
+        )
+        wafer, hyper = oracle["WaferSpMM"], oracle["HyperWafer"]
+        wafer_total, wafer_gbhop, wafer_peak = wafer["total_bytes"], wafer["gb_hop"], wafer["peak_link"]
+        wafer_avg_tiles_all, wafer_avg_recv_all = wafer["avg_tiles_all"], wafer["avg_recv_all"]
+        wafer_avg_tiles_comm, wafer_avg_recv_comm = wafer["avg_tiles_comm"], wafer["avg_recv_comm"]
+        hyper_total, hyper_gbhop, hyper_peak = hyper["total_bytes"], hyper["gb_hop"], hyper["peak_link"]
+        hyper_avg_tiles_all, hyper_avg_recv_all = hyper["avg_tiles_all"], hyper["avg_recv_all"]
+        hyper_avg_tiles_comm, hyper_avg_recv_comm = hyper["avg_tiles_comm"], hyper["avg_recv_comm"]
+    else:
+        row_part_hyper = load_partition(part_path, n_vertices=n_rows_a)
 
-    print("\n[oracle-summary]")
-    print(f"  WaferSpMM:  total_bytes={wafer_total}, GB-hop={wafer_gbhop}, peak_link={wafer_peak}")
-    print(f"              avg tiles using B-row (all/comm)   = {wafer_avg_tiles_all:.3f} / {wafer_avg_tiles_comm:.3f}")
-    print(f"              avg remote tiles per B-row (all/comm) = {wafer_avg_recv_all:.3f} / {wafer_avg_recv_comm:.3f}")
-    print(f"  HyperWafer: total_bytes={hyper_total}, GB-hop={hyper_gbhop}, peak_link={hyper_peak}")
-    print(f"              avg tiles using B-row (all/comm)   = {hyper_avg_tiles_all:.3f} / {hyper_avg_tiles_comm:.3f}")
-    print(f"              avg remote tiles per B-row (all/comm) = {hyper_avg_recv_all:.3f} / {hyper_avg_recv_comm:.3f}")
-    if hyper_total > 0 and hyper_gbhop > 0 and hyper_peak > 0:
-        print(f"  volume reduction (WaferSpMM / HyperWafer)  = {wafer_total / hyper_total:.3f}x")
-        print(f"  GB-hop reduction (WaferSpMM / HyperWafer)  = {wafer_gbhop / hyper_gbhop:.3f}x")
-        print(f"  peak-link reduction                        = {wafer_peak / hyper_peak:.3f}x")
+        # Build B-row owners based on hypergraph partitions (use the tile with the highest task count)
+        owner_B_hyper = build_owner_B_hypergraph_center(
+            A=A,
+            row_part=row_part_hyper,
+            num_parts=args.num_parts,
+        )
 
-    # 5. MICRO phases: single / auto_rows / rows_manual
-    if args.micro_mode == "single":
-        print("\n[phase] Build SINGLE MICRO phases (one big ALLGATHER per mapping)")
-        phases_wafer = [{
-            "name": "SpGEMM_BcastB_WaferSpMM_total",
-            "comm_type": "ALLGATHER",
-            "bytes": wafer_total,
-        }]
-        phases_hyper = [{
-            "name": "SpGEMM_BcastB_HyperWafer_total",
-            "comm_type": "ALLGATHER",
-            "bytes": hyper_total,
-        }]
-        rows_per_layer_effective = None
-    else:
-        print("\n[phase] Collect per-B-row bytes for WaferSpMM")
-        row_bytes_wafer = collect_bcast_row_bytes(
+        # 4. 2D mesh oracle: WaferSpMM vs HyperWafer
+        print("\n[phase] 2D mesh oracle: WaferSpMM baseline")
+        (
+            wafer_total,
+            wafer_gbhop,
+            wafer_peak,
+            _,
+            wafer_avg_tiles_all,
+            wafer_avg_recv_all,
+            wafer_avg_tiles_comm,
+            wafer_avg_recv_comm,
+        ) = simulate_bcast_on_mesh(
             A=A,
             B=B,
             row_part=row_part_wafer,
@@ -933,10 +1036,18 @@ def main():
             elem_bytes=args.elem_bytes,
             owner_B=owner_B_wafer,
         )
-        print(f"[info] WaferSpMM: #active B-rows with cross-tile comm = {len(row_bytes_wafer)}")
 
-        print("\n[phase] Collect per-B-row bytes for HyperWafer")
-        row_bytes_hyper = collect_bcast_row_bytes(
+        print("\n[phase] 2D mesh oracle: HyperWafer mapping")
+        (
+            hyper_total,
+            hyper_gbhop,
+            hyper_peak,
+            _,
+            hyper_avg_tiles_all,
+            hyper_avg_recv_all,
+            hyper_avg_tiles_comm,
+            hyper_avg_recv_comm,
+        ) = simulate_bcast_on_mesh(
             A=A,
             B=B,
             row_part=row_part_hyper,
@@ -944,88 +1055,160 @@ def main():
             elem_bytes=args.elem_bytes,
             owner_B=owner_B_hyper,
         )
-        print(f"[info] HyperWafer: #active B-rows with cross-tile comm = {len(row_bytes_hyper)}")
-
-        if args.micro_mode == "auto_rows":
-            Mw = len(row_bytes_wafer)
-            if Mw > 0:
-                rows_per_layer = max(1, int(np.ceil(Mw / args.micro_max_layers)))
-            else:
-                rows_per_layer = 1
-            print(
-                f"[info] auto_rows MICRO: "
-                f"Mw={Mw}, target_max_layers={args.micro_max_layers}, "
-                f"rows_per_layer={rows_per_layer}"
-            )
-        else:  # rows_manual
-            rows_per_layer = max(1, args.micro_rows_per_layer)
-            print(
-                f"[info] rows_manual MICRO: rows_per_layer={rows_per_layer}"
-            )
-
-        rows_per_layer_effective = rows_per_layer
-
-        print("\n[phase] Build rows-batch MICRO phases for WaferSpMM")
-        phases_wafer = build_bcast_micro_phases_rows_batch(
-            row_bytes=row_bytes_wafer,
-            tag="WaferSpMM",
-            rows_per_layer=rows_per_layer,
-        )
-        print("\n[phase] Build rows-batch MICRO phases for HyperWafer")
-        phases_hyper = build_bcast_micro_phases_rows_batch(
-            row_bytes=row_bytes_hyper,
-            tag="HyperWafer",
-            rows_per_layer=rows_per_layer,
-        )
-
-    total_wafer_micro = sum(ph["bytes"] for ph in phases_wafer)
-    total_hyper_micro = sum(ph["bytes"] for ph in phases_hyper)
-    print(f"[check] total Bcast bytes from MICRO phases (WaferSpMM)  = {total_wafer_micro}")
-    print(f"[check] total Bcast bytes from MICRO phases (HyperWafer) = {total_hyper_micro}")
 
-    micro_wafer = str(workdir / "SpGEMM_WaferSpMM.txt")
-    micro_hyper = str(workdir / "SpGEMM_HyperWafer.txt")
-
-    write_micro_text(micro_wafer, phases_wafer)
-    write_micro_text(micro_hyper, phases_hyper)
+    print("\n[oracle-summary]")
+    print(f"  WaferSpMM:  total_bytes={wafer_total}, GB-hop={wafer_gbhop}, peak_link={wafer_peak}")
+    print(f"              avg tiles using B-row (all/comm)   = {wafer_avg_tiles_all:.3f} / {wafer_avg_tiles_comm:.3f}")
+    print(f"              avg remote tiles per B-row (all/comm) = {wafer_avg_recv_all:.3f} / {wafer_avg_recv_comm:.3f}")
+    print(f"  HyperWafer: total_bytes={hyper_total}, GB-hop={hyper_gbhop}, peak_link={hyper_peak}")
+    print(f"              avg tiles using B-row (all/comm)   = {hyper_avg_tiles_all:.3f} / {hyper_avg_tiles_comm:.3f}")
+    print(f"              avg remote tiles per B-row (all/comm) = {hyper_avg_recv_all:.3f} / {hyper_avg_recv_comm:.3f}")
+    if hyper_total > 0 and hyper_gbhop > 0 and hyper_peak > 0:
+        print(f"  volume reduction (WaferSpMM / HyperWafer)  = {wafer_total / hyper_total:.3f}x")
+        print(f"  GB-hop reduction (WaferSpMM / HyperWafer)  = {wafer_gbhop / hyper_gbhop:.3f}x")
+        print(f"  peak-link reduction                        = {wafer_peak / hyper_peak:.3f}x")
 
-    # 6. Chakra: MICRO -> ET
     wl_wafer_prefix = str(workdir / "SpGEMM_WaferSpMM")
     wl_hyper_prefix = str(workdir / "SpGEMM_HyperWafer")
 
-    run_chakra_converter(
-        text_path=micro_wafer,
-        out_prefix=wl_wafer_prefix,
-        num_npus=args.num_parts,
-        num_passes=args.num_passes,
-        chakra_bin=args.chakra_bin,
-    )
-    run_chakra_converter(
-        text_path=micro_hyper,
-        out_prefix=wl_hyper_prefix,
-        num_npus=args.num_parts,
-        num_passes=args.num_passes,
-        chakra_bin=args.chakra_bin,
-    )
+    if args.oracle_bin is not None:
+        rows_per_layer_effective = wafer["rows_per_layer"] if args.micro_mode != "single" else None
+        total_wafer_micro, num_layers_wafer = wafer["micro_bytes"], wafer["micro_layers"]
+        total_hyper_micro, num_layers_hyper = hyper["micro_bytes"], hyper["micro_layers"]
+    else:
+        # 5. MICRO phases: single / auto_rows / rows_manual
+        if args.micro_mode == "single":
+            print("\n[phase] Build SINGLE MICRO phases (one big ALLGATHER per mapping)")
+            phases_wafer = [{
+                "name": "SpGEMM_BcastB_WaferSpMM_total",
+                "comm_type": "ALLGATHER",
+                "bytes": wafer_total,
+            }]
+            phases_hyper = [{
+                "name": "SpGEMM_BcastB_HyperWafer_total",
+                "comm_type": "ALLGATHER",
+                "bytes": hyper_total,
+            }]
+            rows_per_layer_effective = None
+        else:
+            print("\n[phase] Collect per-B-row bytes for WaferSpMM")
+            row_bytes_wafer = collect_bcast_row_bytes(
+                A=A,
+                B=B,
+                row_part=row_part_wafer,
+                num_parts=args.num_parts,
+                elem_bytes=args.elem_bytes,
+                owner_B=owner_B_wafer,
+            )
+            print(f"[info] WaferSpMM: #active B-rows with cross-tile comm = {len(row_bytes_wafer)}")
+
+            print("\n[phase] Collect per-B-row bytes for HyperWafer")
+            row_bytes_hyper = collect_bcast_row_bytes(
+                A=A,
+                B=B,
+                row_part=row_part_hyper,
+                num_parts=args.num_parts,
+                elem_bytes=args.elem_bytes,
+                owner_B=owner_B_hyper,
+            )
+            print(f"[info] HyperWafer: #active B-rows with cross-tile comm = {len(row_bytes_hyper)}")
+
+            if args.micro_mode == "auto_rows":
+                Mw = len(row_bytes_wafer)
+                if Mw > 0:
+                    rows_per_layer = max(1, int(np.ceil(Mw / args.micro_max_layers)))
+                else:
+                    rows_per_layer = 1
+                print(
+                    f"[info] auto_rows MICRO: "
+                    f"Mw={Mw}, target_max_layers={args.micro_max_layers}, "
+                    f"rows_per_layer={rows_per_layer}"
+                )
+            else:  # rows_manual
+                rows_per_layer = max(1, args.micro_rows_per_layer)
+                print(
+                    f"[info] rows_manual MICRO: rows_per_layer={rows_per_layer}"
+                )
+
+            rows_per_layer_effective = rows_per_layer
+
+            print("\n[phase] Build rows-batch MICRO phases for WaferSpMM")
+            phases_wafer = build_bcast_micro_phases_rows_batch(
+                row_bytes=row_bytes_wafer,
+                tag="WaferSpMM",
+                rows_per_layer=rows_per_layer,
+            )
+            print("\n[phase] Build rows-batch MICRO phases for HyperWafer")
+            phases_hyper = build_bcast_micro_phases_rows_batch(
+                row_bytes=row_bytes_hyper,
+                tag="HyperWafer",
+                rows_per_layer=rows_per_layer,
+            )
+
+        total_wafer_micro = sum(ph["bytes"] for ph in phases_wafer)
+        total_hyper_micro = sum(ph["bytes"] for ph in phases_hyper)
+        print(f"[check] total Bcast bytes from MICRO phases (WaferSpMM)  = {total_wafer_micro}")
+        print(f"[check] total Bcast bytes from MICRO phases (HyperWafer) = {total_hyper_micro}")
+        num_layers_wafer = len(phases_wafer)
+        num_layers_hyper = len(phases_hyper)
+
+        micro_wafer = str(workdir / "SpGEMM_WaferSpMM.txt")
+        micro_hyper = str(workdir / "SpGEMM_HyperWafer.txt")
+
+        write_micro_text(micro_wafer, phases_wafer)
+        write_micro_text(micro_hyper, phases_hyper)
+
+        # 6. Chakra: MICRO -> ET
+        run_chakra_converter(
+            text_path=micro_wafer,
+            out_prefix=wl_wafer_prefix,
+            num_npus=args.num_parts,
+            num_passes=args.num_passes,
+            chakra_bin=args.chakra_bin,
+        )
+        run_chakra_converter(
+            text_path=micro_hyper,
+            out_prefix=wl_hyper_prefix,
+            num_npus=args.num_parts,
+            num_passes=args.num_passes,
+            chakra_bin=args.chakra_bin,
+        )
 
     # 7. AstraSim: WaferSpMM / HyperWafer communication time
-    print("\n[phase] Run AstraSim for WaferSpMM")
-    comm_wafer = run_astrasim_and_get_comm_time(
-        workload_prefix=wl_wafer_prefix,
-        system_config=args.system_config,
-        network_config=args.network_config,
-        remote_mem_config=args.remote_mem_config,
-        astrasim_bin=args.astrasim_bin,
-    )
+    if args.astrasim_sweep_threads is not None:
+        print("\n[phase] Run AstraSim for WaferSpMM and HyperWafer (sweep)")
+        comm_times = run_astrasim_sweep_and_get_comm_times(
+            workload_prefixes={
+                "WaferSpMM": wl_wafer_prefix,
+                "HyperWafer": wl_hyper_prefix,
+            },
+            system_config=args.system_config,
+            network_config=args.network_config,
+            remote_mem_config=args.remote_mem_config,
+            astrasim_bin=args.astrasim_bin,
+            workdir=workdir,
+            threads=args.astrasim_sweep_threads,
+        )
+        comm_wafer = comm_times["WaferSpMM"]
+        comm_hyper = comm_times["HyperWafer"]
+    else:
+        print("\n[phase] Run AstraSim for WaferSpMM")
+        comm_wafer = run_astrasim_and_get_comm_time(
+            workload_prefix=wl_wafer_prefix,
+            system_config=args.system_config,
+            network_config=args.network_config,
+            remote_mem_config=args.remote_mem_config,
+            astrasim_bin=args.astrasim_bin,
+        )
 
-    print("\n[phase] Run AstraSim for HyperWafer")
-    comm_hyper = run_astrasim_and_get_comm_time(
-        workload_prefix=wl_hyper_prefix,
-        system_config=args.system_config,
-        network_config=args.network_config,
-        remote_mem_config=args.remote_mem_config,
-        astrasim_bin=args.astrasim_bin,
-    )
+        print("\n[phase] Run AstraSim for HyperWafer")
+        comm_hyper = run_astrasim_and_get_comm_time(
+            workload_prefix=wl_hyper_prefix,
+            system_config=args.system_config,
+            network_config=args.network_config,
+            remote_mem_config=args.remote_mem_config,
+            astrasim_bin=args.astrasim_bin,
+        )
 
     # 8. Summary
     print("\n========== SUMMARY (PIPELINE v8) ==========")
@@ -1046,7 +1229,7 @@ def main():
     print(f"  Oracle GB-hop           = {wafer_gbhop}")
     print(f"  Oracle peak_link_bytes  = {wafer_peak}")
     print(f"  MICRO total_bytes       = {total_wafer_micro}")
-    print(f"  MICRO num_layers        = {len(phases_wafer)}")
+    print(f"  MICRO num_layers        = {num_layers_wafer}")
     print(f"  AstraSim Comm time      = {comm_wafer}")
     print("")
     print("HyperWafer mapping:")
@@ -1054,7 +1237,7 @@ def main():
     print(f"  Oracle GB-hop           = {hyper_gbhop}")
     print(f"  Oracle peak_link_bytes  = {hyper_peak}")
     print(f"  MICRO total_bytes       = {total_hyper_micro}")
-    print(f"  MICRO num_layers        = {len(phases_hyper)}")
+    print(f"  MICRO num_layers        = {num_layers_hyper}")
     print(f"  AstraSim Comm time      = {comm_hyper}")
     print("")
     if hyper_total > 0:
@@ -0,0 +1,154 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025 HyperWafer Authors
+
+#include "ChakraEmitter.h"
+#include "Parallel.h"
+#include "et_def.pb.h"
+#include "protoio.hh"
+#include <cassert>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+using namespace HyperWafer;
+
+namespace {
+
+/// schema version recorded by the Chakra text converter
+constexpr auto chakra_schema = "1.0.2-chakra.0.0.4";
+
+/// Chakra collective type of a MICRO collective name, 0 if unknown (as the Chakra text converter)
+ChakraProtoMsg::CollectiveCommType collective_type(const std::string& comm_type) noexcept {
+    if (comm_type == "ALLREDUCE") {
+        return ChakraProtoMsg::ALL_REDUCE;
+    }
+    if (comm_type == "ALLTOALL") {
+        return ChakraProtoMsg::ALL_TO_ALL;
+    }
+    if (comm_type == "ALLGATHER") {
+        return ChakraProtoMsg::ALL_GATHER;
+    }
+    if (comm_type == "REDUCESCATTER") {
+        return ChakraProtoMsg::REDUCE_SCATTER;
+    }
+    return static_cast<ChakraProtoMsg::CollectiveCommType>(0);
+}
+
+}  // namespace
+
+std::vector<MicroPhase> ChakraEmitter::single_phase(const std::string& tag, const int64_t total_bytes) noexcept {
+    return {MicroPhase{"SpGEMM_BcastB_" + tag + "_total", "ALLGATHER", total_bytes}};
+}
+
+std::vector<MicroPhase> ChakraEmitter::rows_batch_phases(const std::vector<int64_t>& row_bytes,
+                                                         const std::string& tag,
+                                                         int64_t rows_per_layer) noexcept {
+    if (rows_per_layer <= 0) {
+        rows_per_layer = 1;
+    }
+
+    auto phases = std::vector<MicroPhase>();
+    if (row_bytes.empty()) {
+        phases.push_back(MicroPhase{"SpGEMM_BcastB_" + tag + "_noop", "ALLGATHER", 0});
+        return phases;
+    }
+
+    const auto phase_name = [&tag](const size_t index) {
+        char suffix[32];
+        std::snprintf(suffix, sizeof(suffix), "_phase%04zu", index);
+        return "SpGEMM_BcastB_" + tag + suffix;
+    };
+
+    auto bytes = int64_t{0};
+    auto rows = int64_t{0};
+    for (const auto row_bytes_k : row_bytes) {
+        bytes += row_bytes_k;
+        rows++;
+        if (rows >= rows_per_layer) {
+            phases.push_back(MicroPhase{phase_name(phases.size()), "ALLGATHER", bytes});
+            bytes = 0;
+            rows = 0;
+        }
+    }
+    if (rows > 0) {
+        phases.push_back(MicroPhase{phase_name(phases.size()), "ALLGATHER", bytes});
+    }
+
+    return phases;
+}
+
+std::string ChakraEmitter::micro_text(const std::vector<MicroPhase>& phases) noexcept {
+    auto text = std::ostringstream();
+    text << "MICRO\n" << phases.size() << '\n';
+    for (const auto& phase : phases) {
+        text << phase.name << "  -1  0  NONE 0  0  NONE 0  0  " << phase.comm_type << "   " << phase.bytes
+             << "  0\n";
+    }
+    return text.str();
+}
+
+void ChakraEmitter::write_micro_text(const std::string& path, const std::vector<MicroPhase>& phases) noexcept {
+    auto file = std::ofstream(path, std::ios::binary | std::ios::trunc);
+    if (!file) {
+        std::cerr << "[Error] (spgemm_oracle) cannot create MICRO file: " << path << std::endl;
+        std::exit(-1);
+    }
+    file << micro_text(phases);
+}
+
+void ChakraEmitter::write_traces(const std::string& prefix,
+                                 const std::vector<MicroPhase>& phases,
+                                 const int npus_count,
+                                 const int passes_count,
+                                 const int threads_count) noexcept {
+    assert(npus_count > 0);
+    assert(passes_count >= 0);
+
+    // the converter records the whole MICRO text in the metadata of every trace
+    auto metadata = ChakraProtoMsg::GlobalMetadata();
+    auto* const schema_attr = metadata.add_attr();
+    schema_attr->set_name("schema");
+    schema_attr->set_string_val(chakra_schema);
+    auto* const input_attr = metadata.add_attr();
+    input_attr->set_name("input_file");
+    input_attr->set_string_val(micro_text(phases));
+
+    // one collective node per phase; only the id differs across NPUs and passes
+    auto layer_nodes = std::vector<ChakraProtoMsg::Node>(phases.size());
+    for (auto layer = size_t{0}; layer < phases.size(); layer++) {
+        auto& node = layer_nodes[layer];
+        node.set_name("COMM_COLL_NODE_" + phases[layer].name + "_" + phases[layer].comm_type);
+        node.set_type(ChakraProtoMsg::COMM_COLL_NODE);
+        auto* const comm_type_attr = node.add_attr();
+        comm_type_attr->set_name("comm_type");
+        comm_type_attr->set_int64_val(collective_type(phases[layer].comm_type));
+        auto* const comm_size_attr = node.add_attr();
+        comm_size_attr->set_name("comm_size");
+        comm_size_attr->set_int64_val(phases[layer].bytes);
+    }
+
+    // node ids keep increasing across NPUs, as the converter uses a single counter
+    const auto layers_count = static_cast<uint64_t>(phases.size());
+    parallel_for(threads_count, npus_count, 1, [&](const int64_t begin, const int64_t end, int) {
+        auto nodes = layer_nodes;
+        for (auto npu = begin; npu < end; npu++) {
+            const auto path = prefix + "." + std::to_string(npu) + ".et";
+            if (!std::ofstream(path, std::ios::binary | std::ios::trunc)) {
+                std::cerr << "[Error] (spgemm_oracle) cannot create trace: " << path << std::endl;
+                std::exit(-1);
+            }
+
+            auto stream = ProtoOutputStream(path);
+            stream.write(metadata);
+            auto node_id = static_cast<uint64_t>(npu) * static_cast<uint64_t>(passes_count) * layers_count;
+            for (auto pass = 0; pass < passes_count; pass++) {
+                for (auto& node : nodes) {
+                    node.set_id(node_id++);
+                    stream.write(node);
+                }
+            }
+        }
+    });
+}
@@ -0,0 +1,89 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025 HyperWafer Authors
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace HyperWafer {
+
+/**
+ * MicroPhase is one layer of a MICRO workload: a single collective.
+ */
+struct MicroPhase {
+    /// layer name
+    std::string name;
+
+    /// collective type, as written in the MICRO text (e.g., ALLGATHER)
+    std::string comm_type;
+
+    /// collective size in bytes
+    int64_t bytes;
+};
+
+/**
+ * ChakraEmitter builds the MICRO phases of the B-row broadcasts and writes them
+ * both as MICRO text and directly as Chakra execution traces, producing the same
+ * files as write_micro_text() of spgemm_full_pipeline.py followed by
+ * `chakra_converter Text`.
+ */
+class ChakraEmitter {
+  public:
+    /**
+     * A single phase carrying the total broadcast bytes.
+     *
+     * @param tag mapping tag used in the phase name
+     * @param total_bytes total broadcast bytes
+     * @return MICRO phases
+     */
+    [[nodiscard]] static std::vector<MicroPhase> single_phase(const std::string& tag, int64_t total_bytes) noexcept;
+
+    /**
+     * Batch consecutive B rows, rows_per_layer rows per phase (the last phase may hold fewer),
+     * or a single empty phase if no B row is sent.
+     *
+     * @param row_bytes broadcast bytes of each B row sent to remote tiles
+     * @param tag mapping tag used in the phase names
+     * @param rows_per_layer number of B rows per phase
+     * @return MICRO phases
+     */
+    [[nodiscard]] static std::vector<MicroPhase> rows_batch_phases(const std::vector<int64_t>& row_bytes,
+                                                                   const std::string& tag,
+                                                                   int64_t rows_per_layer) noexcept;
+
+    /**
+     * Render phases as MICRO text.
+     *
+     * @param phases MICRO phases
+     * @return MICRO text
+     */
+    [[nodiscard]] static std::string micro_text(const std::vector<MicroPhase>& phases) noexcept;
+
+    /**
+     * Write the MICRO text file.
+     *
+     * @param path path of the MICRO text file
+     * @param phases MICRO phases
+     */
+    static void write_micro_text(const std::string& path, const std::vector<MicroPhase>& phases) noexcept;
+
+    /**
+     * Write one Chakra execution trace per NPU, <prefix>.<npu>.et,
+     * with every phase as a collective node, repeated num_passes times.
+     *
+     * @param prefix path prefix of the traces
+     * @param phases MICRO phases
+     * @param npus_count number of NPUs
+     * @param passes_count number of passes
+     * @param threads_count number of threads
+     */
+    static void write_traces(const std::string& prefix,
+                             const std::vector<MicroPhase>& phases,
+                             int npus_count,
+                             int passes_count,
+                             int threads_count) noexcept;
+};
+
+}  // namespace HyperWafer
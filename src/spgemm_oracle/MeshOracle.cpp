@@ -0,0 +1,348 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025 HyperWafer Authors
+
+#include "MeshOracle.h"
+#include "Parallel.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <tuple>
+
+using namespace HyperWafer;
+
+namespace {
+
+/// B rows handled per parallel block
+constexpr int64_t rows_block_size = 2048;
+
+/// per-thread accumulators of simulate_bcast()
+struct BcastAccumulator {
+    /// last B row that marked each tile as a destination
+    std::vector<int64_t> stamp;
+
+    /// distinct destination tiles of the current B row
+    std::vector<TileId> dest_tiles;
+
+    /// per mesh column, difference array of the bytes on its vertical links
+    std::vector<int64_t> vertical_diff;
+
+    /// per mesh row, difference array of the bytes on its horizontal links
+    std::vector<int64_t> horizontal_diff;
+
+    int64_t total_bytes = 0;
+    int64_t gb_hop = 0;
+    int64_t sum_tiles_all = 0;
+    int64_t sum_recv_all = 0;
+    int64_t rows_count_all = 0;
+    int64_t sum_tiles_comm = 0;
+    int64_t sum_recv_comm = 0;
+    int64_t rows_count_comm = 0;
+};
+
+/// average of a sum over a count, 0 if the count is 0
+double average(const int64_t sum, const int64_t count) noexcept {
+    return (count > 0) ? static_cast<double>(sum) / static_cast<double>(count) : 0.0;
+}
+
+}  // namespace
+
+std::pair<int, int> MeshOracle::mesh_dims(const int tiles_count) noexcept {
+    if (tiles_count <= 0) {
+        return {1, 1};
+    }
+
+    auto p = std::max(1, static_cast<int>(std::floor(std::sqrt(static_cast<double>(tiles_count)))));
+    while (p > 1 && tiles_count % p != 0) {
+        p--;
+    }
+    return {p, tiles_count / p};
+}
+
+MeshOracle::MeshOracle(const int tiles_count, const int threads_count) noexcept
+    : tiles_count(tiles_count),
+      threads_count(threads_count) {
+    assert(tiles_count > 0);
+    assert(threads_count > 0);
+
+    std::tie(rows_count, cols_count) = mesh_dims(tiles_count);
+}
+
+int MeshOracle::get_rows_count() const noexcept {
+    return rows_count;
+}
+
+int MeshOracle::get_cols_count() const noexcept {
+    return cols_count;
+}
+
+int MeshOracle::get_link_slots_count() const noexcept {
+    return 2 * tiles_count;
+}
+
+int MeshOracle::link_index(const TileId tile, const bool vertical) const noexcept {
+    assert(0 <= tile && tile < tiles_count);
+
+    return vertical ? tile : tiles_count + tile;
+}
+
+std::vector<TileId> MeshOracle::rowblock_partition(const int64_t rows_count) const noexcept {
+    const auto rows_per_part = std::max<int64_t>(1, (rows_count + tiles_count - 1) / tiles_count);
+
+    auto part = std::vector<TileId>(rows_count);
+    for (auto row = int64_t{0}; row < rows_count; row++) {
+        part[row] = static_cast<TileId>(std::min<int64_t>(row / rows_per_part, tiles_count - 1));
+    }
+    return part;
+}
+
+std::vector<TileId> MeshOracle::mod_owners(const int64_t rows_count) const noexcept {
+    auto owner = std::vector<TileId>(rows_count);
+    for (auto row = int64_t{0}; row < rows_count; row++) {
+        owner[row] = static_cast<TileId>(row % tiles_count);
+    }
+    return owner;
+}
+
+std::vector<TileId> MeshOracle::center_owners(const SparsePattern& a_cols,
+                                              const std::vector<TileId>& row_part) const noexcept {
+    const auto b_rows_count = a_cols.get_rows_count();
+    auto owner = std::vector<TileId>(b_rows_count);
+
+    auto counts = std::vector<std::vector<int64_t>>(threads_count, std::vector<int64_t>(tiles_count, 0));
+    auto touched = std::vector<std::vector<TileId>>(threads_count);
+    parallel_for(threads_count, b_rows_count, rows_block_size,
+                 [&](const int64_t begin, const int64_t end, const int thread_id) {
+                     auto& tile_counts = counts[thread_id];
+                     auto& used_tiles = touched[thread_id];
+                     for (auto k = begin; k < end; k++) {
+                         const auto rows_used = a_cols.row_nnz(k);
+                         if (rows_used == 0) {
+                             owner[k] = static_cast<TileId>(k % tiles_count);
+                             continue;
+                         }
+
+                         const auto* const rows = a_cols.row_indices(k);
+                         for (auto i = int64_t{0}; i < rows_used; i++) {
+                             const auto tile = row_part[rows[i]];
+                             if (tile_counts[tile]++ == 0) {
+                                 used_tiles.push_back(tile);
+                             }
+                         }
+
+                         // majority tile, lowest id on ties (as numpy.argmax)
+                         auto best = used_tiles.front();
+                         for (const auto tile : used_tiles) {
+                             if (tile_counts[tile] > tile_counts[best] ||
+                                 (tile_counts[tile] == tile_counts[best] && tile < best)) {
+                                 best = tile;
+                             }
+                         }
+                         for (const auto tile : used_tiles) {
+                             tile_counts[tile] = 0;
+                         }
+                         used_tiles.clear();
+                         owner[k] = best;
+                     }
+                 });
+
+    return owner;
+}
+
+std::vector<TileId> MeshOracle::load_partition(const std::string& path, const int64_t vertices_count) const noexcept {
+    auto file = std::ifstream(path);
+    if (!file) {
+        std::cerr << "[Error] (spgemm_oracle) cannot open partition file: " << path << std::endl;
+        std::exit(-1);
+    }
+
+    // whitespace-separated integers, '#' starts a comment (as numpy.loadtxt)
+    auto part = std::vector<TileId>();
+    part.reserve(vertices_count);
+    auto line = std::string();
+    auto max_tile = TileId{-1};
+    while (std::getline(file, line)) {
+        const auto comment = line.find('#');
+        if (comment != std::string::npos) {
+            line.resize(comment);
+        }
+
+        const auto* cursor = line.c_str();
+        while (true) {
+            char* token_end = nullptr;
+            const auto value = std::strtoll(cursor, &token_end, 10);
+            if (token_end == cursor) {
+                break;
+            }
+            if (value < 0 || value >= tiles_count) {
+                std::cerr << "[Error] (spgemm_oracle) partition id " << value << " is out of range [0, "
+                          << tiles_count << "): " << path << std::endl;
+                std::exit(-1);
+            }
+            part.push_back(static_cast<TileId>(value));
+            max_tile = std::max(max_tile, part.back());
+            cursor = token_end;
+        }
+        if (*cursor != '\0' && line.find_first_not_of(" \t\r", cursor - line.c_str()) != std::string::npos) {
+            std::cerr << "[Error] (spgemm_oracle) invalid partition line: " << line << std::endl;
+            std::exit(-1);
+        }
+    }
+
+    if (static_cast<int64_t>(part.size()) != vertices_count) {
+        std::cerr << "[Error] (spgemm_oracle) partition length " << part.size() << " != num_vertices "
+                  << vertices_count << std::endl;
+        std::exit(-1);
+    }
+
+    std::cout << "[info]   num_parts(from file) = " << max_tile + 1 << std::endl;
+    return part;
+}
+
+BcastResult MeshOracle::simulate_bcast(const SparsePattern& a_cols,
+                                       const std::vector<int64_t>& b_row_nnz,
+                                       const std::vector<TileId>& row_part,
+                                       const std::vector<TileId>& owner_b,
+                                       const int64_t elem_bytes) const noexcept {
+    const auto b_rows_count = static_cast<int64_t>(b_row_nnz.size());
+    assert(a_cols.get_rows_count() == b_rows_count);
+    assert(static_cast<int64_t>(owner_b.size()) == b_rows_count);
+
+    // number of remote destinations of each B row, 0 if it is not sent
+    auto row_dests_count = std::vector<int32_t>(b_rows_count, 0);
+
+    auto accumulators = std::vector<BcastAccumulator>(threads_count);
+    for (auto& accumulator : accumulators) {
+        accumulator.stamp.assign(tiles_count, -1);
+        accumulator.vertical_diff.assign(static_cast<size_t>(cols_count) * (rows_count + 1), 0);
+        accumulator.horizontal_diff.assign(static_cast<size_t>(rows_count) * (cols_count + 1), 0);
+    }
+
+    parallel_for(threads_count, b_rows_count, rows_block_size, [&](const int64_t begin, const int64_t end,
+                                                                   const int thread_id) {
+        auto& accumulator = accumulators[thread_id];
+        auto& dest_tiles = accumulator.dest_tiles;
+        for (auto k = begin; k < end; k++) {
+            const auto rows_used = a_cols.row_nnz(k);
+            if (rows_used == 0) {
+                continue;
+            }
+            const auto nnz_b_row = b_row_nnz[k];
+            if (nnz_b_row == 0) {
+                continue;
+            }
+
+            // distinct tiles using B row k
+            dest_tiles.clear();
+            const auto* const rows = a_cols.row_indices(k);
+            for (auto i = int64_t{0}; i < rows_used; i++) {
+                const auto tile = row_part[rows[i]];
+                if (accumulator.stamp[tile] != k) {
+                    accumulator.stamp[tile] = k;
+                    dest_tiles.push_back(tile);
+                }
+            }
+
+            const auto src = owner_b[k];
+            const auto tiles_using = static_cast<int64_t>(dest_tiles.size());
+            const auto recv_count = tiles_using - ((accumulator.stamp[src] == k) ? 1 : 0);
+
+            accumulator.sum_tiles_all += tiles_using;
+            accumulator.sum_recv_all += recv_count;
+            accumulator.rows_count_all++;
+            if (recv_count <= 0) {
+                continue;
+            }
+            accumulator.sum_tiles_comm += tiles_using;
+            accumulator.sum_recv_comm += recv_count;
+            accumulator.rows_count_comm++;
+            row_dests_count[k] = static_cast<int32_t>(recv_count);
+
+            // route rows first along the source column, then columns along the destination row
+            const auto bytes_k = nnz_b_row * elem_bytes;
+            const auto src_row = src / cols_count;
+            const auto src_col = src % cols_count;
+            auto* const column_diff = accumulator.vertical_diff.data() + static_cast<size_t>(src_col) * (rows_count + 1);
+            for (const auto dest : dest_tiles) {
+                if (dest == src) {
+                    continue;
+                }
+                const auto dest_row = dest / cols_count;
+                const auto dest_col = dest % cols_count;
+
+                if (src_row != dest_row) {
+                    column_diff[std::min(src_row, dest_row)] += bytes_k;
+                    column_diff[std::max(src_row, dest_row)] -= bytes_k;
+                }
+                if (src_col != dest_col) {
+                    auto* const row_diff =
+                        accumulator.horizontal_diff.data() + static_cast<size_t>(dest_row) * (cols_count + 1);
+                    row_diff[std::min(src_col, dest_col)] += bytes_k;
+                    row_diff[std::max(src_col, dest_col)] -= bytes_k;
+                }
+
+                const auto hops = std::abs(src_row - dest_row) + std::abs(src_col - dest_col);
+                accumulator.total_bytes += bytes_k;
+                accumulator.gb_hop += bytes_k * hops;
+            }
+        }
+    });
+
+    // merge the accumulators
+    auto result = BcastResult();
+    auto vertical_diff = std::vector<int64_t>(static_cast<size_t>(cols_count) * (rows_count + 1), 0);
+    auto horizontal_diff = std::vector<int64_t>(static_cast<size_t>(rows_count) * (cols_count + 1), 0);
+    auto sum_tiles_all = int64_t{0};
+    auto sum_recv_all = int64_t{0};
+    auto sum_tiles_comm = int64_t{0};
+    auto sum_recv_comm = int64_t{0};
+    for (const auto& accumulator : accumulators) {
+        for (auto i = size_t{0}; i < vertical_diff.size(); i++) {
+            vertical_diff[i] += accumulator.vertical_diff[i];
+        }
+        for (auto i = size_t{0}; i < horizontal_diff.size(); i++) {
+            horizontal_diff[i] += accumulator.horizontal_diff[i];
+        }
+        result.total_bytes += accumulator.total_bytes;
+        result.gb_hop += accumulator.gb_hop;
+        result.rows_count_all += accumulator.rows_count_all;
+        result.rows_count_comm += accumulator.rows_count_comm;
+        sum_tiles_all += accumulator.sum_tiles_all;
+        sum_recv_all += accumulator.sum_recv_all;
+        sum_tiles_comm += accumulator.sum_tiles_comm;
+        sum_recv_comm += accumulator.sum_recv_comm;
+    }
+    result.avg_tiles_all = average(sum_tiles_all, result.rows_count_all);
+    result.avg_recv_all = average(sum_recv_all, result.rows_count_all);
+    result.avg_tiles_comm = average(sum_tiles_comm, result.rows_count_comm);
+    result.avg_recv_comm = average(sum_recv_comm, result.rows_count_comm);
+
+    // prefix sums of the difference arrays give the bytes of each link
+    result.link_bytes.assign(get_link_slots_count(), 0);
+    for (auto col = 0; col < cols_count; col++) {
+        auto bytes = int64_t{0};
+        for (auto row = 0; row + 1 < rows_count; row++) {
+            bytes += vertical_diff[static_cast<size_t>(col) * (rows_count + 1) + row];
+            result.link_bytes[link_index(row * cols_count + col, true)] = bytes;
+        }
+    }
+    for (auto row = 0; row < rows_count; row++) {
+        auto bytes = int64_t{0};
+        for (auto col = 0; col + 1 < cols_count; col++) {
+            bytes += horizontal_diff[static_cast<size_t>(row) * (cols_count + 1) + col];
+            result.link_bytes[link_index(row * cols_count + col, false)] = bytes;
+        }
+    }
+    result.peak_link = *std::max_element(result.link_bytes.begin(), result.link_bytes.end());
+
+    // bytes of each B row sent to remote tiles, in row order
+    for (auto k = int64_t{0}; k < b_rows_count; k++) {
+        if (row_dests_count[k] > 0) {
+            result.row_bytes.push_back(b_row_nnz[k] * elem_bytes * row_dests_count[k]);
+        }
+    }
+
+    return result;
+}
@@ -0,0 +1,180 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025 HyperWafer Authors
+
+#pragma once
+
+#include "SparsePattern.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace HyperWafer {
+
+/// tile (NPU) id of a 2D mesh
+using TileId = int32_t;
+
+/**
+ * BcastResult holds the traffic of broadcasting every B row
+ * from its owner tile to the tiles whose A rows consume it.
+ */
+struct BcastResult {
+    /// bytes delivered to remote tiles
+    int64_t total_bytes;
+
+    /// bytes times hops of every delivery
+    int64_t gb_hop;
+
+    /// bytes carried by the busiest (undirected) link
+    int64_t peak_link;
+
+    /// bytes carried by each undirected link, see MeshOracle::link_index()
+    std::vector<int64_t> link_bytes;
+
+    /// number of B rows with work, i.e., used by at least one A row and not empty
+    int64_t rows_count_all;
+
+    /// number of B rows with work that are sent to at least one remote tile
+    int64_t rows_count_comm;
+
+    /// average number of tiles using a B row with work
+    double avg_tiles_all;
+
+    /// average number of remote tiles receiving a B row with work
+    double avg_recv_all;
+
+    /// average number of tiles using a B row sent to remote tiles
+    double avg_tiles_comm;
+
+    /// average number of remote tiles receiving a B row sent to remote tiles
+    double avg_recv_comm;
+
+    /// broadcast bytes of each B row sent to remote tiles, in row order
+    std::vector<int64_t> row_bytes;
+};
+
+/**
+ * MeshOracle measures the exact traffic of SpGEMM B-row broadcasts on a p x q 2D mesh,
+ * matching simulate_bcast_on_mesh() and collect_bcast_row_bytes() of spgemm_full_pipeline.py.
+ *
+ * Tile (r, c) has id r * q + c, and each delivery is routed rows first, then columns,
+ * as Mesh2D::route() of the congestion-aware backend does.
+ * Traffic is accumulated per undirected link.
+ */
+class MeshOracle {
+  public:
+    /**
+     * Find (p, q) with p * q == tiles_count and p <= q as close as possible,
+     * falling back to 1 x tiles_count if tiles_count is prime.
+     *
+     * @param tiles_count number of tiles
+     * @return (p, q) mesh dimensions
+     */
+    [[nodiscard]] static std::pair<int, int> mesh_dims(int tiles_count) noexcept;
+
+    /**
+     * Constructor.
+     *
+     * @param tiles_count number of tiles of the mesh
+     * @param threads_count number of threads
+     */
+    MeshOracle(int tiles_count, int threads_count) noexcept;
+
+    /**
+     * Get the number of mesh rows.
+     *
+     * @return number of mesh rows (p)
+     */
+    [[nodiscard]] int get_rows_count() const noexcept;
+
+    /**
+     * Get the number of mesh columns.
+     *
+     * @return number of mesh columns (q)
+     */
+    [[nodiscard]] int get_cols_count() const noexcept;
+
+    /**
+     * Get the number of undirected link slots, i.e., the size of BcastResult::link_bytes.
+     *
+     * @return number of link slots
+     */
+    [[nodiscard]] int get_link_slots_count() const noexcept;
+
+    /**
+     * Get the link slot of the undirected link between adjacent tiles.
+     * Vertical links come first, indexed by their upper tile,
+     * followed by horizontal links, indexed by their left tile.
+     *
+     * @param tile tile id
+     * @param vertical true for the link to tile + q, false for the link to tile + 1
+     * @return link slot
+     */
+    [[nodiscard]] int link_index(TileId tile, bool vertical) const noexcept;
+
+    /**
+     * WaferSpMM row-block partition: rows are split in contiguous blocks of ceil(rows / tiles).
+     *
+     * @param rows_count number of rows
+     * @return tile of each row
+     */
+    [[nodiscard]] std::vector<TileId> rowblock_partition(int64_t rows_count) const noexcept;
+
+    /**
+     * WaferSpMM B-row owners with rows assigned modulo the number of tiles.
+     *
+     * @param rows_count number of B rows
+     * @return owner tile of each B row
+     */
+    [[nodiscard]] std::vector<TileId> mod_owners(int64_t rows_count) const noexcept;
+
+    /**
+     * HyperWafer B-row owners: the tile hosting most A rows using the B row
+     * (lowest tile id on ties), or row % tiles if no A row uses it.
+     *
+     * @param a_cols columns of A, i.e., the rows of A using each B row
+     * @param row_part tile of each A row
+     * @return owner tile of each B row
+     */
+    [[nodiscard]] std::vector<TileId> center_owners(const SparsePattern& a_cols,
+                                                    const std::vector<TileId>& row_part) const noexcept;
+
+    /**
+     * Load a partition file with one tile id per line, e.g., as written by Mt-KaHyPar.
+     *
+     * @param path path of the partition file
+     * @param vertices_count expected number of vertices
+     * @return tile of each vertex
+     */
+    [[nodiscard]] std::vector<TileId> load_partition(const std::string& path, int64_t vertices_count) const noexcept;
+
+    /**
+     * Broadcast every B row to the tiles using it, and measure the traffic.
+     *
+     * @param a_cols columns of A, i.e., the rows of A using each B row
+     * @param b_row_nnz number of nonzeros of each B row
+     * @param row_part tile of each A row
+     * @param owner_b owner tile of each B row
+     * @param elem_bytes bytes per B nonzero
+     * @return measured traffic
+     */
+    [[nodiscard]] BcastResult simulate_bcast(const SparsePattern& a_cols,
+                                             const std::vector<int64_t>& b_row_nnz,
+                                             const std::vector<TileId>& row_part,
+                                             const std::vector<TileId>& owner_b,
+                                             int64_t elem_bytes) const noexcept;
+
+  private:
+    /// number of tiles
+    int tiles_count;
+
+    /// number of mesh rows
+    int rows_count;
+
+    /// number of mesh columns
+    int cols_count;
+
+    /// number of threads
+    int threads_count;
+};
+
+}  // namespace HyperWafer
@@ -0,0 +1,47 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025 HyperWafer Authors
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+namespace HyperWafer {
+
+/**
+ * Invoke function(begin, end, thread_id) over [0, items_count) split into blocks,
+ * with threads taking the next block as they finish (so skewed blocks balance out).
+ *
+ * @param threads_count number of threads
+ * @param items_count number of items
+ * @param block_size number of items per block
+ * @param function callback invoked per block
+ */
+template <typename Function>
+void parallel_for(const int threads_count, const int64_t items_count, const int64_t block_size, Function&& function) {
+    auto next_item = std::atomic<int64_t>(0);
+    const auto run = [&](const int thread_id) {
+        while (true) {
+            const auto begin = next_item.fetch_add(block_size, std::memory_order_relaxed);
+            if (begin >= items_count) {
+                return;
+            }
+            function(begin, std::min(begin + block_size, items_count), thread_id);
+        }
+    };
+
+    // the calling thread works as thread 0
+    auto workers = std::vector<std::thread>();
+    for (auto thread_id = 1; thread_id < threads_count; thread_id++) {
+        workers.emplace_back(run, thread_id);
+    }
+    run(0);
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+}  // namespace HyperWafer
@@ -0,0 +1,430 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025 HyperWafer Authors
+
+#include "SparsePattern.h"
+#include "Parallel.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cassert>
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <iostream>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace HyperWafer;
+
+namespace {
+
+/// magic header identifying a CSR binary file
+constexpr char csr_magic[8] = {'H', 'W', 'C', 'S', 'R', '0', '0', '1'};
+
+/// rows handled per parallel block
+constexpr int64_t rows_block_size = 4096;
+
+/// bytes parsed per parallel block of a Matrix Market file
+constexpr size_t parse_block_size = size_t{1} << 22;
+
+/// read-only memory mapping of a whole file
+class MappedFile {
+  public:
+    explicit MappedFile(const std::string& path) noexcept : data(nullptr), size(0) {
+        const auto fd = open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            std::cerr << "[Error] (spgemm_oracle) cannot open matrix file: " << path << std::endl;
+            std::exit(-1);
+        }
+        struct stat file_stat = {};
+        fstat(fd, &file_stat);
+        size = static_cast<size_t>(file_stat.st_size);
+        if (size > 0) {
+            auto* const mapped = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (mapped == MAP_FAILED) {
+                std::cerr << "[Error] (spgemm_oracle) cannot map matrix file: " << path << std::endl;
+                std::exit(-1);
+            }
+            madvise(mapped, size, MADV_SEQUENTIAL);
+            data = static_cast<const char*>(mapped);
+        }
+        close(fd);
+    }
+
+    ~MappedFile() noexcept {
+        if (data != nullptr) {
+            munmap(const_cast<char*>(data), size);
+        }
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    const char* data;
+    size_t size;
+};
+
+/// position right after the end of the line starting at position
+size_t next_line(const char* const data, const size_t size, const size_t position) noexcept {
+    const auto* const newline = static_cast<const char*>(std::memchr(data + position, '\n', size - position));
+    return (newline == nullptr) ? size : static_cast<size_t>(newline - data) + 1;
+}
+
+/// parse an unsigned decimal integer, skipping leading blanks; returns false if there is none
+bool parse_integer(const char*& cursor, const char* const end, uint64_t& value) noexcept {
+    while (cursor < end && (*cursor == ' ' || *cursor == '\t' || *cursor == '\r')) {
+        cursor++;
+    }
+    if (cursor >= end || *cursor < '0' || *cursor > '9') {
+        return false;
+    }
+    value = 0;
+    while (cursor < end && *cursor >= '0' && *cursor <= '9') {
+        value = value * 10 + static_cast<uint64_t>(*cursor - '0');
+        cursor++;
+    }
+    return true;
+}
+
+/// lowercase copy of a string
+std::string lowercase(std::string text) noexcept {
+    std::transform(text.begin(), text.end(), text.begin(), [](const unsigned char c) { return std::tolower(c); });
+    return text;
+}
+
+}  // namespace
+
+SparsePattern::SparsePattern(const int64_t rows_count, const int64_t cols_count) noexcept
+    : rows_count(rows_count),
+      cols_count(cols_count),
+      offsets(rows_count + 1, 0) {
+    assert(rows_count >= 0);
+    assert(cols_count >= 0);
+}
+
+SparsePattern SparsePattern::load(const std::string& path, const int threads_count, const bool transposed) noexcept {
+    assert(threads_count > 0);
+
+    // choose the format by the file extension
+    const auto matrix_market_extension = std::string(".mtx");
+    if (path.size() >= matrix_market_extension.size() &&
+        lowercase(path.substr(path.size() - matrix_market_extension.size())) == matrix_market_extension) {
+        return load_matrix_market(path, threads_count, transposed);
+    }
+
+    auto pattern = load_csr(path);
+    if (transposed) {
+        return pattern.transpose(threads_count);
+    }
+    return pattern;
+}
+
+int64_t SparsePattern::get_rows_count() const noexcept {
+    return rows_count;
+}
+
+int64_t SparsePattern::get_cols_count() const noexcept {
+    return cols_count;
+}
+
+int64_t SparsePattern::get_nnz() const noexcept {
+    return offsets[rows_count];
+}
+
+int64_t SparsePattern::row_nnz(const int64_t row) const noexcept {
+    assert(0 <= row && row < rows_count);
+
+    return offsets[row + 1] - offsets[row];
+}
+
+const uint32_t* SparsePattern::row_indices(const int64_t row) const noexcept {
+    assert(0 <= row && row < rows_count);
+
+    return indices.data() + offsets[row];
+}
+
+SparsePattern SparsePattern::transpose(const int threads_count) const noexcept {
+    // a transposed pattern has no duplicates, so it only needs to be scattered and sorted
+    auto transposed = SparsePattern(cols_count, rows_count);
+
+    // count the entries of each column
+    auto counts = std::vector<std::atomic<int64_t>>(cols_count);
+    parallel_for(threads_count, rows_count, rows_block_size, [&](const int64_t begin, const int64_t end, int) {
+        for (auto row = begin; row < end; row++) {
+            for (auto i = offsets[row]; i < offsets[row + 1]; i++) {
+                counts[indices[i]].fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+    });
+    for (auto col = int64_t{0}; col < cols_count; col++) {
+        transposed.offsets[col + 1] = transposed.offsets[col] + counts[col].load(std::memory_order_relaxed);
+        counts[col].store(transposed.offsets[col], std::memory_order_relaxed);
+    }
+
+    // scatter the entries into their column
+    transposed.indices.resize(get_nnz());
+    parallel_for(threads_count, rows_count, rows_block_size, [&](const int64_t begin, const int64_t end, int) {
+        for (auto row = begin; row < end; row++) {
+            for (auto i = offsets[row]; i < offsets[row + 1]; i++) {
+                const auto position = counts[indices[i]].fetch_add(1, std::memory_order_relaxed);
+                transposed.indices[position] = static_cast<uint32_t>(row);
+            }
+        }
+    });
+
+    // scattering is unordered, so sort each column
+    parallel_for(threads_count, cols_count, rows_block_size, [&](const int64_t begin, const int64_t end, int) {
+        for (auto col = begin; col < end; col++) {
+            std::sort(transposed.indices.begin() + transposed.offsets[col],
+                      transposed.indices.begin() + transposed.offsets[col + 1]);
+        }
+    });
+
+    return transposed;
+}
+
+void SparsePattern::write_csr(const std::string& path) const noexcept {
+    auto* const file = std::fopen(path.c_str(), "wb");
+    if (file == nullptr) {
+        std::cerr << "[Error] (spgemm_oracle) cannot create CSR file: " << path << std::endl;
+        std::exit(-1);
+    }
+
+    const int64_t header[3] = {rows_count, cols_count, get_nnz()};
+    std::fwrite(csr_magic, 1, sizeof(csr_magic), file);
+    std::fwrite(header, sizeof(int64_t), 3, file);
+    std::fwrite(offsets.data(), sizeof(int64_t), offsets.size(), file);
+    std::fwrite(indices.data(), sizeof(uint32_t), indices.size(), file);
+    if (std::fclose(file) != 0) {
+        std::cerr << "[Error] (spgemm_oracle) cannot write CSR file: " << path << std::endl;
+        std::exit(-1);
+    }
+}
+
+SparsePattern SparsePattern::load_matrix_market(const std::string& path,
+                                                const int threads_count,
+                                                const bool transposed) noexcept {
+    const auto file = MappedFile(path);
+    const auto* const data = file.data;
+    const auto size = file.size;
+
+    // banner: %%MatrixMarket matrix coordinate <field> <symmetry>
+    auto position = next_line(data, size, 0);
+    auto banner = std::vector<std::string>();
+    {
+        const auto banner_line = lowercase(std::string(data, position));
+        auto begin = banner_line.find_first_not_of(" \t\r\n");
+        while (begin != std::string::npos) {
+            const auto end = banner_line.find_first_of(" \t\r\n", begin);
+            banner.push_back(banner_line.substr(begin, end - begin));
+            begin = banner_line.find_first_not_of(" \t\r\n", end);
+        }
+    }
+    if (banner.size() != 5 || banner[0] != "%%matrixmarket" || banner[1] != "matrix") {
+        std::cerr << "[Error] (spgemm_oracle) not a Matrix Market matrix: " << path << std::endl;
+        std::exit(-1);
+    }
+    if (banner[2] != "coordinate") {
+        std::cerr << "[Error] (spgemm_oracle) only Matrix Market coordinate format is supported, got " << banner[2]
+                  << ": " << path << std::endl;
+        std::exit(-1);
+    }
+    const auto& symmetry = banner[4];
+    if (symmetry != "general" && symmetry != "symmetric" && symmetry != "skew-symmetric" && symmetry != "hermitian") {
+        std::cerr << "[Error] (spgemm_oracle) unknown Matrix Market symmetry: " << symmetry << std::endl;
+        std::exit(-1);
+    }
+    const auto mirrored = (symmetry != "general");
+
+    // skip comments, then read the size line
+    while (position < size && (data[position] == '%' || data[position] == '\n' || data[position] == '\r')) {
+        position = next_line(data, size, position);
+    }
+    const auto size_line_end = next_line(data, size, position);
+    const auto* cursor = data + position;
+    auto dims = std::array<uint64_t, 3>();
+    for (auto& dim : dims) {
+        if (!parse_integer(cursor, data + size_line_end, dim)) {
+            std::cerr << "[Error] (spgemm_oracle) invalid Matrix Market size line: " << path << std::endl;
+            std::exit(-1);
+        }
+    }
+    const auto matrix_rows = static_cast<int64_t>(dims[0]);
+    const auto matrix_cols = static_cast<int64_t>(dims[1]);
+    const auto declared_entries = dims[2];
+    if (dims[0] > UINT32_MAX || dims[1] > UINT32_MAX) {
+        std::cerr << "[Error] (spgemm_oracle) matrix dimensions exceed 32-bit indices: " << path << std::endl;
+        std::exit(-1);
+    }
+    position = size_line_end;
+
+    // parse the entries in parallel blocks split at line boundaries
+    const auto data_size = size - position;
+    const auto blocks_count = static_cast<int64_t>((data_size + parse_block_size - 1) / parse_block_size);
+    auto block_entries = std::vector<std::vector<std::pair<uint32_t, uint32_t>>>(blocks_count);
+    auto parsed_entries = std::atomic<uint64_t>(0);
+    auto invalid_line = std::atomic<bool>(false);
+    parallel_for(threads_count, blocks_count, 1, [&](const int64_t begin_block, const int64_t end_block, int) {
+        for (auto block = begin_block; block < end_block; block++) {
+            // a block owns the lines starting inside it
+            auto begin = position + static_cast<size_t>(block) * parse_block_size;
+            const auto end = std::min(size, begin + parse_block_size);
+            if (begin > position && data[begin - 1] != '\n') {
+                begin = next_line(data, size, begin);
+            }
+
+            auto& entries = block_entries[block];
+            entries.reserve((end - std::min(begin, end)) / 8);
+            auto line = begin;
+            auto entries_count = uint64_t{0};
+            while (line < end) {
+                const auto line_end = next_line(data, size, line);
+                if (data[line] != '%') {
+                    const auto* cursor = data + line;
+                    auto row = uint64_t{0};
+                    auto col = uint64_t{0};
+                    if (parse_integer(cursor, data + line_end, row)) {
+                        if (!parse_integer(cursor, data + line_end, col) || row == 0 || col == 0 ||
+                            row > dims[0] || col > dims[1]) {
+                            invalid_line.store(true, std::memory_order_relaxed);
+                        } else {
+                            // Matrix Market indices are 1-based
+                            const auto major = static_cast<uint32_t>((transposed ? col : row) - 1);
+                            const auto minor = static_cast<uint32_t>((transposed ? row : col) - 1);
+                            entries.emplace_back(major, minor);
+                            if (mirrored && major != minor) {
+                                entries.emplace_back(minor, major);
+                            }
+                            entries_count++;
+                        }
+                    }
+                }
+                line = line_end;
+            }
+            parsed_entries.fetch_add(entries_count, std::memory_order_relaxed);
+        }
+    });
+
+    if (invalid_line.load()) {
+        std::cerr << "[Error] (spgemm_oracle) invalid or out-of-range Matrix Market entry: " << path << std::endl;
+        std::exit(-1);
+    }
+    if (parsed_entries.load() != declared_entries) {
+        std::cerr << "[Error] (spgemm_oracle) Matrix Market file declares " << declared_entries << " entries, found "
+                  << parsed_entries.load() << ": " << path << std::endl;
+        std::exit(-1);
+    }
+
+    if (transposed) {
+        return from_entries(matrix_cols, matrix_rows, block_entries, threads_count);
+    }
+    return from_entries(matrix_rows, matrix_cols, block_entries, threads_count);
+}
+
+SparsePattern SparsePattern::load_csr(const std::string& path) noexcept {
+    const auto invalid_file = [&path]() {
+        std::cerr << "[Error] (spgemm_oracle) invalid CSR file: " << path << std::endl;
+        std::exit(-1);
+    };
+
+    auto* const file = std::fopen(path.c_str(), "rb");
+    if (file == nullptr) {
+        std::cerr << "[Error] (spgemm_oracle) cannot open matrix file: " << path << std::endl;
+        std::exit(-1);
+    }
+
+    char magic[sizeof(csr_magic)];
+    int64_t header[3];
+    if (std::fread(magic, 1, sizeof(magic), file) != sizeof(magic) ||
+        std::memcmp(magic, csr_magic, sizeof(csr_magic)) != 0 || std::fread(header, sizeof(int64_t), 3, file) != 3 ||
+        header[0] < 0 || header[1] < 0 || header[2] < 0 || header[1] > int64_t{UINT32_MAX}) {
+        invalid_file();
+    }
+
+    auto pattern = SparsePattern(header[0], header[1]);
+    pattern.indices.resize(header[2]);
+    if (std::fread(pattern.offsets.data(), sizeof(int64_t), pattern.offsets.size(), file) != pattern.offsets.size() ||
+        std::fread(pattern.indices.data(), sizeof(uint32_t), pattern.indices.size(), file) !=
+            pattern.indices.size()) {
+        invalid_file();
+    }
+    std::fclose(file);
+
+    // validate the structure
+    if (pattern.offsets[0] != 0 || pattern.offsets[pattern.rows_count] != header[2]) {
+        invalid_file();
+    }
+    for (auto row = int64_t{0}; row < pattern.rows_count; row++) {
+        if (pattern.offsets[row] > pattern.offsets[row + 1]) {
+            invalid_file();
+        }
+    }
+    for (const auto index : pattern.indices) {
+        if (index >= pattern.cols_count) {
+            invalid_file();
+        }
+    }
+
+    return pattern;
+}
+
+SparsePattern SparsePattern::from_entries(const int64_t rows_count,
+                                          const int64_t cols_count,
+                                          const std::vector<std::vector<std::pair<uint32_t, uint32_t>>>& entries,
+                                          const int threads_count) noexcept {
+    const auto blocks_count = static_cast<int64_t>(entries.size());
+
+    // count the entries of each row
+    auto counts = std::vector<std::atomic<int64_t>>(rows_count);
+    parallel_for(threads_count, blocks_count, 1, [&](const int64_t begin, const int64_t end, int) {
+        for (auto block = begin; block < end; block++) {
+            for (const auto& [row, col] : entries[block]) {
+                counts[row].fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+    });
+    auto offsets = std::vector<int64_t>(rows_count + 1, 0);
+    for (auto row = int64_t{0}; row < rows_count; row++) {
+        offsets[row + 1] = offsets[row] + counts[row].load(std::memory_order_relaxed);
+        counts[row].store(offsets[row], std::memory_order_relaxed);
+    }
+
+    // scatter the entries into their row
+    auto indices = std::vector<uint32_t>(offsets[rows_count]);
+    parallel_for(threads_count, blocks_count, 1, [&](const int64_t begin, const int64_t end, int) {
+        for (auto block = begin; block < end; block++) {
+            for (const auto& [row, col] : entries[block]) {
+                indices[counts[row].fetch_add(1, std::memory_order_relaxed)] = col;
+            }
+        }
+    });
+
+    // sort each row and merge its duplicates in place
+    auto unique_counts = std::vector<int64_t>(rows_count);
+    parallel_for(threads_count, rows_count, rows_block_size, [&](const int64_t begin, const int64_t end, int) {
+        for (auto row = begin; row < end; row++) {
+            const auto row_begin = indices.begin() + offsets[row];
+            const auto row_end = indices.begin() + offsets[row + 1];
+            std::sort(row_begin, row_end);
+            unique_counts[row] = std::unique(row_begin, row_end) - row_begin;
+        }
+    });
+
+    // compact the merged rows
+    auto pattern = SparsePattern(rows_count, cols_count);
+    for (auto row = int64_t{0}; row < rows_count; row++) {
+        pattern.offsets[row + 1] = pattern.offsets[row] + unique_counts[row];
+    }
+    pattern.indices.resize(pattern.offsets[rows_count]);
+    parallel_for(threads_count, rows_count, rows_block_size, [&](const int64_t begin, const int64_t end, int) {
+        for (auto row = begin; row < end; row++) {
+            std::copy_n(indices.begin() + offsets[row], unique_counts[row],
+                        pattern.indices.begin() + pattern.offsets[row]);
+        }
+    });
+
+    return pattern;
+}
@@ -0,0 +1,133 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025 HyperWafer Authors
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace HyperWafer {
+
+/**
+ * SparsePattern is the nonzero structure of a sparse matrix in CSR form:
+ * for each row, the sorted distinct column indices of its stored entries.
+ *
+ * Values are not kept, as the communication oracle only depends on the structure.
+ * As in scipy, duplicate entries are merged and explicitly stored zeros are kept.
+ */
+class SparsePattern {
+  public:
+    /**
+     * Load the pattern of a matrix file.
+     *   - Matrix Market coordinate files (.mtx); symmetric, skew-symmetric and
+     *     hermitian matrices are expanded as scipy.io.mmread does
+     *   - CSR binary files (any other extension), see write_csr()
+     *
+     * @param path path of the matrix file
+     * @param threads_count number of threads to parse with
+     * @param transposed load the transposed matrix, i.e., the CSC form of the matrix
+     * @return pattern of the matrix (or of its transpose)
+     */
+    [[nodiscard]] static SparsePattern load(const std::string& path, int threads_count, bool transposed) noexcept;
+
+    /**
+     * Get the number of rows.
+     *
+     * @return number of rows
+     */
+    [[nodiscard]] int64_t get_rows_count() const noexcept;
+
+    /**
+     * Get the number of columns.
+     *
+     * @return number of columns
+     */
+    [[nodiscard]] int64_t get_cols_count() const noexcept;
+
+    /**
+     * Get the number of stored entries.
+     *
+     * @return number of stored entries
+     */
+    [[nodiscard]] int64_t get_nnz() const noexcept;
+
+    /**
+     * Get the number of stored entries in a row.
+     *
+     * @param row row index
+     * @return number of stored entries in the row
+     */
+    [[nodiscard]] int64_t row_nnz(int64_t row) const noexcept;
+
+    /**
+     * Get the column indices of a row.
+     *
+     * @param row row index
+     * @return pointer to the first column index of the row, followed by row_nnz(row) indices
+     */
+    [[nodiscard]] const uint32_t* row_indices(int64_t row) const noexcept;
+
+    /**
+     * Get the transposed pattern.
+     *
+     * @param threads_count number of threads
+     * @return pattern of the transposed matrix
+     */
+    [[nodiscard]] SparsePattern transpose(int threads_count) const noexcept;
+
+    /**
+     * Write the pattern as a CSR binary file (native byte order):
+     *   char[8] "HWCSR001", int64 rows, int64 cols, int64 nnz,
+     *   int64 indptr[rows + 1], uint32 indices[nnz]
+     *
+     * @param path path of the file
+     */
+    void write_csr(const std::string& path) const noexcept;
+
+  private:
+    /// number of rows
+    int64_t rows_count;
+
+    /// number of columns
+    int64_t cols_count;
+
+    /// offset of the first index of each row, followed by the number of entries
+    std::vector<int64_t> offsets;
+
+    /// column indices, row by row
+    std::vector<uint32_t> indices;
+
+    /**
+     * Constructor of an empty pattern.
+     */
+    SparsePattern(int64_t rows_count, int64_t cols_count) noexcept;
+
+    /**
+     * Load a Matrix Market coordinate file.
+     */
+    [[nodiscard]] static SparsePattern load_matrix_market(const std::string& path,
+                                                         int threads_count,
+                                                         bool transposed) noexcept;
+
+    /**
+     * Load a CSR binary file.
+     */
+    [[nodiscard]] static SparsePattern load_csr(const std::string& path) noexcept;
+
+    /**
+     * Build the pattern from (row, col) entries, merging duplicates.
+     *
+     * @param rows_count number of rows
+     * @param cols_count number of columns
+     * @param entries entries per thread, as (row, col) pairs
+     * @param threads_count number of threads
+     * @return pattern of the entries
+     */
+    [[nodiscard]] static SparsePattern from_entries(int64_t rows_count,
+                                                   int64_t cols_count,
+                                                   const std::vector<std::vector<std::pair<uint32_t, uint32_t>>>& entries,
+                                                   int threads_count) noexcept;
+};
+
+}  // namespace HyperWafer
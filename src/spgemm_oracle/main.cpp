@@ -0,0 +1,269 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2025 HyperWafer Authors
+
+#include "ChakraEmitter.h"
+#include "MeshOracle.h"
+#include "SparsePattern.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cxxopts.hpp>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace HyperWafer;
+
+namespace {
+
+/// row-to-tile mapping of A and B-row ownership under comparison
+struct Mapping {
+    /// tag naming the mapping in the outputs (e.g., WaferSpMM)
+    std::string tag;
+
+    /// "rowblock", or path of a partition file of the A rows
+    std::string partition;
+
+    /// B-row owner mode: rowblock, mod, or center
+    std::string owner;
+};
+
+/// parse TAG:PARTITION:OWNER
+Mapping parse_mapping(const std::string& spec) noexcept {
+    const auto first = spec.find(':');
+    const auto last = spec.rfind(':');
+    if (first == std::string::npos || first == last || first == 0) {
+        std::cerr << "[Error] (spgemm_oracle) invalid mapping, expected TAG:PARTITION:OWNER: " << spec << std::endl;
+        std::exit(-1);
+    }
+
+    auto mapping = Mapping{spec.substr(0, first), spec.substr(first + 1, last - first - 1), spec.substr(last + 1)};
+    if (mapping.owner != "rowblock" && mapping.owner != "mod" && mapping.owner != "center") {
+        std::cerr << "[Error] (spgemm_oracle) unknown B-row owner mode: " << mapping.owner << std::endl;
+        std::exit(-1);
+    }
+    return mapping;
+}
+
+/// seconds elapsed since start
+double elapsed_since(const std::chrono::steady_clock::time_point start) noexcept {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+/// write the bytes of every undirected mesh link as u,v,bytes with u < v
+void write_link_bytes(const std::string& path, const MeshOracle& oracle, const BcastResult& result) noexcept {
+    auto file = std::ofstream(path, std::ios::trunc);
+    if (!file) {
+        std::cerr << "[Error] (spgemm_oracle) cannot create link file: " << path << std::endl;
+        std::exit(-1);
+    }
+
+    const auto rows_count = oracle.get_rows_count();
+    const auto cols_count = oracle.get_cols_count();
+    file << "u,v,bytes\n";
+    for (auto tile = 0; tile < rows_count * cols_count; tile++) {
+        if (tile / cols_count + 1 < rows_count) {
+            file << tile << ',' << tile + cols_count << ',' << result.link_bytes[oracle.link_index(tile, true)]
+                 << '\n';
+        }
+        if (tile % cols_count + 1 < cols_count) {
+            file << tile << ',' << tile + 1 << ',' << result.link_bytes[oracle.link_index(tile, false)] << '\n';
+        }
+    }
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    auto options = cxxopts::Options(argv[0], "SpGEMM B-row broadcast oracle on a 2D mesh with Chakra ET output");
+    options.set_width(90).add_options()(
+        "matrix", "Matrix A (Matrix Market .mtx, or CSR binary)", cxxopts::value<std::string>())(
+        "b-matrix", "Matrix B (default: B = A^T)", cxxopts::value<std::string>()->default_value("empty"))(
+        "num-parts", "Number of tiles / NPUs", cxxopts::value<int>())(
+        "elem-bytes", "Bytes per nonzero element in B", cxxopts::value<int64_t>()->default_value("4"))(
+        "mapping",
+        "Mapping TAG:PARTITION:OWNER, PARTITION = rowblock or partition file, "
+        "OWNER = rowblock/mod/center (repeatable)",
+        cxxopts::value<std::vector<std::string>>())(
+        "micro-mode", "MICRO construction mode (single/auto_rows/rows_manual)",
+        cxxopts::value<std::string>()->default_value("auto_rows"))(
+        "micro-max-layers", "Target maximum layers of the first mapping in auto_rows mode",
+        cxxopts::value<int64_t>()->default_value("1000"))(
+        "micro-rows-per-layer", "Rows per MICRO layer in rows_manual mode",
+        cxxopts::value<int64_t>()->default_value("512"))(
+        "num-passes", "Number of passes of the Chakra ET", cxxopts::value<int>()->default_value("1"))(
+        "workdir", "Directory of the MICRO text, Chakra ET, and link files (empty: no files)",
+        cxxopts::value<std::string>()->default_value("empty"))(
+        "write-csr", "File to save the pattern of A into as CSR binary",
+        cxxopts::value<std::string>()->default_value("empty"))(
+        "threads", "Number of threads (0: hardware concurrency)", cxxopts::value<int>()->default_value("0"))(
+        "help", "Print usage");
+
+    auto parsed = cxxopts::ParseResult();
+    try {
+        parsed = options.parse(argc, argv);
+    } catch (const cxxopts::OptionException& e) {
+        std::cerr << "[Error] (spgemm_oracle) Error parsing options: " << e.what() << std::endl;
+        std::exit(-1);
+    }
+    if (parsed.count("help") > 0 || parsed.count("matrix") == 0 || parsed.count("num-parts") == 0 ||
+        parsed.count("mapping") == 0) {
+        std::cout << options.help() << std::endl;
+        return (parsed.count("help") > 0) ? 0 : -1;
+    }
+
+    const auto matrix_path = parsed["matrix"].as<std::string>();
+    const auto b_matrix_path = parsed["b-matrix"].as<std::string>();
+    const auto num_parts = parsed["num-parts"].as<int>();
+    const auto elem_bytes = parsed["elem-bytes"].as<int64_t>();
+    const auto micro_mode = parsed["micro-mode"].as<std::string>();
+    const auto micro_max_layers = parsed["micro-max-layers"].as<int64_t>();
+    const auto micro_rows_per_layer = parsed["micro-rows-per-layer"].as<int64_t>();
+    const auto num_passes = parsed["num-passes"].as<int>();
+    const auto workdir = parsed["workdir"].as<std::string>();
+    const auto csr_path = parsed["write-csr"].as<std::string>();
+    auto threads_count = parsed["threads"].as<int>();
+    if (threads_count <= 0) {
+        threads_count = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    }
+
+    auto mappings = std::vector<Mapping>();
+    for (const auto& spec : parsed["mapping"].as<std::vector<std::string>>()) {
+        mappings.push_back(parse_mapping(spec));
+    }
+    if (num_parts <= 0) {
+        std::cerr << "[Error] (spgemm_oracle) num-parts must be positive" << std::endl;
+        std::exit(-1);
+    }
+    if (micro_mode != "single" && micro_mode != "auto_rows" && micro_mode != "rows_manual") {
+        std::cerr << "[Error] (spgemm_oracle) unknown micro-mode: " << micro_mode << std::endl;
+        std::exit(-1);
+    }
+    if (micro_mode == "auto_rows" && micro_max_layers <= 0) {
+        std::cerr << "[Error] (spgemm_oracle) micro-max-layers must be positive" << std::endl;
+        std::exit(-1);
+    }
+
+    // 1. load A column-major, so that each B row k lists the A rows using it
+    const auto start = std::chrono::steady_clock::now();
+    const auto a_cols = SparsePattern::load(matrix_path, threads_count, true);
+    const auto a_rows_count = a_cols.get_cols_count();
+    const auto b_rows_count = a_cols.get_rows_count();
+    std::cout << "[info] Loaded A: shape=(" << a_rows_count << ", " << b_rows_count << "), nnz=" << a_cols.get_nnz()
+              << " in " << std::fixed << std::setprecision(3) << elapsed_since(start) << " s" << std::endl;
+
+    if (csr_path != "empty") {
+        a_cols.transpose(threads_count).write_csr(csr_path);
+        std::cout << "[info] Wrote CSR of A: " << csr_path << std::endl;
+    }
+
+    // nonzeros of each B row: B = A^T unless given
+    auto b_row_nnz = std::vector<int64_t>(b_rows_count);
+    if (b_matrix_path == "empty") {
+        for (auto k = int64_t{0}; k < b_rows_count; k++) {
+            b_row_nnz[k] = a_cols.row_nnz(k);
+        }
+        std::cout << "[info] Using B = A^T, shape=(" << b_rows_count << ", " << a_rows_count
+                  << "), nnz=" << a_cols.get_nnz() << std::endl;
+    } else {
+        const auto b = SparsePattern::load(b_matrix_path, threads_count, false);
+        if (b.get_rows_count() != b_rows_count) {
+            std::cerr << "[Error] (spgemm_oracle) shape mismatch: cols(A)=" << b_rows_count
+                      << " != rows(B)=" << b.get_rows_count() << std::endl;
+            std::exit(-1);
+        }
+        for (auto k = int64_t{0}; k < b_rows_count; k++) {
+            b_row_nnz[k] = b.row_nnz(k);
+        }
+        std::cout << "[info] Loaded B: shape=(" << b.get_rows_count() << ", " << b.get_cols_count()
+                  << "), nnz=" << b.get_nnz() << std::endl;
+    }
+
+    // 2. oracle of each mapping
+    const auto oracle = MeshOracle(num_parts, threads_count);
+    std::cout << "[info] 2D mesh (p=" << oracle.get_rows_count() << ", q=" << oracle.get_cols_count()
+              << "), threads=" << threads_count << std::endl;
+
+    auto results = std::vector<BcastResult>();
+    for (const auto& mapping : mappings) {
+        const auto mapping_start = std::chrono::steady_clock::now();
+        std::cout << "\n[phase] 2D mesh oracle: " << mapping.tag << std::endl;
+
+        const auto row_part = (mapping.partition == "rowblock")
+                                  ? oracle.rowblock_partition(a_rows_count)
+                                  : oracle.load_partition(mapping.partition, a_rows_count);
+        auto owner_b = std::vector<TileId>();
+        if (mapping.owner == "rowblock") {
+            owner_b = oracle.rowblock_partition(b_rows_count);
+        } else if (mapping.owner == "mod") {
+            owner_b = oracle.mod_owners(b_rows_count);
+        } else {
+            owner_b = oracle.center_owners(a_cols, row_part);
+        }
+
+        auto result = oracle.simulate_bcast(a_cols, b_row_nnz, row_part, owner_b, elem_bytes);
+        std::cout << "[info]   total_bytes=" << result.total_bytes << ", GB-hop=" << result.gb_hop
+                  << ", peak_link=" << result.peak_link << std::endl;
+        std::cout << "[info]   B-rows with work (A[:,k]!=0 & B[k,:]!=0): " << result.rows_count_all << std::endl;
+        std::cout << "[info]   avg tiles using each B-row (all rows)     = " << result.avg_tiles_all << std::endl;
+        std::cout << "[info]   avg remote tiles per B-row (all rows)    = " << result.avg_recv_all << std::endl;
+        std::cout << "[info]   B-rows with cross-tile comm: " << result.rows_count_comm << std::endl;
+        std::cout << "[info]   avg tiles using each B-row (comm rows)   = " << result.avg_tiles_comm << std::endl;
+        std::cout << "[info]   avg remote tiles per B-row (comm rows)  = " << result.avg_recv_comm << std::endl;
+        std::cout << "[info]   simulated in " << elapsed_since(mapping_start) << " s" << std::endl;
+        results.push_back(std::move(result));
+    }
+
+    // 3. MICRO phases, rows per layer chosen by the first mapping in auto_rows mode
+    auto rows_per_layer = int64_t{0};
+    if (micro_mode == "auto_rows") {
+        const auto active_rows = static_cast<int64_t>(results.front().row_bytes.size());
+        rows_per_layer = std::max<int64_t>(1, (active_rows + micro_max_layers - 1) / micro_max_layers);
+        std::cout << "\n[info] auto_rows MICRO: Mw=" << active_rows << ", target_max_layers=" << micro_max_layers
+                  << ", rows_per_layer=" << rows_per_layer << std::endl;
+    } else if (micro_mode == "rows_manual") {
+        rows_per_layer = std::max<int64_t>(1, micro_rows_per_layer);
+        std::cout << "\n[info] rows_manual MICRO: rows_per_layer=" << rows_per_layer << std::endl;
+    }
+
+    std::cout << std::endl;
+    for (auto i = size_t{0}; i < mappings.size(); i++) {
+        const auto& tag = mappings[i].tag;
+        const auto& result = results[i];
+        const auto phases = (micro_mode == "single") ? ChakraEmitter::single_phase(tag, result.total_bytes)
+                                                     : ChakraEmitter::rows_batch_phases(result.row_bytes, tag,
+                                                                                        rows_per_layer);
+        auto micro_bytes = int64_t{0};
+        for (const auto& phase : phases) {
+            micro_bytes += phase.bytes;
+        }
+
+        // 4. MICRO text, Chakra ET, and link bytes
+        if (workdir != "empty") {
+            std::filesystem::create_directories(workdir);
+            const auto emit_start = std::chrono::steady_clock::now();
+            const auto prefix = workdir + "/SpGEMM_" + tag;
+            ChakraEmitter::write_micro_text(prefix + ".txt", phases);
+            ChakraEmitter::write_traces(prefix, phases, num_parts, num_passes, threads_count);
+            write_link_bytes(prefix + "_links.csv", oracle, result);
+            std::cout << "[info] Wrote " << prefix << ".{txt,<npu>.et,_links.csv} in " << elapsed_since(emit_start)
+                      << " s" << std::endl;
+        }
+
+        // machine-readable summary
+        std::cout << "[oracle] tag=" << tag << " total_bytes=" << result.total_bytes << " gb_hop=" << result.gb_hop
+                  << " peak_link=" << result.peak_link << " rows_all=" << result.rows_count_all
+                  << " rows_comm=" << result.rows_count_comm << " avg_tiles_all=" << result.avg_tiles_all
+                  << " avg_recv_all=" << result.avg_recv_all << " avg_tiles_comm=" << result.avg_tiles_comm
+                  << " avg_recv_comm=" << result.avg_recv_comm << " active_rows=" << result.row_bytes.size()
+                  << " rows_per_layer=" << rows_per_layer << " micro_layers=" << phases.size()
+                  << " micro_bytes=" << micro_bytes << std::endl;
+    }
+
+    std::cout << "[info] Done in " << elapsed_since(start) << " s" << std::endl;
+    return 0;
+}